@@ -172,6 +172,28 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
 
+/*Replace the RGB565 fill and map kernels of the software blender with custom (e.g. SIMD) ones.
+ *The header has to define the `LV_DRAW_SW_BLEND_RGB565_...` hooks listed in lv_draw_sw_blend.c*/
+#define LV_USE_DRAW_SW_BLEND_CUSTOM 0
+#if LV_USE_DRAW_SW_BLEND_CUSTOM
+    #define LV_DRAW_SW_BLEND_CUSTOM_INCLUDE "my_blend.h"
+#endif
+
+/*Render the invalidated areas in horizontal bands on several threads at once.
+ *The threads and a lock are given by the port with `lv_refr_set_parallel()`*/
+#define LV_USE_REFR_PARALLEL 0
+#if LV_USE_REFR_PARALLEL
+    /*Most bands (threads) an area is split to. Every thread has about 1 kB of scratch state in RAM*/
+    #define LV_REFR_PARALLEL_MAX 4
+
+    /*Smallest band height in rows. Lower areas are rendered by the calling thread alone*/
+    #define LV_REFR_PARALLEL_MIN_ROWS 32
+#endif
+
+/*Cache the style properties resolved for an object in its current state, in a table of this many entries.
+ *Allocated for the objects drawn, about 8 bytes per entry. Must be a power of 2. 0: no caching*/
+#define LV_OBJ_STYLE_CACHE_SIZE 16
+
 /*-------------
  * GPU
  *-----------*/
@@ -409,6 +431,13 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*Number of letter -> glyph id pairs remembered per font. Must be a power of 2.*/
+#define LV_FONT_FMT_TXT_CACHE_SIZE 16
+
+/*Bytes of decompressed glyph bitmaps kept per compressed font (least recently used first out).
+ *0: decompress the glyph on every draw*/
+#define LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE 4096
+
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
 #if LV_USE_FONT_SUBPX
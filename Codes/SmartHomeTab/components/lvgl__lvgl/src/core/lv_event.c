@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_indev.h"
+#include "../misc/lv_gc.h"
 
 /*********************
  *      DEFINES
@@ -33,7 +34,6 @@ static bool event_is_bubbled(lv_event_t * e);
 /**********************
  *  STATIC VARIABLES
  **********************/
-static lv_event_t * event_head;
 
 /**********************
  *      MACROS
@@ -67,14 +67,15 @@ lv_res_t lv_event_send(lv_obj_t * obj, lv_event_code_t event_code, void * param)
     /*Build a simple linked list from the objects used in the events
      *It's important to know if this object was deleted by a nested event
      *called from this `event_cb`.*/
-    e.prev = event_head;
-    event_head = &e;
+    _lv_scratch_t * scratch = _lv_scratch_get();    /*The parallel refresh sends draw events on every thread*/
+    e.prev = scratch->event_head;
+    scratch->event_head = &e;
 
     /*Send the event*/
     lv_res_t res = event_send_core(&e);
 
     /*Remove this element from the list*/
-    event_head = e.prev;
+    scratch->event_head = e.prev;
 
     return res;
 }
@@ -146,7 +147,7 @@ uint32_t lv_event_register_id(void)
 
 void _lv_event_mark_deleted(lv_obj_t * obj)
 {
-    lv_event_t * e = event_head;
+    lv_event_t * e = _lv_scratch_get()->event_head;
 
     while(e) {
         if(e->current_target == obj || e->target == obj) e->deleted = 1;
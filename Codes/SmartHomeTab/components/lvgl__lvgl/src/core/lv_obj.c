@@ -412,6 +412,22 @@ bool lv_obj_is_valid(const lv_obj_t * obj)
     return false;
 }
 
+lv_res_t _lv_obj_event_base_draw_in(const lv_obj_class_t * class_p, lv_event_t * e, const lv_area_t * coords)
+{
+    /*`lv_obj_draw` draws the target in `coords`*/
+    _lv_scratch_t * scratch = _lv_scratch_get();
+    const lv_obj_t * obj_prev = scratch->draw_in_obj;
+    const lv_area_t * coords_prev = scratch->draw_in_coords;
+    scratch->draw_in_obj = lv_event_get_target(e);
+    scratch->draw_in_coords = coords;
+
+    lv_res_t res = lv_obj_event_base(class_p, e);
+
+    scratch->draw_in_obj = obj_prev;
+    scratch->draw_in_coords = coords_prev;
+    return res;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -457,6 +473,7 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_obj_enable_style_refresh(false); /*No need to refresh the style because the object will be deleted*/
     lv_obj_remove_style_all(obj);
     lv_obj_enable_style_refresh(true);
+    _lv_obj_style_cache_free(obj);
 
     /*Remove the animations from this object*/
     lv_anim_del(obj, NULL);
@@ -484,6 +501,8 @@ static void lv_obj_draw(lv_event_t * e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     lv_obj_t * obj = lv_event_get_target(e);
+    _lv_scratch_t * scratch = _lv_scratch_get();
+    const lv_area_t * obj_coords = obj == scratch->draw_in_obj ? scratch->draw_in_coords : &obj->coords;
     if(code == LV_EVENT_COVER_CHECK) {
         lv_cover_check_info_t * info = lv_event_get_param(e);
         if(info->res == LV_COVER_RES_MASKED) return;
@@ -497,7 +516,7 @@ static void lv_obj_draw(lv_event_t * e)
         lv_coord_t w = lv_obj_get_style_transform_width(obj, LV_PART_MAIN);
         lv_coord_t h = lv_obj_get_style_transform_height(obj, LV_PART_MAIN);
         lv_area_t coords;
-        lv_area_copy(&coords, &obj->coords);
+        lv_area_copy(&coords, obj_coords);
         coords.x1 -= w;
         coords.x2 += w;
         coords.y1 -= h;
@@ -534,7 +553,7 @@ static void lv_obj_draw(lv_event_t * e)
         lv_coord_t w = lv_obj_get_style_transform_width(obj, LV_PART_MAIN);
         lv_coord_t h = lv_obj_get_style_transform_height(obj, LV_PART_MAIN);
         lv_area_t coords;
-        lv_area_copy(&coords, &obj->coords);
+        lv_area_copy(&coords, obj_coords);
         coords.x1 -= w;
         coords.x2 += w;
         coords.y1 -= h;
@@ -563,7 +582,7 @@ static void lv_obj_draw(lv_event_t * e)
 #if LV_DRAW_COMPLEX
         if(clip_corner) {
             lv_draw_mask_radius_param_t * mp = lv_mem_buf_get(sizeof(lv_draw_mask_radius_param_t));
-            lv_draw_mask_radius_init(mp, &obj->coords, draw_dsc.radius, false);
+            lv_draw_mask_radius_init(mp, obj_coords, draw_dsc.radius, false);
             /*Add the mask and use `obj+8` as custom id. Don't use `obj` directly because it might be used by the user*/
             lv_draw_mask_add(mp, obj + 8);
 
@@ -607,7 +626,7 @@ static void lv_obj_draw(lv_event_t * e)
             lv_coord_t w = lv_obj_get_style_transform_width(obj, LV_PART_MAIN);
             lv_coord_t h = lv_obj_get_style_transform_height(obj, LV_PART_MAIN);
             lv_area_t coords;
-            lv_area_copy(&coords, &obj->coords);
+            lv_area_copy(&coords, obj_coords);
             coords.x1 -= w;
             coords.x2 += w;
             coords.y1 -= h;
@@ -175,6 +175,9 @@ typedef struct _lv_obj_t {
     struct _lv_obj_t * parent;
     _lv_obj_spec_attr_t * spec_attr;
     _lv_obj_style_t * styles;
+#if LV_OBJ_STYLE_CACHE_SIZE
+    _lv_obj_style_cache_t * style_cache;
+#endif
 #if LV_USE_USER_DATA
     void * user_data;
 #endif
@@ -364,6 +367,17 @@ const lv_obj_class_t * lv_obj_get_class(const lv_obj_t * obj);
  */
 bool lv_obj_is_valid(const lv_obj_t * obj);
 
+/**
+ * Call the ancestor's event handler as `lv_obj_event_base` but draw the background, border and
+ * clip corner of `lv_obj` in `coords` instead of the target's coordinates.
+ * The coordinates of the object are not changed: a parallel refresh may be drawing it on an other band.
+ * @param class_p   pointer to the class of the widget (NOT the ancestor class)
+ * @param e         pointer to the event descriptor
+ * @param coords    the coordinates to draw in
+ * @return          LV_RES_OK: the target object was not deleted in the event; LV_RES_INV: it was deleted in the event
+ */
+lv_res_t _lv_obj_event_base_draw_in(const lv_obj_class_t * class_p, lv_event_t * e, const lv_area_t * coords);
+
 /**
  * Scale the given number of pixels (a distance or size) relative to a 160 DPI display
  * considering the DPI of the `obj`'s display.
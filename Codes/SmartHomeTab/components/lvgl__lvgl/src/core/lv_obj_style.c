@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_disp.h"
+#include "lv_refr.h"
 #include "../misc/lv_gc.h"
 
 /*********************
@@ -35,6 +36,23 @@ typedef enum {
     CACHE_NEED_CHECK = 4,
 } cache_t;
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+typedef struct {
+    lv_style_value_t value;
+    lv_style_prop_t prop;
+    uint8_t part;               /*Part index, `part >> 16`. `STYLE_CACHE_UNUSED`: unused entry*/
+    uint8_t res;                /*`lv_style_res_t` of the object's own styles*/
+} style_cache_entry_t;
+
+struct _lv_obj_style_cache_t {
+    uint32_t main_props;        /*`PROP_BIT`s of the properties in the styles of `LV_PART_MAIN`*/
+    uint32_t other_props;       /*`PROP_BIT`s of the properties in the styles of the other parts*/
+    lv_state_t state;           /*The entries are resolved in this state*/
+    uint8_t valid;
+    style_cache_entry_t entries[LV_OBJ_STYLE_CACHE_SIZE];
+};
+#endif
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -45,6 +63,8 @@ typedef enum {
 static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector);
 static _lv_obj_style_t * get_trans_style(lv_obj_t * obj, uint32_t part);
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
+static lv_style_res_t get_prop_cached(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
+static void style_cache_invalidate(lv_obj_t * obj);
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
 static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
@@ -63,6 +83,10 @@ static bool style_refr = true;
 /**********************
  *      MACROS
  **********************/
+#define STYLE_CACHE_UNUSED  0xFF
+
+/*Groups of 4 properties, the custom ones share the last bit*/
+#define PROP_BIT(prop)  ((uint32_t)1 << LV_MIN((uint32_t)LV_STYLE_PROP_ID_MASK(prop) >> 2, 31))
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -73,6 +97,16 @@ void _lv_obj_style_init(void)
     _lv_ll_init(&LV_GC_ROOT(_lv_obj_style_trans_ll), sizeof(trans_t));
 }
 
+void _lv_obj_style_cache_free(lv_obj_t * obj)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    lv_mem_free(obj->style_cache);
+    obj->style_cache = NULL;
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
 void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t selector)
 {
     trans_del(obj, selector, LV_STYLE_PROP_ANY, NULL);
@@ -145,14 +179,14 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
         /*The style from the current `i` index is removed, so `i` points to the next style.
          *Therefore it doesn't needs to be incremented*/
     }
-    if(deleted && prop != LV_STYLE_PROP_INV) {
+    if(deleted) {
         lv_obj_refresh_style(obj, part, prop);
     }
 }
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
-    if(!style_refr) return;
+    /*Walk the objects even if refreshing is disabled to update their style cache*/
     lv_disp_t * d = lv_disp_get_next(NULL);
 
     while(d) {
@@ -168,7 +202,8 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
-    if(!style_refr) return;
+    style_cache_invalidate(obj);
+    if(!style_refr || prop == LV_STYLE_PROP_INV) return;
 
     lv_obj_invalidate(obj);
 
@@ -226,7 +261,7 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
     bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
     lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
     while(obj) {
-        found = get_prop_core(obj, part, prop, &value_act);
+        found = get_prop_cached(obj, part, prop, &value_act);
         if(found == LV_STYLE_RES_FOUND) break;
         if(!inheritable) break;
 
@@ -341,6 +376,7 @@ void _lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t
 
     _lv_obj_style_t * style_trans = get_trans_style(obj, part);
     lv_style_set_prop(style_trans->style, tr_dsc->prop, v1);   /*Be sure `trans_style` has a valid value*/
+    style_cache_invalidate(obj);
 
     if(tr_dsc->prop == LV_STYLE_RADIUS) {
         if(v1.num == LV_RADIUS_CIRCLE || v2.num == LV_RADIUS_CIRCLE) {
@@ -665,6 +701,111 @@ static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_sty
     else return LV_STYLE_RES_NOT_FOUND;
 }
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+static uint32_t style_prop_bits(const lv_style_t * style)
+{
+    uint32_t bits = 0;
+    uint32_t i;
+    if(style->prop1 == LV_STYLE_PROP_ANY) {
+        for(i = 0; i < style->prop_cnt; i++) bits |= PROP_BIT(style->v_p.const_props[i].prop);
+    }
+    else if(style->prop_cnt > 1) {
+        const uint16_t * props = (const uint16_t *)(style->v_p.values_and_props +
+                                                    style->prop_cnt * sizeof(lv_style_value_t));
+        for(i = 0; i < style->prop_cnt; i++) bits |= PROP_BIT(props[i]);
+    }
+    else if(style->prop_cnt == 1) {
+        bits = PROP_BIT(style->prop1);
+    }
+    return bits;
+}
+
+/**
+ * Empty the cache and resolve the properties in the object's current state from now on.
+ * Also collects which properties the styles of the object have at all, to answer
+ * the lookups of the others (most of the lookups) without touching the table.
+ */
+static void style_cache_reset(const lv_obj_t * obj, _lv_obj_style_cache_t * cache)
+{
+    if(!cache->valid) {
+        cache->main_props = 0;
+        cache->other_props = 0;
+        uint32_t i;
+        for(i = 0; i < obj->style_cnt; i++) {
+            uint32_t bits = style_prop_bits(obj->styles[i].style);
+            if(lv_obj_style_get_selector_part(obj->styles[i].selector) == LV_PART_MAIN) cache->main_props |= bits;
+            else cache->other_props |= bits;
+        }
+        cache->valid = 1;
+    }
+
+    uint32_t i;
+    for(i = 0; i < LV_OBJ_STYLE_CACHE_SIZE; i++) cache->entries[i].part = STYLE_CACHE_UNUSED;
+    cache->state = obj->state;
+}
+
+/**
+ * `get_prop_core` through the object's style cache.
+ * The cache is allocated the first time the object is drawn. While the threads of a parallel
+ * refresh are running it's only read; what it doesn't have is resolved without it.
+ */
+static lv_style_res_t get_prop_cached(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v)
+{
+    /*The transitions are being created with skipped transition styles and changing state*/
+    if(obj->skip_trans) return get_prop_core(obj, part, prop, v);
+
+    bool parallel = _lv_refr_is_parallel();
+    _lv_obj_style_cache_t * cache = obj->style_cache;
+    if(cache == NULL) {
+        if(parallel || _lv_refr_get_disp_refreshing() == NULL) return get_prop_core(obj, part, prop, v);
+        cache = lv_mem_alloc(sizeof(_lv_obj_style_cache_t));
+        if(cache == NULL) return get_prop_core(obj, part, prop, v);
+        cache->valid = 0;
+        style_cache_reset(obj, cache);
+        ((lv_obj_t *)obj)->style_cache = cache;
+    }
+    else if(!cache->valid || cache->state != obj->state) {
+        if(parallel) return get_prop_core(obj, part, prop, v);
+        style_cache_reset(obj, cache);
+    }
+
+    uint32_t props = part == LV_PART_MAIN ? cache->main_props : cache->other_props;
+    if((props & PROP_BIT(prop)) == 0) return LV_STYLE_RES_NOT_FOUND;
+
+    uint8_t part_idx = (uint8_t)(part >> 16);
+    style_cache_entry_t * entry = &cache->entries[(prop + part_idx * 5) & (LV_OBJ_STYLE_CACHE_SIZE - 1)];
+    if(entry->prop == prop && entry->part == part_idx) {
+        if(entry->res == LV_STYLE_RES_FOUND) *v = entry->value;
+        return entry->res;
+    }
+
+    lv_style_res_t res = get_prop_core(obj, part, prop, v);
+    if(!parallel) {
+        entry->prop = prop;
+        entry->part = part_idx;
+        entry->res = res;
+        if(res == LV_STYLE_RES_FOUND) entry->value = *v;
+    }
+    return res;
+}
+
+static void style_cache_invalidate(lv_obj_t * obj)
+{
+    if(obj->style_cache) obj->style_cache->valid = 0;
+}
+#else
+static inline lv_style_res_t get_prop_cached(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop,
+                                             lv_style_value_t * v)
+{
+    return get_prop_core(obj, part, prop, v);
+}
+
+static inline void style_cache_invalidate(lv_obj_t * obj)
+{
+    LV_UNUSED(obj);
+}
+#endif /*LV_OBJ_STYLE_CACHE_SIZE*/
+
 /**
  * Refresh the style of all children of an object. (Called recursively)
  * @param style refresh objects only with this
@@ -741,6 +882,7 @@ static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, tran
             _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_trans_ll), tr);
             lv_mem_free(tr);
             removed = true;
+            style_cache_invalidate(obj);
 
         }
         tr = tr_prev;
@@ -830,6 +972,7 @@ static void trans_anim_start_cb(lv_anim_t * a)
 
     _lv_obj_style_t * style_trans = get_trans_style(tr->obj, tr->selector);
     lv_style_set_prop(style_trans->style, tr->prop, tr->start_value);   /*Be sure `trans_style` has a valid value*/
+    style_cache_invalidate(tr->obj);
 
 }
 
@@ -860,6 +1003,7 @@ static void trans_anim_ready_cb(lv_anim_t * a)
 
                 _lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop(obj_style->style, prop);
+                style_cache_invalidate(obj);
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, obj_style->style, obj_style->selector);
@@ -43,6 +43,9 @@ typedef struct {
     uint32_t is_trans : 1;
 } _lv_obj_style_t;
 
+/*The style properties resolved for an object, see `LV_OBJ_STYLE_CACHE_SIZE`*/
+typedef struct _lv_obj_style_cache_t _lv_obj_style_cache_t;
+
 typedef struct {
     uint16_t time;
     uint16_t delay;
@@ -64,6 +67,13 @@ typedef struct {
  */
 void _lv_obj_style_init(void);
 
+/**
+ * Free the cache of the resolved style properties of an object.
+ * Called by LVGL when the object is deleted
+ * @param obj       pointer to an object
+ */
+void _lv_obj_style_cache_free(struct _lv_obj_t * obj);
+
 /**
  * Add a style to an object.
  * @param obj       pointer to an object
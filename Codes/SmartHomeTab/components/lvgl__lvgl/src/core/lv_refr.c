@@ -48,6 +48,15 @@ typedef struct {
 #endif
 } mem_monitor_t;
 
+#if LV_USE_REFR_PARALLEL
+typedef struct {
+    lv_obj_t * top_act_scr;
+    lv_obj_t * top_prev_scr;
+    lv_area_t bands[LV_REFR_PARALLEL_MAX];
+    uint32_t band_cnt;
+} refr_bands_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -56,6 +65,12 @@ static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_draw_ctx_t * draw_ctx);
+static void refr_screens(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr);
+#if LV_USE_REFR_PARALLEL
+    static bool refr_bands(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr);
+    static void refr_band_job(void * job_ctx, uint32_t worker);
+    static void cleanup_job(void * job_ctx, uint32_t worker);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
@@ -76,6 +91,13 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
 
+#if LV_USE_REFR_PARALLEL
+    static lv_refr_parallel_t parallel;
+    static bool parallel_running;   /*The threads are running: the shared state needs the lock*/
+    static bool parallel_used;      /*The threads rendered since their last clean up*/
+    static _lv_scratch_t worker_scratch[LV_REFR_PARALLEL_MAX];  /*Of each thread of `parallel`, not in the heap*/
+#endif
+
 #if LV_USE_PERF_MONITOR
     static perf_monitor_t   perf_monitor;
 #endif
@@ -279,6 +301,56 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp)
     disp_refr = disp;
 }
 
+#if LV_USE_REFR_PARALLEL
+void lv_refr_set_parallel(const lv_refr_parallel_t * par)
+{
+    LV_ASSERT(!parallel_running);
+
+    /*Free the scratch state of the current threads before they go*/
+    if(parallel_used) {
+        parallel_running = true;
+        parallel.run(cleanup_job, NULL);
+        parallel_running = false;
+        parallel_used = false;
+    }
+
+    lv_memset_00(worker_scratch, sizeof(worker_scratch));
+    lv_memset_00(&parallel, sizeof(parallel));
+    if(par == NULL || par->worker_cnt < 2) return;
+
+    LV_ASSERT_NULL(par->run);
+    LV_ASSERT_NULL(par->worker_id);
+    LV_ASSERT_NULL(par->lock);
+    LV_ASSERT_NULL(par->unlock);
+    parallel = *par;
+    if(parallel.worker_cnt > LV_REFR_PARALLEL_MAX) parallel.worker_cnt = LV_REFR_PARALLEL_MAX;
+}
+
+void lv_refr_lock_shared(void)
+{
+    if(parallel_running) parallel.lock();
+}
+
+void lv_refr_unlock_shared(void)
+{
+    if(parallel_running) parallel.unlock();
+}
+
+bool _lv_refr_is_parallel(void)
+{
+    return parallel_running;
+}
+
+_lv_scratch_t * _lv_scratch_get(void)
+{
+    if(!parallel_running) return &LV_GC_ROOT(_lv_scratch);
+
+    uint32_t worker = parallel.worker_id();
+    LV_ASSERT(worker < parallel.worker_cnt);
+    return &worker_scratch[worker];
+}
+#endif
+
 /**
  * Called periodically to handle the refreshing
  * @param tmr pointer to the timer itself
@@ -359,6 +431,16 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     _lv_draw_mask_cleanup();
 #endif
 
+#if LV_USE_REFR_PARALLEL
+    /*The same for the scratch state of the threads*/
+    if(parallel_used) {
+        parallel_running = true;
+        parallel.run(cleanup_job, NULL);
+        parallel_running = false;
+        parallel_used = false;
+    }
+#endif
+
 #if LV_USE_PERF_MONITOR && LV_USE_LABEL
     lv_obj_t * perf_label = perf_monitor.perf_label;
     if(perf_label == NULL) {
@@ -732,6 +814,24 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
         top_prev_scr = lv_refr_get_top_obj(draw_ctx->buf_area, disp_refr->prev_scr);
     }
 
+#if LV_USE_REFR_PARALLEL
+    if(!refr_bands(draw_ctx, top_act_scr, top_prev_scr))
+#endif
+    {
+        refr_screens(draw_ctx, top_act_scr, top_prev_scr);
+    }
+
+    draw_buf_flush(disp_refr);
+}
+
+/**
+ * Draw the screens and the layers of the display on the clip area
+ * @param draw_ctx      the draw context
+ * @param top_act_scr   the most top object of the active screen covering the area or NULL
+ * @param top_prev_scr  the most top object of the previous screen covering the area or NULL
+ */
+static void refr_screens(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr)
+{
     /*Draw a display background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
         lv_area_t a;
@@ -792,9 +892,85 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     /*Also refresh top and sys layer unconditionally*/
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_top(disp_refr));
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_sys(disp_refr));
+}
 
-    draw_buf_flush(disp_refr);
+#if LV_USE_REFR_PARALLEL
+/**
+ * Draw the clip area in horizontal bands, each on a thread of `parallel`, and wait for all of them
+ * @param draw_ctx      the draw context of the display
+ * @param top_act_scr   the most top object of the active screen covering the area or NULL
+ * @param top_prev_scr  the most top object of the previous screen covering the area or NULL
+ * @return              false: the area wasn't drawn as it's too small or there are no threads
+ */
+static bool refr_bands(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr)
+{
+    if(parallel.worker_cnt < 2) return false;
+
+    const lv_area_t * clip = draw_ctx->clip_area;
+    lv_coord_t h = lv_area_get_height(clip);
+    uint32_t band_cnt = LV_MIN(parallel.worker_cnt, (uint32_t)(h / LV_REFR_PARALLEL_MIN_ROWS));
+    if(band_cnt < 2) return false;
+
+    lv_disp_drv_t * drv = disp_refr->driver;
+    uint32_t i;
+    for(i = 0; i < band_cnt; i++) {
+        lv_draw_ctx_t * band_ctx = disp_refr->band_draw_ctx[i];
+        if(band_ctx == NULL) {
+            band_ctx = lv_mem_alloc(drv->draw_ctx_size);
+            LV_ASSERT_MALLOC(band_ctx);
+            if(band_ctx == NULL) return false;
+            drv->draw_ctx_init(drv, band_ctx);
+            disp_refr->band_draw_ctx[i] = band_ctx;
+        }
+    }
+
+    refr_bands_t job;
+    job.top_act_scr = top_act_scr;
+    job.top_prev_scr = top_prev_scr;
+    job.band_cnt = band_cnt;
+    for(i = 0; i < band_cnt; i++) {
+        lv_area_t * band = &job.bands[i];
+        *band = *clip;
+        band->y1 = clip->y1 + (lv_coord_t)((h * i) / band_cnt);
+        band->y2 = clip->y1 + (lv_coord_t)((h * (i + 1)) / band_cnt) - 1;
+
+        /*Take the callbacks of the display's context, also those replaced since its creation*/
+        lv_draw_ctx_t * band_ctx = disp_refr->band_draw_ctx[i];
+        lv_memcpy(band_ctx, draw_ctx, sizeof(lv_draw_ctx_t));
+        band_ctx->clip_area = band;
+        if(band_ctx->init_buf) band_ctx->init_buf(band_ctx);
+    }
+
+    parallel_running = true;
+    parallel.run(refr_band_job, &job);
+    parallel_running = false;
+    parallel_used = true;
+    return true;
+}
+
+static void refr_band_job(void * job_ctx, uint32_t worker)
+{
+    refr_bands_t * job = job_ctx;
+    if(worker >= job->band_cnt) return;
+
+    lv_draw_ctx_t * draw_ctx = disp_refr->band_draw_ctx[worker];
+    refr_screens(draw_ctx, job->top_act_scr, job->top_prev_scr);
+
+    /*Join: the band is finished when the thread returns*/
+    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+}
+
+static void cleanup_job(void * job_ctx, uint32_t worker)
+{
+    LV_UNUSED(job_ctx);
+    LV_UNUSED(worker);
+
+    lv_mem_buf_free_all();
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_cleanup();
+#endif
 }
+#endif
 
 /**
  * Search the most top object which fully covers an area
@@ -26,6 +26,42 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_REFR_PARALLEL
+/**
+ * A job of a parallel refresh
+ * @param job_ctx   `job_ctx` of `lv_refr_parallel_t.run`
+ * @param worker    index of the thread running the job
+ */
+typedef void (*lv_refr_job_cb_t)(void * job_ctx, uint32_t worker);
+
+/**
+ * The threads of a parallel refresh, given by the port
+ */
+typedef struct {
+    /**
+     * Call `job(job_ctx, i)` on thread `i` for every `i < worker_cnt` at the same time
+     * and return when all of them returned.
+     */
+    void (*run)(lv_refr_job_cb_t job, void * job_ctx);
+
+    /**
+     * Tell which job of `run` the calling thread runs. LVGL keeps the scratch state of every worker
+     * (mask stack, scratch buffers, ...) and looks it up with this instead of thread-local storage.
+     * @return  the `i` of the job
+     */
+    uint32_t (*worker_id)(void);
+
+    /** Take a recursive lock guarding LVGL's shared state (heap, image and glyph caches)*/
+    void (*lock)(void);
+
+    /** Give back the lock of `lock`*/
+    void (*unlock)(void);
+
+    /** Number of threads, at most `LV_REFR_PARALLEL_MAX`*/
+    uint32_t worker_cnt;
+} lv_refr_parallel_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -85,6 +121,46 @@ lv_disp_t * _lv_refr_get_disp_refreshing(void);
  */
 void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 
+#if LV_USE_REFR_PARALLEL
+/**
+ * Render the invalidated areas in horizontal bands on several threads.
+ * Each thread gets a draw context of its own, created with the driver's `draw_ctx_init`
+ * and taking the callbacks of the display's draw context.
+ * @param par   the threads (copied). NULL or less than 2 threads: render on the calling thread.
+ */
+void lv_refr_set_parallel(const lv_refr_parallel_t * par);
+
+/**
+ * Take the lock of LVGL's shared state while the threads of a parallel refresh are running.
+ * Draw callbacks have to hold it while they use state shared between the threads (e.g. a cache).
+ */
+void lv_refr_lock_shared(void);
+
+/**
+ * Give back the lock taken by `lv_refr_lock_shared`
+ */
+void lv_refr_unlock_shared(void);
+
+/**
+ * Tell if the threads of a parallel refresh are running
+ * @return true: the draw functions may be running on several threads at the same time
+ */
+bool _lv_refr_is_parallel(void);
+#else
+static inline void lv_refr_lock_shared(void)
+{
+}
+
+static inline void lv_refr_unlock_shared(void)
+{
+}
+
+static inline bool _lv_refr_is_parallel(void)
+{
+    return false;
+}
+#endif
+
 #if LV_USE_PERF_MONITOR
 /**
  * Reset FPS counter
@@ -30,7 +30,7 @@ static lv_res_t /* LV_ATTRIBUTE_FAST_MEM */ decode_and_draw(lv_draw_ctx_t * draw
                                                             const lv_area_t * coords, const void * src);
 
 static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const char * msg);
-static void draw_cleanup(_lv_img_cache_entry_t * cache);
+static void draw_cleanup(_lv_img_cache_entry_t * cache, bool locked);
 
 /**********************
  *  STATIC VARIABLES
@@ -243,9 +243,14 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
 {
     if(draw_dsc->opa <= LV_OPA_MIN) return LV_RES_OK;
 
+    /*The image cache and the decoders are shared by the threads of a parallel refresh*/
+    lv_refr_lock_shared();
     _lv_img_cache_entry_t * cdsc = _lv_img_cache_open(src, draw_dsc->recolor, draw_dsc->frame_id);
 
-    if(cdsc == NULL) return LV_RES_INV;
+    if(cdsc == NULL) {
+        lv_refr_unlock_shared();
+        return LV_RES_INV;
+    }
 
     lv_img_cf_t cf;
     if(lv_img_cf_is_chroma_keyed(cdsc->dec_dsc.header.cf)) cf = LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
@@ -262,6 +267,17 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
         }
     }
 
+    /*A decoded image is drawn without the lock, its entry is kept meanwhile. The decoders reading line by line
+     *and the single entry of LV_IMG_CACHE_DEF_SIZE 0 are used by one thread at a time.*/
+    bool locked = true;
+#if LV_USE_REFR_PARALLEL && LV_IMG_CACHE_DEF_SIZE
+    if(cdsc->dec_dsc.error_msg == NULL && cdsc->dec_dsc.img_data) {
+        cdsc->users++;
+        lv_refr_unlock_shared();
+        locked = false;
+    }
+#endif
+
     if(cdsc->dec_dsc.error_msg != NULL) {
         LV_LOG_WARN("Image draw error");
 
@@ -289,7 +305,7 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
         union_ok = _lv_area_intersect(&clip_com, draw_ctx->clip_area, &map_area_rot);
         /*Out of mask. There is nothing to draw so the image is drawn successfully.*/
         if(union_ok == false) {
-            draw_cleanup(cdsc);
+            draw_cleanup(cdsc, locked);
             return LV_RES_OK;
         }
 
@@ -305,7 +321,7 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
         union_ok = _lv_area_intersect(&mask_com, draw_ctx->clip_area, coords);
         /*Out of mask. There is nothing to draw so the image is drawn successfully.*/
         if(union_ok == false) {
-            draw_cleanup(cdsc);
+            draw_cleanup(cdsc, locked);
             return LV_RES_OK;
         }
 
@@ -332,7 +348,7 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
                 lv_img_decoder_close(&cdsc->dec_dsc);
                 LV_LOG_WARN("Image draw can't read the line");
                 lv_mem_buf_release(buf);
-                draw_cleanup(cdsc);
+                draw_cleanup(cdsc, locked);
                 draw_ctx->clip_area = clip_area_ori;
                 return LV_RES_INV;
             }
@@ -347,7 +363,7 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
         lv_mem_buf_release(buf);
     }
 
-    draw_cleanup(cdsc);
+    draw_cleanup(cdsc, locked);
     return LV_RES_OK;
 }
 
@@ -363,12 +379,23 @@ static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const
     lv_draw_label(draw_ctx, &label_dsc, coords, msg, NULL);
 }
 
-static void draw_cleanup(_lv_img_cache_entry_t * cache)
+static void draw_cleanup(_lv_img_cache_entry_t * cache, bool locked)
 {
+    LV_UNUSED(cache);
+
     /*Automatically close images with no caching*/
 #if LV_IMG_CACHE_DEF_SIZE == 0
     lv_img_decoder_close(&cache->dec_dsc);
-#else
-    LV_UNUSED(cache);
+#endif
+
+    if(locked) {
+        lv_refr_unlock_shared();
+    }
+#if LV_USE_REFR_PARALLEL && LV_IMG_CACHE_DEF_SIZE
+    else {
+        lv_refr_lock_shared();
+        cache->users--;
+        lv_refr_unlock_shared();
+    }
 #endif
 }
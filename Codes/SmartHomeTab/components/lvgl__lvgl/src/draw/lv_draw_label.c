@@ -97,6 +97,9 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     if(txt == NULL || txt[0] == '\0')
         return;
 
+    /*The hint is the label's: the threads of a parallel refresh can draw the label at the same time*/
+    if(_lv_refr_is_parallel()) hint = NULL;
+
     lv_area_t clipped_area;
     bool clip_ok = _lv_area_intersect(&clipped_area, coords, draw_ctx->clip_area);
     if(!clip_ok) return;
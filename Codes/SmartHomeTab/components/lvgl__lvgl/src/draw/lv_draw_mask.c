@@ -80,10 +80,11 @@ static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, l
  */
 int16_t lv_draw_mask_add(void * param, void * custom_id)
 {
+    _lv_draw_mask_saved_t * masks = _lv_scratch_get()->mask_list;
     /*Look for a free entry*/
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).param == NULL) break;
+        if(masks[i].param == NULL) break;
     }
 
     if(i >= _LV_MASK_MAX_NUM) {
@@ -91,8 +92,8 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
         return LV_MASK_ID_INV;
     }
 
-    LV_GC_ROOT(_lv_draw_mask_list[i]).param = param;
-    LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = custom_id;
+    masks[i].param = param;
+    masks[i].custom_id = custom_id;
 
     return i;
 }
@@ -114,7 +115,7 @@ lv_draw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_mask_apply(lv_opa_t * mask_buf,
     bool changed = false;
     _lv_draw_mask_common_dsc_t * dsc;
 
-    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
+    _lv_draw_mask_saved_t * m = _lv_scratch_get()->mask_list;
 
     while(m->param) {
         dsc = m->param;
@@ -146,13 +147,14 @@ lv_draw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_mask_apply_ids(lv_opa_t * mask_
                                                                 lv_coord_t abs_y, lv_coord_t len,
                                                                 const int16_t * ids, int16_t ids_count)
 {
+    _lv_draw_mask_saved_t * masks = _lv_scratch_get()->mask_list;
     bool changed = false;
     _lv_draw_mask_common_dsc_t * dsc;
 
     for(int i = 0; i < ids_count; i++) {
         int16_t id = ids[i];
         if(id == LV_MASK_ID_INV) continue;
-        dsc = LV_GC_ROOT(_lv_draw_mask_list[id]).param;
+        dsc = masks[id].param;
         if(!dsc) continue;
         lv_draw_mask_res_t res = LV_DRAW_MASK_RES_FULL_COVER;
         res = dsc->cb(mask_buf, abs_x, abs_y, len, dsc);
@@ -171,12 +173,13 @@ lv_draw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_mask_apply_ids(lv_opa_t * mask_
  */
 void * lv_draw_mask_remove_id(int16_t id)
 {
+    _lv_draw_mask_saved_t * masks = _lv_scratch_get()->mask_list;
     _lv_draw_mask_common_dsc_t * p = NULL;
 
     if(id != LV_MASK_ID_INV) {
-        p = LV_GC_ROOT(_lv_draw_mask_list[id]).param;
-        LV_GC_ROOT(_lv_draw_mask_list[id]).param = NULL;
-        LV_GC_ROOT(_lv_draw_mask_list[id]).custom_id = NULL;
+        p = masks[id].param;
+        masks[id].param = NULL;
+        masks[id].custom_id = NULL;
     }
 
     return p;
@@ -190,11 +193,12 @@ void * lv_draw_mask_remove_id(int16_t id)
  */
 void * lv_draw_mask_remove_custom(void * custom_id)
 {
+    _lv_draw_mask_saved_t * masks = _lv_scratch_get()->mask_list;
     _lv_draw_mask_common_dsc_t * p = NULL;
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id == custom_id) {
-            p = LV_GC_ROOT(_lv_draw_mask_list[i]).param;
+        if(masks[i].custom_id == custom_id) {
+            p = masks[i].param;
             lv_draw_mask_remove_id(i);
         }
     }
@@ -231,12 +235,13 @@ void lv_draw_mask_free_param(void * p)
 
 void _lv_draw_mask_cleanup(void)
 {
+    _lv_draw_mask_radius_circle_dsc_t * circles = _lv_scratch_get()->circle_cache;
     uint8_t i;
     for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
-        if(LV_GC_ROOT(_lv_circle_cache[i]).buf) {
-            lv_mem_free(LV_GC_ROOT(_lv_circle_cache[i]).buf);
+        if(circles[i].buf) {
+            lv_mem_free(circles[i].buf);
         }
-        lv_memset_00(&LV_GC_ROOT(_lv_circle_cache[i]), sizeof(LV_GC_ROOT(_lv_circle_cache[i])));
+        lv_memset_00(&circles[i], sizeof(circles[i]));
     }
 }
 
@@ -246,24 +251,26 @@ void _lv_draw_mask_cleanup(void)
  */
 uint8_t LV_ATTRIBUTE_FAST_MEM lv_draw_mask_get_cnt(void)
 {
+    _lv_draw_mask_saved_t * masks = _lv_scratch_get()->mask_list;
     uint8_t cnt = 0;
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).param) cnt++;
+        if(masks[i].param) cnt++;
     }
     return cnt;
 }
 
 bool lv_draw_mask_is_any(const lv_area_t * a)
 {
-    if(a == NULL) return LV_GC_ROOT(_lv_draw_mask_list[0]).param ? true : false;
+    _lv_draw_mask_saved_t * masks = _lv_scratch_get()->mask_list;
+    if(a == NULL) return masks[0].param ? true : false;
 
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        _lv_draw_mask_common_dsc_t * comm_param = LV_GC_ROOT(_lv_draw_mask_list[i]).param;
+        _lv_draw_mask_common_dsc_t * comm_param = masks[i].param;
         if(comm_param == NULL) continue;
         if(comm_param->type == LV_DRAW_MASK_TYPE_RADIUS) {
-            lv_draw_mask_radius_param_t * radius_param = LV_GC_ROOT(_lv_draw_mask_list[i]).param;
+            lv_draw_mask_radius_param_t * radius_param = masks[i].param;
             if(radius_param->cfg.outer) {
                 if(!_lv_area_is_out(a, &radius_param->cfg.rect, radius_param->cfg.radius)) return true;
             }
@@ -474,6 +481,7 @@ void lv_draw_mask_angle_init(lv_draw_mask_angle_param_t * param, lv_coord_t vert
  */
 void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area_t * rect, lv_coord_t radius, bool inv)
 {
+    _lv_draw_mask_radius_circle_dsc_t * circles = _lv_scratch_get()->circle_cache;
     lv_coord_t w = lv_area_get_width(rect);
     lv_coord_t h = lv_area_get_height(rect);
     int32_t short_side = LV_MIN(w, h);
@@ -495,10 +503,10 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
 
     /*Try to reuse a circle cache entry*/
     for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
-        if(LV_GC_ROOT(_lv_circle_cache[i]).radius == radius) {
-            LV_GC_ROOT(_lv_circle_cache[i]).used_cnt++;
-            CIRCLE_CACHE_AGING(LV_GC_ROOT(_lv_circle_cache[i]).life, radius);
-            param->circle = &LV_GC_ROOT(_lv_circle_cache[i]);
+        if(circles[i].radius == radius) {
+            circles[i].used_cnt++;
+            CIRCLE_CACHE_AGING(circles[i].life, radius);
+            param->circle = &circles[i];
             return;
         }
     }
@@ -506,9 +514,9 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
     /*If not found find a free entry with lowest life*/
     _lv_draw_mask_radius_circle_dsc_t * entry = NULL;
     for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
-        if(LV_GC_ROOT(_lv_circle_cache[i]).used_cnt == 0) {
-            if(!entry) entry = &LV_GC_ROOT(_lv_circle_cache[i]);
-            else if(LV_GC_ROOT(_lv_circle_cache[i]).life < entry->life) entry = &LV_GC_ROOT(_lv_circle_cache[i]);
+        if(circles[i].used_cnt == 0) {
+            if(!entry) entry = &circles[i];
+            else if(circles[i].life < entry->life) entry = &circles[i];
         }
     }
 
@@ -100,13 +100,20 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
     if(cached_src) return cached_src;
 
     /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
+    for(i = 0; i < entry_cnt; i++) {
+#if LV_USE_REFR_PARALLEL
+        if(cache[i].users) continue;    /*Another thread is drawing it*/
+#endif
+        if(cached_src == NULL || cache[i].life < cached_src->life) {
             cached_src = &cache[i];
         }
     }
 
+    if(cached_src == NULL) {
+        LV_LOG_WARN("lv_img_cache_open: every entry is being drawn, increase the cache size");
+        return NULL;
+    }
+
     /*Close the decoder to reuse if it was opened (has a valid source)*/
     if(cached_src->dec_dsc.src) {
         lv_img_decoder_close(&cached_src->dec_dsc);
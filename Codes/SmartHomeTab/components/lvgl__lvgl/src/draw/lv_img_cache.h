@@ -35,6 +35,12 @@ typedef struct {
      * Decrement all lifes by one every in every ::lv_img_cache_open.
      * If life == 0 the entry can be reused*/
     int32_t life;
+
+#if LV_USE_REFR_PARALLEL
+    /** Threads of a parallel refresh drawing the decoded image without `lv_refr_lock_shared()`.
+     * The entry is not reused while it's not 0.*/
+    uint32_t users;
+#endif
 } _lv_img_cache_entry_t;
 
 /**********************
@@ -11,6 +11,7 @@
 #include "../draw/lv_draw_img.h"
 #include "../misc/lv_ll.h"
 #include "../misc/lv_gc.h"
+#include "../core/lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -94,12 +95,14 @@ lv_res_t lv_img_decoder_get_info(const void * src, lv_img_header_t * header)
 
     lv_res_t res = LV_RES_INV;
     lv_img_decoder_t * d;
+    lv_refr_lock_shared();
     _LV_LL_READ(&LV_GC_ROOT(_lv_img_decoder_ll), d) {
         if(d->info_cb) {
             res = d->info_cb(d, src, header);
             if(res == LV_RES_OK) break;
         }
     }
+    lv_refr_unlock_shared();
 
     return res;
 }
@@ -295,7 +295,7 @@ static bool check_mask_simple_radius(const lv_area_t * coords, lv_coord_t * radi
 {
     if(lv_draw_mask_get_cnt() != 1) return false;
     for(uint8_t i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        _lv_draw_mask_common_dsc_t * param = LV_GC_ROOT(_lv_draw_mask_list[i]).param;
+        _lv_draw_mask_common_dsc_t * param = _lv_scratch_get()->mask_list[i].param;
         if(param->type == LV_DRAW_MASK_TYPE_RADIUS) {
             lv_draw_mask_radius_param_t * rparam = (lv_draw_mask_radius_param_t *) param;
             if(rparam->cfg.outer) return false;
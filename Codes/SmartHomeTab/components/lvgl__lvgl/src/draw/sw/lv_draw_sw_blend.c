@@ -11,13 +11,49 @@
 #include "../../hal/lv_hal_disp.h"
 #include "../../core/lv_refr.h"
 
+#if LV_USE_DRAW_SW_BLEND_CUSTOM
+    #include LV_DRAW_SW_BLEND_CUSTOM_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
 
+/*Optional replacements of the RGB565 kernels (see `LV_USE_DRAW_SW_BLEND_CUSTOM`).
+ *Each one returns `LV_RES_OK` if it has blended the whole area
+ *or `LV_RES_INV` to let the built-in loops below do it.*/
+#ifndef LV_DRAW_SW_BLEND_RGB565_FILL
+    #define LV_DRAW_SW_BLEND_RGB565_FILL(dest_buf, dest_stride, w, h, color) LV_RES_INV
+#endif
+
+#ifndef LV_DRAW_SW_BLEND_RGB565_FILL_OPA
+    #define LV_DRAW_SW_BLEND_RGB565_FILL_OPA(dest_buf, dest_stride, w, h, color, opa) LV_RES_INV
+#endif
+
+#ifndef LV_DRAW_SW_BLEND_RGB565_FILL_MASK
+    #define LV_DRAW_SW_BLEND_RGB565_FILL_MASK(dest_buf, dest_stride, w, h, color, mask, mask_stride) LV_RES_INV
+#endif
+
+#ifndef LV_DRAW_SW_BLEND_RGB565_COPY
+    #define LV_DRAW_SW_BLEND_RGB565_COPY(dest_buf, dest_stride, w, h, src_buf, src_stride) LV_RES_INV
+#endif
+
+#ifndef LV_DRAW_SW_BLEND_RGB565_MAP_MASK
+    #define LV_DRAW_SW_BLEND_RGB565_MAP_MASK(dest_buf, dest_stride, w, h, src_buf, src_stride, mask, mask_stride) LV_RES_INV
+#endif
+
+#define BLEND_RGB565_HOOKS (LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0)
+
 /**********************
  *      TYPEDEFS
  **********************/
+/*The last color blended in a map_argb() call*/
+typedef struct {
+    lv_color_t dest;
+    lv_color_t src;
+    lv_color_t res;
+    uint32_t opa;
+} blend_cache_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -252,6 +288,9 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
     /*No mask*/
     if(mask == NULL) {
         if(opa >= LV_OPA_MAX) {
+#if BLEND_RGB565_HOOKS
+            if(LV_DRAW_SW_BLEND_RGB565_FILL(dest_buf, dest_stride, w, h, color) == LV_RES_OK) return;
+#endif
             for(y = 0; y < h; y++) {
                 lv_color_fill(dest_buf, color, w);
                 dest_buf += dest_stride;
@@ -259,6 +298,9 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
         }
         /*Has opacity*/
         else {
+#if BLEND_RGB565_HOOKS
+            if(LV_DRAW_SW_BLEND_RGB565_FILL_OPA(dest_buf, dest_stride, w, h, color, opa) == LV_RES_OK) return;
+#endif
             lv_color_t last_dest_color = lv_color_black();
             lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
 
@@ -293,6 +335,9 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
 #endif
         /*Only the mask matters*/
         if(opa >= LV_OPA_MAX) {
+#if BLEND_RGB565_HOOKS
+            if(LV_DRAW_SW_BLEND_RGB565_FILL_MASK(dest_buf, dest_stride, w, h, color, mask, mask_stride) == LV_RES_OK) return;
+#endif
             int32_t x_end4 = w - 4;
             for(y = 0; y < h; y++) {
                 for(x = 0; x < w && ((lv_uintptr_t)(mask) & 0x3); x++) {
@@ -402,13 +447,8 @@ static inline void set_px_argb(uint8_t * buf, lv_color_t color, lv_opa_t opa)
 }
 
 static inline void set_px_argb_blend(uint8_t * buf, lv_color_t color, lv_opa_t opa, lv_color_t (*blend_fp)(lv_color_t,
-                                                                                                           lv_color_t, lv_opa_t))
+                                                                                                           lv_color_t, lv_opa_t), blend_cache_t * cache)
 {
-    static lv_color_t last_dest_color;
-    static lv_color_t last_src_color;
-    static lv_color_t last_res_color;
-    static uint32_t last_opa = 0xffff; /*Set to an invalid value for first*/
-
     lv_color_t bg_color;
 
     /*Get the BG color*/
@@ -424,23 +464,23 @@ static inline void set_px_argb_blend(uint8_t * buf, lv_color_t color, lv_opa_t o
 #endif
 
     /*Get the result color*/
-    if(last_dest_color.full != bg_color.full || last_src_color.full != color.full || last_opa != opa) {
-        last_dest_color = bg_color;
-        last_src_color = color;
-        last_opa = opa;
-        last_res_color = blend_fp(last_src_color, last_dest_color, last_opa);
+    if(cache->dest.full != bg_color.full || cache->src.full != color.full || cache->opa != opa) {
+        cache->dest = bg_color;
+        cache->src = color;
+        cache->opa = opa;
+        cache->res = blend_fp(cache->src, cache->dest, cache->opa);
     }
 
     /*Set the result color*/
 #if LV_COLOR_DEPTH == 8
-    buf[0] = last_res_color.full;
+    buf[0] = cache->res.full;
 #elif LV_COLOR_DEPTH == 16
-    buf[0] = last_res_color.full & 0xff;
-    buf[1] = last_res_color.full >> 8;
+    buf[0] = cache->res.full & 0xff;
+    buf[1] = cache->res.full >> 8;
 #elif LV_COLOR_DEPTH == 32
-    buf[0] = last_res_color.ch.blue;
-    buf[1] = last_res_color.ch.green;
-    buf[2] = last_res_color.ch.red;
+    buf[0] = cache->res.ch.blue;
+    buf[1] = cache->res.ch.green;
+    buf[2] = cache->res.ch.red;
 #endif
 
 }
@@ -653,6 +693,9 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
     /*Simple fill (maybe with opacity), no masking*/
     if(mask == NULL) {
         if(opa >= LV_OPA_MAX) {
+#if BLEND_RGB565_HOOKS
+            if(LV_DRAW_SW_BLEND_RGB565_COPY(dest_buf, dest_stride, w, h, src_buf, src_stride) == LV_RES_OK) return;
+#endif
             for(y = 0; y < h; y++) {
                 lv_memcpy(dest_buf, src_buf, w * sizeof(lv_color_t));
                 dest_buf += dest_stride;
@@ -673,6 +716,10 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
     else {
         /*Only the mask matters*/
         if(opa > LV_OPA_MAX) {
+#if BLEND_RGB565_HOOKS
+            if(LV_DRAW_SW_BLEND_RGB565_MAP_MASK(dest_buf, dest_stride, w, h, src_buf, src_stride, mask,
+                                                mask_stride) == LV_RES_OK) return;
+#endif
             int32_t x_end4 = w - 4;
 
             for(y = 0; y < h; y++) {
@@ -763,6 +810,10 @@ static void LV_ATTRIBUTE_FAST_MEM map_argb(lv_color_t * dest_buf, const lv_area_
             blend_fp = NULL;
     }
 
+    blend_cache_t cache;
+    lv_memset_00(&cache, sizeof(cache));
+    cache.opa = 0xffff; /*Set to an invalid value for first*/
+
     /*Simple fill (maybe with opacity), no masking*/
     if(mask == NULL) {
         if(opa >= LV_OPA_MAX) {
@@ -784,7 +835,7 @@ static void LV_ATTRIBUTE_FAST_MEM map_argb(lv_color_t * dest_buf, const lv_area_
                     }
                     else {
                         for(x = 0; x < w; x++) {
-                            set_px_argb_blend(dest_buf8, src_buf[x], LV_OPA_COVER, blend_fp);
+                            set_px_argb_blend(dest_buf8, src_buf[x], LV_OPA_COVER, blend_fp, &cache);
                             dest_buf8 += LV_IMG_PX_SIZE_ALPHA_BYTE;
                         }
                     }
@@ -807,7 +858,7 @@ static void LV_ATTRIBUTE_FAST_MEM map_argb(lv_color_t * dest_buf, const lv_area_
                 }
                 else {
                     for(x = 0; x < w; x++) {
-                        set_px_argb_blend(dest_buf8, src_buf[x], opa, blend_fp);
+                        set_px_argb_blend(dest_buf8, src_buf[x], opa, blend_fp, &cache);
                         dest_buf8 += LV_IMG_PX_SIZE_ALPHA_BYTE;
                     }
                 }
@@ -832,7 +883,7 @@ static void LV_ATTRIBUTE_FAST_MEM map_argb(lv_color_t * dest_buf, const lv_area_
                 }
                 else {
                     for(x = 0; x < w; x++) {
-                        set_px_argb_blend(dest_buf8, src_buf[x], mask[x], blend_fp);
+                        set_px_argb_blend(dest_buf8, src_buf[x], mask[x], blend_fp, &cache);
                         dest_buf8 += LV_IMG_PX_SIZE_ALPHA_BYTE;
                     }
                 }
@@ -859,7 +910,7 @@ static void LV_ATTRIBUTE_FAST_MEM map_argb(lv_color_t * dest_buf, const lv_area_
                     for(x = 0; x < w; x++) {
                         if(mask[x]) {
                             lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
-                            set_px_argb_blend(dest_buf8, src_buf[x], opa_tmp, blend_fp);
+                            set_px_argb_blend(dest_buf8, src_buf[x], opa_tmp, blend_fp, &cache);
                         }
                         dest_buf8 += LV_IMG_PX_SIZE_ALPHA_BYTE;
                     }
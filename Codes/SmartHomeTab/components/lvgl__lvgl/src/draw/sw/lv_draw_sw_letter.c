@@ -11,6 +11,7 @@
 #include "../../misc/lv_math.h"
 #include "../../misc/lv_assert.h"
 #include "../../misc/lv_area.h"
+#include "../../misc/lv_gc.h"
 #include "../../misc/lv_style.h"
 #include "../../font/lv_font.h"
 #include "../../core/lv_refr.h"
@@ -139,7 +140,19 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
         return;
     }
 
+    /*With a parallel refresh the bitmap can be in a buffer of the font the other threads reuse: copy it*/
+    uint8_t * map_copy = NULL;
+    lv_refr_lock_shared();
     const uint8_t * map_p = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+    if(map_p && _lv_refr_is_parallel() && g.bpp <= 8) {
+        uint32_t bpp = g.bpp == 3 ? 4 : g.bpp;
+        uint32_t map_size = ((uint32_t)g.box_w * g.box_h * bpp + 7) >> 3;
+        map_copy = lv_mem_buf_get(map_size);
+        if(map_copy) lv_memcpy(map_copy, map_p, map_size);
+        map_p = map_copy;
+    }
+    lv_refr_unlock_shared();
+
     if(map_p == NULL) {
         LV_LOG_WARN("lv_draw_letter: character's bitmap not found");
         return;
@@ -155,6 +168,8 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
     else {
         draw_letter_normal(draw_ctx, dsc, &gpos, &g, map_p);
     }
+
+    if(map_copy) lv_mem_buf_release(map_copy);
 }
 
 /**********************
@@ -217,19 +232,18 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
             return; /*Invalid bpp. Can't render the letter*/
     }
 
-    static lv_opa_t opa_table[256];
-    static lv_opa_t prev_opa = LV_OPA_TRANSP;
-    static uint32_t prev_bpp = 0;
     if(opa < LV_OPA_MAX) {
-        if(prev_opa != opa || prev_bpp != bpp) {
+        _lv_scratch_t * scratch = _lv_scratch_get();
+        lv_opa_t * opa_table = scratch->letter_opa_table;
+        if(scratch->letter_opa != opa || scratch->letter_bpp != bpp) {
             uint32_t i;
             for(i = 0; i < shades; i++) {
                 opa_table[i] = bpp_opa_table_p[i] == LV_OPA_COVER ? opa : ((bpp_opa_table_p[i] * opa) >> 8);
             }
         }
         bpp_opa_table_p = opa_table;
-        prev_opa = opa;
-        prev_bpp = bpp;
+        scratch->letter_opa = opa;
+        scratch->letter_bpp = bpp;
     }
 
     int32_t col, row;
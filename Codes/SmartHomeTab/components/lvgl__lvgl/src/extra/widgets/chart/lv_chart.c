@@ -10,6 +10,8 @@
 #if LV_USE_CHART != 0
 
 #include "../../../misc/lv_assert.h"
+#include "../../../draw/sw/lv_draw_sw.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
@@ -33,13 +35,20 @@ static void lv_chart_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_chart_event(const lv_obj_class_t * class_p, lv_event_t * e);
 
 static void draw_div_lines(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
-static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
+static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, lv_chart_series_t * only);
+static void draw_series_cache(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
 static void draw_series_bar(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
 static void draw_series_scatter(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
 static void draw_cursors(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
 static void draw_axes(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
 static uint32_t get_index_from_x(lv_obj_t * obj, lv_coord_t x);
 static void invalidate_point(lv_obj_t * obj, uint16_t i);
+static bool cache_usable(lv_obj_t * obj);
+static bool cache_ready(lv_obj_t * obj);
+static void cache_drop(lv_obj_t * obj);
+static void cache_draw(lv_obj_t * obj, lv_chart_series_t * only, const lv_area_t * area);
+static void cache_append(lv_obj_t * obj, lv_chart_series_t * ser);
+static void cache_redraw_point(lv_obj_t * obj, lv_chart_series_t * ser, uint16_t id);
 static void new_points_alloc(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t cnt, lv_coord_t ** a);
 lv_chart_tick_dsc_t * get_tick_gsc(lv_obj_t * obj, lv_chart_axis_t axis);
 
@@ -165,6 +174,7 @@ void lv_chart_set_update_mode(lv_obj_t * obj, lv_chart_update_mode_t update_mode
     if(chart->update_mode == update_mode) return;
 
     chart->update_mode = update_mode;
+    cache_drop(obj);
     lv_obj_invalidate(obj);
 }
 
@@ -192,6 +202,7 @@ void lv_chart_set_zoom_x(lv_obj_t * obj, uint16_t zoom_x)
     lv_obj_refresh_self_size(obj);
     /*Be the chart doesn't remain scrolled out*/
     lv_obj_readjust_scroll(obj, LV_ANIM_OFF);
+    cache_drop(obj);
     lv_obj_invalidate(obj);
 }
 
@@ -206,6 +217,7 @@ void lv_chart_set_zoom_y(lv_obj_t * obj, uint16_t zoom_y)
     lv_obj_refresh_self_size(obj);
     /*Be the chart doesn't remain scrolled out*/
     lv_obj_readjust_scroll(obj, LV_ANIM_OFF);
+    cache_drop(obj);
     lv_obj_invalidate(obj);
 }
 
@@ -331,9 +343,28 @@ void lv_chart_refresh(lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    cache_drop(obj);
     lv_obj_invalidate(obj);
 }
 
+void lv_chart_set_cache_buf(lv_obj_t * obj, void * buf, uint32_t size)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    chart->cache_buf = buf;
+    chart->cache_size = buf ? size : 0;
+    lv_chart_refresh(obj);
+}
+
+uint32_t lv_chart_get_cache_size(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    return lv_area_get_size(&obj->coords) * _lv_ll_get_len(&chart->series_ll);
+}
+
 /*======================
  * Series
  *=====================*/
@@ -365,7 +396,11 @@ lv_chart_series_t * lv_chart_add_series(lv_obj_t * obj, lv_color_t color, lv_cha
         return NULL;
     }
 
+    /*The planes are in the order of the series*/
+    cache_drop(obj);
+
     ser->start_point = 0;
+    ser->cache_shift = 0;
     ser->y_ext_buf_assigned = false;
     ser->hidden = 0;
     ser->x_axis_sec = axis & LV_CHART_AXIS_SECONDARY_X ? 1 : 0;
@@ -393,6 +428,7 @@ void lv_chart_remove_series(lv_obj_t * obj, lv_chart_series_t * series)
     _lv_ll_remove(&chart->series_ll, series);
     lv_mem_free(series);
 
+    cache_drop(obj);
     return;
 }
 
@@ -422,6 +458,7 @@ void lv_chart_set_x_start_point(lv_obj_t * obj, lv_chart_series_t * ser, uint16_
     lv_chart_t * chart  = (lv_chart_t *)obj;
     if(id >= chart->point_cnt) return;
     ser->start_point = id;
+    cache_drop(obj);
 }
 
 lv_chart_series_t * lv_chart_get_series_next(const lv_obj_t * obj, const lv_chart_series_t * ser)
@@ -539,6 +576,22 @@ void lv_chart_set_next_value(lv_obj_t * obj, lv_chart_series_t * ser, lv_coord_t
 
     lv_chart_t * chart  = (lv_chart_t *)obj;
     ser->y_points[ser->start_point] = value;
+
+    /*Only the new segment needs to be drawn into the planes, but the whole plot moves.
+     *The lines reach out of the content area by a line width and a point at most.*/
+    if(cache_usable(obj)) {
+        ser->start_point = (ser->start_point + 1) % chart->point_cnt;
+        cache_append(obj, ser);
+
+        lv_area_t plot_area;
+        lv_obj_get_content_coords(obj, &plot_area);
+        lv_coord_t ext = lv_obj_get_style_line_width(obj, LV_PART_ITEMS) + lv_obj_get_style_width(obj, LV_PART_INDICATOR);
+        lv_area_increase(&plot_area, ext, ext);
+        lv_obj_invalidate_area(obj, &plot_area);
+        return;
+    }
+
+    cache_drop(obj);
     invalidate_point(obj, ser->start_point);
     ser->start_point = (ser->start_point + 1) % chart->point_cnt;
     invalidate_point(obj, ser->start_point);
@@ -559,6 +612,7 @@ void lv_chart_set_next_value2(lv_obj_t * obj, lv_chart_series_t * ser, lv_coord_
     ser->x_points[ser->start_point] = x_value;
     ser->y_points[ser->start_point] = y_value;
     ser->start_point = (ser->start_point + 1) % chart->point_cnt;
+    cache_drop(obj);
     invalidate_point(obj, ser->start_point);
 }
 
@@ -570,6 +624,8 @@ void lv_chart_set_value_by_id(lv_obj_t * obj, lv_chart_series_t * ser, uint16_t
 
     if(id >= chart->point_cnt) return;
     ser->y_points[id] = value;
+    if(cache_ready(obj)) cache_redraw_point(obj, ser, id);
+    else cache_drop(obj);
     invalidate_point(obj, id);
 }
 
@@ -588,6 +644,7 @@ void lv_chart_set_value_by_id2(lv_obj_t * obj, lv_chart_series_t * ser, uint16_t
     if(id >= chart->point_cnt) return;
     ser->x_points[id] = x_value;
     ser->y_points[id] = y_value;
+    cache_drop(obj);
     invalidate_point(obj, id);
 }
 
@@ -599,6 +656,7 @@ void lv_chart_set_ext_y_array(lv_obj_t * obj, lv_chart_series_t * ser, lv_coord_
     if(!ser->y_ext_buf_assigned && ser->y_points) lv_mem_free(ser->y_points);
     ser->y_ext_buf_assigned = true;
     ser->y_points = array;
+    cache_drop(obj);
     lv_obj_invalidate(obj);
 }
 
@@ -610,6 +668,7 @@ void lv_chart_set_ext_x_array(lv_obj_t * obj, lv_chart_series_t * ser, lv_coord_
     if(!ser->x_ext_buf_assigned && ser->x_points) lv_mem_free(ser->x_points);
     ser->x_ext_buf_assigned = true;
     ser->x_points = array;
+    cache_drop(obj);
     lv_obj_invalidate(obj);
 }
 
@@ -731,6 +790,7 @@ static void lv_chart_event(const lv_obj_class_t * class_p, lv_event_t * e)
         chart->pressed_point_id = LV_CHART_POINT_NONE;
     }
     else if(code == LV_EVENT_SIZE_CHANGED) {
+        cache_drop(obj);
         lv_obj_refresh_self_size(obj);
     }
     else if(code == LV_EVENT_REFR_EXT_DRAW_SIZE) {
@@ -748,7 +808,15 @@ static void lv_chart_event(const lv_obj_class_t * class_p, lv_event_t * e)
         draw_axes(obj, draw_ctx);
 
         if(_lv_ll_is_empty(&chart->series_ll) == false) {
-            if(chart->type == LV_CHART_TYPE_LINE) draw_series_line(obj, draw_ctx);
+            if(chart->type == LV_CHART_TYPE_LINE) {
+                /*The planes can't be blended through masks, e.g. of a rounded parent*/
+                if(cache_ready(obj) && !lv_draw_mask_is_any(&obj->coords)) {
+                    draw_series_cache(obj, draw_ctx);
+                }
+                else {
+                    draw_series_line(obj, draw_ctx, NULL);
+                }
+            }
             else if(chart->type == LV_CHART_TYPE_BAR) draw_series_bar(obj, draw_ctx);
             else if(chart->type == LV_CHART_TYPE_SCATTER) draw_series_scatter(obj, draw_ctx);
         }
@@ -865,7 +933,13 @@ static void draw_div_lines(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
     draw_ctx->clip_area = clip_area_ori;
 }
 
-static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
+/**
+ * Draw the lines and points of the series
+ * @param obj       pointer to a chart object
+ * @param draw_ctx  the draw context
+ * @param only      draw only this series, or NULL to draw all
+ */
+static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, lv_chart_series_t * only)
 {
     lv_area_t clip_area;
     if(_lv_area_intersect(&clip_area, &obj->coords, draw_ctx->clip_area) == false) return;
@@ -913,8 +987,10 @@ static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
     /*Go through all data lines*/
     _LV_LL_READ_BACK(&chart->series_ll, ser) {
         if(ser->hidden) continue;
-        line_dsc_default.color = ser->color;
-        point_dsc_default.bg_color = ser->color;
+        if(only && ser != only) continue;
+        /*In the planes the brightness is the opacity, the color is added when they are blended*/
+        line_dsc_default.color = chart->cache_drawing ? lv_color_white() : ser->color;
+        point_dsc_default.bg_color = line_dsc_default.color;
 
         lv_coord_t start_point = lv_chart_get_x_start_point(obj, ser);
 
@@ -954,6 +1030,9 @@ static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
 
             if(p2.x < clip_area_ori->x1 - point_w - 1) {
                 p_prev = p_act;
+                /*Start the vertical lines of the crowded mode from here*/
+                y_min = p2.y;
+                y_max = p2.y;
                 continue;
             }
 
@@ -977,6 +1056,11 @@ static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
                             y_max = y_cur;
                         }
                     }
+                    else {
+                        /*Do not join the points across a gap*/
+                        y_min = p2.y;
+                        y_max = p2.y;
+                    }
                 }
                 else {
                     lv_area_t point_area;
@@ -1740,6 +1824,253 @@ static void invalidate_point(lv_obj_t * obj, uint16_t i)
     }
 }
 
+static bool cache_usable(lv_obj_t * obj)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    if(chart->cache_buf == NULL) return false;
+    if(chart->type != LV_CHART_TYPE_LINE || chart->update_mode != LV_CHART_UPDATE_MODE_SHIFT) return false;
+    if(chart->zoom_x != LV_IMG_ZOOM_NONE || chart->zoom_y != LV_IMG_ZOOM_NONE) return false;
+    if(chart->point_cnt < 2) return false;
+
+    return chart->cache_size >= lv_chart_get_cache_size(obj);
+}
+
+/**
+ * Hash what the planes depend on besides the data: the size and the styles of the lines and points.
+ * Not all style changes send an event, so it's compared before the planes are used.
+ */
+static uint32_t cache_key(lv_obj_t * obj)
+{
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    lv_obj_init_draw_line_dsc(obj, LV_PART_ITEMS, &line_dsc);
+    line_dsc.color = lv_color_black();      /*Added only when blended*/
+
+    lv_draw_rect_dsc_t point_dsc;
+    lv_draw_rect_dsc_init(&point_dsc);
+    lv_coord_t geom[6];
+    geom[0] = lv_area_get_width(&obj->coords);
+    geom[1] = lv_area_get_height(&obj->coords);
+    geom[2] = lv_obj_get_style_pad_left(obj, LV_PART_MAIN) + lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    geom[3] = lv_obj_get_style_pad_top(obj, LV_PART_MAIN) + lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    geom[4] = lv_obj_get_style_width(obj, LV_PART_INDICATOR);
+    geom[5] = lv_obj_get_style_height(obj, LV_PART_INDICATOR);
+    if(geom[4] && geom[5]) {
+        lv_obj_init_draw_rect_dsc(obj, LV_PART_INDICATOR, &point_dsc);
+        point_dsc.bg_color = lv_color_black();
+    }
+
+    /*FNV-1a*/
+    const uint8_t * parts[3] = {(const uint8_t *) &line_dsc, (const uint8_t *) &point_dsc, (const uint8_t *) geom};
+    const uint32_t sizes[3] = {sizeof(line_dsc), sizeof(point_dsc), sizeof(geom)};
+    uint32_t key = 2166136261u;
+    uint32_t i, j;
+    for(i = 0; i < 3; i++) {
+        for(j = 0; j < sizes[i]; j++) {
+            key = (key ^ parts[i][j]) * 16777619u;
+        }
+    }
+    return key;
+}
+
+/*The planes hold the current lines and can be used*/
+static bool cache_ready(lv_obj_t * obj)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    return chart->cache_valid && cache_usable(obj) && chart->cache_key == cache_key(obj);
+}
+
+static void cache_drop(lv_obj_t * obj)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    chart->cache_valid = 0;
+}
+
+static lv_opa_t * cache_plane(lv_obj_t * obj, lv_chart_series_t * ser)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    lv_opa_t * plane = chart->cache_buf;
+    lv_chart_series_t * s;
+    _LV_LL_READ_BACK(&chart->series_ll, s) {
+        if(s == ser) break;
+        plane += lv_area_get_size(&obj->coords);
+    }
+    return plane;
+}
+
+/**
+ * Draw the lines into their planes
+ * @param obj       pointer to a chart object
+ * @param only      draw only the plane of this series, or NULL to draw all
+ * @param area      the area to draw, in absolute coordinates on the chart
+ */
+static void cache_draw(lv_obj_t * obj, lv_chart_series_t * only, const lv_area_t * area)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    lv_area_t clip_area;
+    if(_lv_area_intersect(&clip_area, area, &obj->coords) == false) return;
+
+    /*A display of 8 bit opacities with the planes as draw buffer, like lv_snapshot does it*/
+    lv_disp_t * obj_disp = lv_obj_get_disp(obj);
+    lv_disp_drv_t driver;
+    lv_disp_drv_init(&driver);
+    driver.hor_res = lv_disp_get_hor_res(obj_disp);
+    driver.ver_res = lv_disp_get_ver_res(obj_disp);
+    lv_disp_drv_use_generic_set_px_cb(&driver, LV_IMG_CF_ALPHA_8BIT);
+
+    lv_disp_t fake_disp;
+    lv_memset_00(&fake_disp, sizeof(lv_disp_t));
+    fake_disp.driver = &driver;
+
+    lv_draw_sw_ctx_t draw_ctx;
+    lv_draw_sw_init_ctx(&driver, &draw_ctx.base_draw);
+    driver.draw_ctx = &draw_ctx.base_draw;
+    draw_ctx.base_draw.buf_area = &obj->coords;
+    draw_ctx.base_draw.clip_area = &clip_area;
+
+    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(&fake_disp);
+    chart->cache_drawing = 1;
+
+    lv_coord_t plane_w = lv_area_get_width(&obj->coords);
+    lv_coord_t clip_w = lv_area_get_width(&clip_area);
+    lv_opa_t * plane = chart->cache_buf;
+    lv_chart_series_t * ser;
+    _LV_LL_READ_BACK(&chart->series_ll, ser) {
+        if(only == NULL || ser == only) {
+            lv_coord_t y;
+            for(y = clip_area.y1; y <= clip_area.y2; y++) {
+                lv_memset_00(plane + (y - obj->coords.y1) * plane_w + (clip_area.x1 - obj->coords.x1), clip_w);
+            }
+            draw_ctx.base_draw.buf = plane;
+            draw_series_line(obj, &draw_ctx.base_draw, ser);
+        }
+        plane += lv_area_get_size(&obj->coords);
+    }
+
+    chart->cache_drawing = 0;
+    _lv_refr_set_disp_refreshing(refr_ori);
+    lv_draw_sw_deinit_ctx(&driver, &draw_ctx.base_draw);
+}
+
+static void cache_append(lv_obj_t * obj, lv_chart_series_t * ser)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+
+    if(!cache_ready(obj)) {
+        cache_draw(obj, NULL, &obj->coords);
+        /*The other series are drawn in full again on their next append, as if a window scrolled:
+         *then every plane is anchored to the appends of its own series*/
+        lv_chart_series_t * s;
+        _LV_LL_READ(&chart->series_ll, s) s->cache_shift = s == ser ? 0 : chart->point_cnt - 2;
+        chart->cache_key = cache_key(obj);
+        chart->cache_valid = 1;
+        return;
+    }
+
+    /*The points are (w * i) / (point_cnt - 1) apart. Scroll by whole pixels so that in sum
+     *the plane moved by the same as the points; after point_cnt - 1 appends exactly by w.
+     *The segments can sit 1 px off meanwhile, so when a whole window has scrolled the plane is
+     *drawn again in full, like a full draw puts the points.*/
+    lv_coord_t w = lv_obj_get_content_width(obj);
+    uint32_t n = chart->point_cnt - 1;
+    ser->cache_shift = (ser->cache_shift + 1) % n;
+    if(ser->cache_shift == 0) {
+        cache_draw(obj, ser, &obj->coords);
+        return;
+    }
+
+    lv_coord_t dx = ((int32_t)w * ser->cache_shift) / n - ((int32_t)w * (ser->cache_shift - 1)) / n;
+
+    lv_coord_t plane_w = lv_area_get_width(&obj->coords);
+    lv_coord_t plane_h = lv_area_get_height(&obj->coords);
+    lv_opa_t * row = cache_plane(obj, ser);
+    if(dx > plane_w) dx = plane_w;
+    lv_coord_t y;
+    for(y = 0; y < plane_h; y++) {
+        memmove(row, row + dx, plane_w - dx);
+        lv_memset_00(row + plane_w - dx, dx);
+        row += plane_w;
+    }
+
+    lv_coord_t border_width = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    lv_coord_t x_ofs = obj->coords.x1 + lv_obj_get_style_pad_left(obj, LV_PART_MAIN) + border_width;
+    lv_coord_t line_width = lv_obj_get_style_line_width(obj, LV_PART_ITEMS);
+    lv_coord_t point_w = lv_obj_get_style_width(obj, LV_PART_INDICATOR);
+
+    /*Draw again from the one but last point to the right edge*/
+    lv_area_t area;
+    lv_area_copy(&area, &obj->coords);
+    area.x1 = x_ofs + (w * (n - 1)) / n - line_width - point_w - 1;
+    cache_draw(obj, ser, &area);
+
+    /*and around the first point, to remove the end of the segment scrolled out*/
+    lv_area_copy(&area, &obj->coords);
+    area.x2 = x_ofs + line_width + point_w + 1;
+    cache_draw(obj, ser, &area);
+}
+
+static void cache_redraw_point(lv_obj_t * obj, lv_chart_series_t * ser, uint16_t id)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+
+    /*Position of the point on the chart*/
+    uint32_t n = chart->point_cnt - 1;
+    uint32_t i = (id + chart->point_cnt - ser->start_point) % chart->point_cnt;
+    uint32_t i_prev = i > 0 ? i - 1 : 0;
+    uint32_t i_next = i < n ? i + 1 : n;
+
+    lv_coord_t w = lv_obj_get_content_width(obj);
+    lv_coord_t border_width = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    lv_coord_t x_ofs = obj->coords.x1 + lv_obj_get_style_pad_left(obj, LV_PART_MAIN) + border_width;
+    lv_coord_t line_width = lv_obj_get_style_line_width(obj, LV_PART_ITEMS);
+    lv_coord_t point_w = lv_obj_get_style_width(obj, LV_PART_INDICATOR);
+
+    /*Draw again the segments to both neighbors*/
+    lv_area_t area;
+    lv_area_copy(&area, &obj->coords);
+    area.x1 = x_ofs + (w * i_prev) / n - line_width - point_w - 1;
+    area.x2 = x_ofs + (w * i_next) / n + line_width + point_w + 1;
+    cache_draw(obj, ser, &area);
+}
+
+/**
+ * Blend the planes of the lines with the colors of their series
+ * @param obj       pointer to a chart object
+ * @param draw_ctx  the draw context
+ */
+static void draw_series_cache(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    lv_area_t clip_area;
+    if(_lv_area_intersect(&clip_area, &obj->coords, draw_ctx->clip_area) == false) return;
+
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    draw_ctx->clip_area = &clip_area;
+
+    /*The opacity of the lines is already in the planes*/
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.blend_area = &obj->coords;
+    blend_dsc.mask_area = &obj->coords;
+    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+    blend_dsc.opa = LV_OPA_COVER;
+    blend_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, LV_PART_ITEMS);
+
+    lv_opa_t * plane = chart->cache_buf;
+    lv_chart_series_t * ser;
+    _LV_LL_READ_BACK(&chart->series_ll, ser) {
+        if(!ser->hidden) {
+            blend_dsc.color = ser->color;
+            blend_dsc.mask_buf = plane;
+            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+        }
+        plane += lv_area_get_size(&obj->coords);
+    }
+
+    draw_ctx->clip_area = clip_area_ori;
+}
+
 static void new_points_alloc(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t cnt, lv_coord_t ** a)
 {
     if((*a) == NULL) return;
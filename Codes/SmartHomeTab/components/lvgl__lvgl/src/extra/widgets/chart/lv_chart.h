@@ -73,6 +73,7 @@ typedef struct {
     lv_coord_t * y_points;
     lv_color_t color;
     uint16_t start_point;
+    uint16_t cache_shift;       /**< Appends since the cached line was drawn in full, see `lv_chart_set_cache_buf`*/
     uint8_t hidden : 1;
     uint8_t x_ext_buf_assigned : 1;
     uint8_t y_ext_buf_assigned : 1;
@@ -113,8 +114,13 @@ typedef struct {
     uint16_t point_cnt;    /**< Point number in a data line*/
     uint16_t zoom_x;
     uint16_t zoom_y;
+    lv_opa_t * cache_buf;   /**< Alpha planes of the lines, one per series*/
+    uint32_t cache_size;    /**< Size of `cache_buf` in bytes*/
+    uint32_t cache_key;     /**< Hash of the size and styles the planes were drawn with*/
     lv_chart_type_t type  : 3; /**< Line or column chart*/
     lv_chart_update_mode_t update_mode : 1;
+    uint8_t cache_valid : 1;    /**< The planes hold the current lines*/
+    uint8_t cache_drawing : 1;  /**< The lines are being drawn into the planes*/
 } lv_chart_t;
 
 extern const lv_obj_class_t lv_chart_class;
@@ -261,6 +267,33 @@ void lv_chart_get_point_pos_by_id(lv_obj_t * obj, lv_chart_series_t * ser, uint1
  */
 void lv_chart_refresh(lv_obj_t * obj);
 
+/**
+ * Give the chart a buffer to keep its rendered lines in, one 8 bit alpha plane per series
+ * of the size of the object. While the buffer is set, a line chart in `LV_CHART_UPDATE_MODE_SHIFT`
+ * mode without zoom keeps the planes up to date on `lv_chart_set_next_value`: the plane of the series
+ * is scrolled to the left and only the new segment is drawn, and `lv_chart_set_value_by_id` redraws
+ * only the segments around the point. Drawing the chart then blends the planes instead of drawing
+ * every segment again.
+ * Any other change of the chart (range, point count, styles, size, etc.) drops the planes
+ * and the lines are drawn normally until the next `lv_chart_set_next_value`.
+ * The segments scrolled this way can be 1 pixel off until a whole window (`point_cnt - 1` values) scrolled,
+ * then the plane of the series is drawn again in full.
+ * `LV_EVENT_DRAW_PART_BEGIN/END` of the lines are sent only while the lines are drawn into the planes,
+ * and the colors set there are not used. Works only with the software renderer.
+ * @param obj       pointer to a chart object
+ * @param buf       a buffer of at least `lv_chart_get_cache_size()` bytes, or NULL to draw the lines directly.
+ *                  It needs to live while the chart exists or until an other buffer is set.
+ * @param size      size of `buf` in bytes
+ */
+void lv_chart_set_cache_buf(lv_obj_t * obj, void * buf, uint32_t size);
+
+/**
+ * Get the size of the buffer `lv_chart_set_cache_buf` needs for the current size and series of the chart.
+ * @param obj       pointer to a chart object
+ * @return          the required size in bytes
+ */
+uint32_t lv_chart_get_cache_size(const lv_obj_t * obj);
+
 /*======================
  * Series
  *=====================*/
@@ -11,6 +11,7 @@
 #include "../misc/lv_utils.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_assert.h"
+#include "../core/lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -42,6 +43,8 @@
 
 /**
  * Return with the bitmap of a font.
+ * The bitmap can be in a buffer shared by the threads of a parallel refresh:
+ * hold `lv_refr_lock_shared()` while using it.
  * @param font_p pointer to a font
  * @param letter a UNICODE character code
  * @return pointer to the bitmap of the letter
@@ -49,7 +52,10 @@
 const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t letter)
 {
     LV_ASSERT_NULL(font_p);
-    return font_p->get_glyph_bitmap(font_p, letter);
+    lv_refr_lock_shared();
+    const uint8_t * bitmap = font_p->get_glyph_bitmap(font_p, letter);
+    lv_refr_unlock_shared();
+    return bitmap;
 }
 
 /**
@@ -77,7 +83,10 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
     dsc_out->resolved_font = NULL;
 
     while(f) {
+        /*The fonts' caches are shared by the threads of a parallel refresh*/
+        lv_refr_lock_shared();
         bool found = f->get_glyph_dsc(f, dsc_out, letter, letter_next);
+        lv_refr_unlock_shared();
         if(found) {
             if(!dsc_out->is_placeholder) {
                 dsc_out->resolved_font = f;
@@ -94,7 +103,9 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
 
 #if LV_USE_FONT_PLACEHOLDER
     if(placeholder_font != NULL) {
+        lv_refr_lock_shared();
         placeholder_font->get_glyph_dsc(placeholder_font, dsc_out, letter, letter_next);
+        lv_refr_unlock_shared();
         dsc_out->resolved_font = placeholder_font;
         return true;
     }
@@ -18,6 +18,11 @@
 /*********************
  *      DEFINES
  *********************/
+#if LV_FONT_FMT_TXT_CACHE_SIZE < 1 || (LV_FONT_FMT_TXT_CACHE_SIZE & (LV_FONT_FMT_TXT_CACHE_SIZE - 1))
+    #error "LV_FONT_FMT_TXT_CACHE_SIZE must be a power of 2"
+#endif
+
+#define BITMAP_CACHE (LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE)
 
 /**********************
  *      TYPEDEFS
@@ -28,6 +33,15 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+#if BITMAP_CACHE
+typedef struct _lv_font_fmt_txt_bitmap_cache_entry_t {
+    struct _lv_font_fmt_txt_bitmap_cache_entry_t * next;
+    uint32_t glyph_id;
+    uint32_t size;
+    /*Followed by `size` bytes of decompressed bitmap*/
+} bitmap_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -46,6 +60,10 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static inline uint8_t rle_next(void);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if BITMAP_CACHE
+    static const uint8_t * bitmap_cache_get(lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint32_t size);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -115,6 +133,12 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
+#if BITMAP_CACHE
+        const uint8_t * cached = bitmap_cache_get(fdsc, gid, buf_size);
+        if(cached) return cached;
+#endif
+
+        /*Not cached: decompress into the shared buffer*/
         if(last_buf_size < buf_size) {
             uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
             LV_ASSERT_MALLOC(tmp);
@@ -200,6 +224,22 @@ void _lv_font_clean_up_fmt_txt(void)
         LV_GC_ROOT(_lv_font_decompr_buf) = NULL;
     }
 #endif
+
+#if BITMAP_CACHE
+    lv_font_fmt_txt_glyph_cache_t * cache = LV_GC_ROOT(_lv_font_bitmap_cache_list);
+    while(cache) {
+        lv_font_fmt_txt_glyph_cache_t * next = cache->next;
+        while(cache->bitmaps) {
+            bitmap_cache_entry_t * e = cache->bitmaps;
+            cache->bitmaps = e->next;
+            lv_mem_free(e);
+        }
+        cache->bitmap_size = 0;
+        cache->next = NULL;
+        cache = next;
+    }
+    LV_GC_ROOT(_lv_font_bitmap_cache_list) = NULL;
+#endif
 }
 
 /**********************
@@ -213,7 +253,11 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
     /*Check the cache first*/
-    if(fdsc->cache && letter == fdsc->cache->last_letter) return fdsc->cache->last_glyph_id;
+    lv_font_fmt_txt_glyph_cache_entry_t * ce = NULL;
+    if(fdsc->cache) {
+        ce = &fdsc->cache->glyphs[letter & (LV_FONT_FMT_TXT_CACHE_SIZE - 1)];
+        if(ce->letter == letter) return ce->glyph_id;
+    }
 
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
@@ -252,16 +296,16 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
         }
 
         /*Update the cache*/
-        if(fdsc->cache) {
-            fdsc->cache->last_letter = letter;
-            fdsc->cache->last_glyph_id = glyph_id;
+        if(ce) {
+            ce->letter = letter;
+            ce->glyph_id = glyph_id;
         }
         return glyph_id;
     }
 
-    if(fdsc->cache) {
-        fdsc->cache->last_letter = letter;
-        fdsc->cache->last_glyph_id = 0;
+    if(ce) {
+        ce->letter = letter;
+        ce->glyph_id = 0;
     }
     return 0;
 
@@ -344,6 +388,68 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element)
     else return (int32_t) ref16_p[1] - element16_p[1];
 }
 
+#if BITMAP_CACHE
+/**
+ * Get the decompressed bitmap of a glyph from the font's bitmap cache, decompressing it on a miss.
+ * The least recently used bitmaps are freed to keep the cache in `LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE`.
+ * @param fdsc pointer to a compressed font
+ * @param gid glyph id
+ * @param size size of the decompressed bitmap in bytes
+ * @return the bitmap, valid until the next call for the same font, or NULL if it can't be cached
+ */
+static const uint8_t * bitmap_cache_get(lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint32_t size)
+{
+    lv_font_fmt_txt_glyph_cache_t * cache = fdsc->cache;
+    if(cache == NULL || size > LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE) return NULL;
+
+    /*Hit: move the entry to the front*/
+    bitmap_cache_entry_t ** link = &cache->bitmaps;
+    while(*link) {
+        bitmap_cache_entry_t * e = *link;
+        if(e->glyph_id == gid) {
+            *link = e->next;
+            e->next = cache->bitmaps;
+            cache->bitmaps = e;
+            return (const uint8_t *)(e + 1);
+        }
+        link = &e->next;
+    }
+
+    /*Miss: drop the least recently used bitmaps until the new one fits*/
+    while(cache->bitmaps && cache->bitmap_size + size > LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE) {
+        link = &cache->bitmaps;
+        while((*link)->next) link = &(*link)->next;
+        cache->bitmap_size -= (*link)->size;
+        lv_mem_free(*link);
+        *link = NULL;
+    }
+
+    bitmap_cache_entry_t * e = lv_mem_alloc(sizeof(bitmap_cache_entry_t) + size);
+    if(e == NULL) return NULL;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+    decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], (uint8_t *)(e + 1), gdsc->box_w, gdsc->box_h,
+               (uint8_t)fdsc->bpp, prefilter);
+
+    e->glyph_id = gid;
+    e->size = size;
+    e->next = cache->bitmaps;
+    cache->bitmaps = e;
+    cache->bitmap_size += size;
+
+    /*Remember the cache to free its bitmaps in `_lv_font_clean_up_fmt_txt`*/
+    lv_font_fmt_txt_glyph_cache_t * c = LV_GC_ROOT(_lv_font_bitmap_cache_list);
+    while(c && c != cache) c = c->next;
+    if(c == NULL) {
+        cache->next = LV_GC_ROOT(_lv_font_bitmap_cache_list);
+        LV_GC_ROOT(_lv_font_bitmap_cache_list) = cache;
+    }
+
+    return (const uint8_t *)(e + 1);
+}
+#endif /*BITMAP_CACHE*/
+
 #if LV_USE_FONT_COMPRESSED
 /**
  * The compress a glyph's bitmap
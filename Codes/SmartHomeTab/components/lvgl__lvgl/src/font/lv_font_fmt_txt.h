@@ -152,8 +152,22 @@ typedef enum {
 } lv_font_fmt_txt_bitmap_format_t;
 
 typedef struct {
-    uint32_t last_letter;
-    uint32_t last_glyph_id;
+    uint32_t letter;
+    uint32_t glyph_id;
+} lv_font_fmt_txt_glyph_cache_entry_t;
+
+struct _lv_font_fmt_txt_bitmap_cache_entry_t;
+
+/*Lookup results and decompressed bitmaps of recently drawn letters.
+ *Declared once per font, zero initialized.*/
+typedef struct _lv_font_fmt_txt_glyph_cache_t {
+    /*Direct mapped: a letter can only be in `glyphs[letter % LV_FONT_FMT_TXT_CACHE_SIZE]`*/
+    lv_font_fmt_txt_glyph_cache_entry_t glyphs[LV_FONT_FMT_TXT_CACHE_SIZE];
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+    struct _lv_font_fmt_txt_bitmap_cache_entry_t * bitmaps; /*Most recently used first*/
+    uint32_t bitmap_size;                                   /*Sum of the bitmap sizes*/
+    struct _lv_font_fmt_txt_glyph_cache_t * next;           /*Next cache holding bitmaps*/
+#endif
 } lv_font_fmt_txt_glyph_cache_t;
 
 /*Describe store additional data for fonts*/
@@ -193,7 +207,7 @@ typedef struct {
      */
     uint16_t bitmap_format  : 2;
 
-    /*Cache the last letter and is glyph id*/
+    /*Cache the recent letters, their glyph ids and bitmaps*/
     lv_font_fmt_txt_glyph_cache_t * cache;
 } lv_font_fmt_txt_dsc_t;
 
@@ -319,6 +319,13 @@ void lv_disp_remove(lv_disp_t * disp)
 
     _lv_ll_remove(&LV_GC_ROOT(_lv_disp_ll), disp);
     _lv_ll_clear(&disp->sync_areas);
+#if LV_USE_REFR_PARALLEL
+    for(uint32_t i = 0; i < LV_REFR_PARALLEL_MAX; i++) {
+        if(disp->band_draw_ctx[i] == NULL) continue;
+        disp->driver->draw_ctx_deinit(disp->driver, disp->band_draw_ctx[i]);
+        lv_mem_free(disp->band_draw_ctx[i]);
+    }
+#endif
     if(disp->refr_timer) lv_timer_del(disp->refr_timer);
     lv_mem_free(disp);
 
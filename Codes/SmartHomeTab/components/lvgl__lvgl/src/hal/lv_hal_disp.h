@@ -190,6 +190,11 @@ typedef struct _lv_disp_t {
     /** Double buffer sync areas */
     lv_ll_t sync_areas;
 
+#if LV_USE_REFR_PARALLEL
+    /** Draw contexts of the threads of a parallel refresh, created on its first use*/
+    lv_draw_ctx_t * band_draw_ctx[LV_REFR_PARALLEL_MAX];
+#endif
+
     /*Miscellaneous data*/
     uint32_t last_activity_time;        /**< Last time when there was activity on this display*/
 } lv_disp_t;
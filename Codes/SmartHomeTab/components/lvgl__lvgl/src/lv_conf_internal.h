@@ -412,6 +412,64 @@
     #endif
 #endif
 
+/*Replace the RGB565 fill and map kernels of the software blender with custom (e.g. SIMD) ones.
+ *The header has to define the `LV_DRAW_SW_BLEND_RGB565_...` hooks listed in lv_draw_sw_blend.c*/
+#ifndef LV_USE_DRAW_SW_BLEND_CUSTOM
+    #ifdef CONFIG_LV_USE_DRAW_SW_BLEND_CUSTOM
+        #define LV_USE_DRAW_SW_BLEND_CUSTOM CONFIG_LV_USE_DRAW_SW_BLEND_CUSTOM
+    #else
+        #define LV_USE_DRAW_SW_BLEND_CUSTOM 0
+    #endif
+#endif
+#if LV_USE_DRAW_SW_BLEND_CUSTOM
+    #ifndef LV_DRAW_SW_BLEND_CUSTOM_INCLUDE
+        #ifdef CONFIG_LV_DRAW_SW_BLEND_CUSTOM_INCLUDE
+            #define LV_DRAW_SW_BLEND_CUSTOM_INCLUDE CONFIG_LV_DRAW_SW_BLEND_CUSTOM_INCLUDE
+        #else
+            #define LV_DRAW_SW_BLEND_CUSTOM_INCLUDE "my_blend.h"
+        #endif
+    #endif
+#endif
+
+/*Render the invalidated areas in horizontal bands on several threads at once.
+ *The threads and a lock are given by the port with `lv_refr_set_parallel()`*/
+#ifndef LV_USE_REFR_PARALLEL
+    #ifdef CONFIG_LV_USE_REFR_PARALLEL
+        #define LV_USE_REFR_PARALLEL CONFIG_LV_USE_REFR_PARALLEL
+    #else
+        #define LV_USE_REFR_PARALLEL 0
+    #endif
+#endif
+#if LV_USE_REFR_PARALLEL
+    /*Most bands (threads) an area is split to. Every thread has about 1 kB of scratch state in RAM*/
+    #ifndef LV_REFR_PARALLEL_MAX
+        #ifdef CONFIG_LV_REFR_PARALLEL_MAX
+            #define LV_REFR_PARALLEL_MAX CONFIG_LV_REFR_PARALLEL_MAX
+        #else
+            #define LV_REFR_PARALLEL_MAX 4
+        #endif
+    #endif
+
+    /*Smallest band height in rows. Lower areas are rendered by the calling thread alone*/
+    #ifndef LV_REFR_PARALLEL_MIN_ROWS
+        #ifdef CONFIG_LV_REFR_PARALLEL_MIN_ROWS
+            #define LV_REFR_PARALLEL_MIN_ROWS CONFIG_LV_REFR_PARALLEL_MIN_ROWS
+        #else
+            #define LV_REFR_PARALLEL_MIN_ROWS 32
+        #endif
+    #endif
+#endif
+
+/*Cache the style properties resolved for an object in its current state, in a table of this many entries.
+ *Allocated for the objects drawn, about 8 bytes per entry. Must be a power of 2. 0: no caching*/
+#ifndef LV_OBJ_STYLE_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+        #define LV_OBJ_STYLE_CACHE_SIZE CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+    #else
+        #define LV_OBJ_STYLE_CACHE_SIZE 16
+    #endif
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -1229,6 +1287,25 @@
     #endif
 #endif
 
+/*Number of letter -> glyph id pairs remembered per font. Must be a power of 2.*/
+#ifndef LV_FONT_FMT_TXT_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_CACHE_SIZE 16
+    #endif
+#endif
+
+/*Bytes of decompressed glyph bitmaps kept per compressed font (least recently used first out).
+ *0: decompress the glyph on every draw*/
+#ifndef LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE 4096
+    #endif
+#endif
+
 /*Enable subpixel rendering*/
 #ifndef LV_USE_FONT_SUBPX
     #ifdef CONFIG_LV_USE_FONT_SUBPX
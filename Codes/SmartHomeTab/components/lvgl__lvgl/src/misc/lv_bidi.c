@@ -31,6 +31,12 @@ typedef struct {
     lv_base_dir_t dir;
 } bracket_stack_t;
 
+/*The brackets open in a paragraph, on the stack of the thread processing it*/
+typedef struct {
+    bracket_stack_t stack[LV_BIDI_BRACKLET_DEPTH];
+    uint8_t cnt;
+} brackets_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -41,13 +47,13 @@ static bool lv_bidi_letter_is_weak(uint32_t letter);
 static bool lv_bidi_letter_is_rtl(uint32_t letter);
 static bool lv_bidi_letter_is_neutral(uint32_t letter);
 
-static lv_base_dir_t get_next_run(const char * txt, lv_base_dir_t base_dir, uint32_t max_len, uint32_t * len,
-                                  uint16_t  * pos_conv_len);
+static lv_base_dir_t get_next_run(brackets_t * br, const char * txt, lv_base_dir_t base_dir, uint32_t max_len,
+                                  uint32_t * len, uint16_t  * pos_conv_len);
 static void rtl_reverse(char * dest, const char * src, uint32_t len, uint16_t * pos_conv_out, uint16_t pos_conv_rd_base,
                         uint16_t pos_conv_len);
 static uint32_t char_change_to_pair(uint32_t letter);
-static lv_base_dir_t bracket_process(const char * txt, uint32_t next_pos, uint32_t len, uint32_t letter,
-                                     lv_base_dir_t base_dir);
+static lv_base_dir_t bracket_process(brackets_t * br, const char * txt, uint32_t next_pos, uint32_t len,
+                                     uint32_t letter, lv_base_dir_t base_dir);
 static void fill_pos_conv(uint16_t * out, uint16_t len, uint16_t index);
 static uint32_t get_txt_len(const char * txt, uint32_t max_len);
 
@@ -56,8 +62,6 @@ static uint32_t get_txt_len(const char * txt, uint32_t max_len);
  **********************/
 static const uint8_t bracket_left[] = {"<({["};
 static const uint8_t bracket_right[] = {">)}]"};
-static bracket_stack_t br_stack[LV_BIDI_BRACKLET_DEPTH];
-static uint8_t br_stack_p;
 
 /**********************
  *      MACROS
@@ -239,14 +243,15 @@ void _lv_bidi_process_paragraph(const char * str_in, char * str_out, uint32_t le
     lv_base_dir_t dir = base_dir;
 
     /*Empty the bracket stack*/
-    br_stack_p = 0;
+    brackets_t br;
+    br.cnt = 0;
 
     /*Process neutral chars in the beginning*/
     while(rd < len) {
         uint32_t letter = _lv_txt_encoded_next(str_in, &rd);
         pos_conv_rd++;
         dir = lv_bidi_get_letter_dir(letter);
-        if(dir == LV_BASE_DIR_NEUTRAL)  dir = bracket_process(str_in, rd, len, letter, base_dir);
+        if(dir == LV_BASE_DIR_NEUTRAL)  dir = bracket_process(&br, str_in, rd, len, letter, base_dir);
         if(dir != LV_BASE_DIR_NEUTRAL && dir != LV_BASE_DIR_WEAK) break;
     }
 
@@ -277,7 +282,7 @@ void _lv_bidi_process_paragraph(const char * str_in, char * str_out, uint32_t le
     /*Get and process the runs*/
 
     while(rd < len && str_in[rd]) {
-        run_dir = get_next_run(&str_in[rd], base_dir, len - rd, &run_len, &pos_conv_run_len);
+        run_dir = get_next_run(&br, &str_in[rd], base_dir, len - rd, &run_len, &pos_conv_run_len);
 
         if(base_dir == LV_BASE_DIR_LTR) {
             if(run_dir == LV_BASE_DIR_LTR) {
@@ -428,8 +433,8 @@ static void fill_pos_conv(uint16_t * out, uint16_t len, uint16_t index)
     }
 }
 
-static lv_base_dir_t get_next_run(const char * txt, lv_base_dir_t base_dir, uint32_t max_len, uint32_t * len,
-                                  uint16_t  * pos_conv_len)
+static lv_base_dir_t get_next_run(brackets_t * br, const char * txt, lv_base_dir_t base_dir, uint32_t max_len,
+                                  uint32_t * len, uint16_t  * pos_conv_len)
 {
     uint32_t i = 0;
     uint32_t letter;
@@ -438,7 +443,7 @@ static lv_base_dir_t get_next_run(const char * txt, lv_base_dir_t base_dir, uint
 
     letter = _lv_txt_encoded_next(txt, NULL);
     lv_base_dir_t dir = lv_bidi_get_letter_dir(letter);
-    if(dir == LV_BASE_DIR_NEUTRAL)  dir = bracket_process(txt, 0, max_len, letter, base_dir);
+    if(dir == LV_BASE_DIR_NEUTRAL)  dir = bracket_process(br, txt, 0, max_len, letter, base_dir);
 
     /*Find the first strong char. Skip the neutrals*/
     while(dir == LV_BASE_DIR_NEUTRAL || dir == LV_BASE_DIR_WEAK) {
@@ -446,7 +451,7 @@ static lv_base_dir_t get_next_run(const char * txt, lv_base_dir_t base_dir, uint
 
         pos_conv_i++;
         dir = lv_bidi_get_letter_dir(letter);
-        if(dir == LV_BASE_DIR_NEUTRAL)  dir = bracket_process(txt, i, max_len, letter, base_dir);
+        if(dir == LV_BASE_DIR_NEUTRAL)  dir = bracket_process(br, txt, i, max_len, letter, base_dir);
 
         if(dir == LV_BASE_DIR_LTR || dir == LV_BASE_DIR_RTL)  break;
 
@@ -470,7 +475,7 @@ static lv_base_dir_t get_next_run(const char * txt, lv_base_dir_t base_dir, uint
         letter = _lv_txt_encoded_next(txt, &i);
         pos_conv_i++;
         next_dir  = lv_bidi_get_letter_dir(letter);
-        if(next_dir == LV_BASE_DIR_NEUTRAL)  next_dir = bracket_process(txt, i, max_len, letter, base_dir);
+        if(next_dir == LV_BASE_DIR_NEUTRAL)  next_dir = bracket_process(br, txt, i, max_len, letter, base_dir);
 
         if(next_dir == LV_BASE_DIR_WEAK) {
             if(run_dir == LV_BASE_DIR_RTL) {
@@ -604,8 +609,8 @@ static uint32_t char_change_to_pair(uint32_t letter)
     return letter;
 }
 
-static lv_base_dir_t bracket_process(const char * txt, uint32_t next_pos, uint32_t len, uint32_t letter,
-                                     lv_base_dir_t base_dir)
+static lv_base_dir_t bracket_process(brackets_t * br, const char * txt, uint32_t next_pos, uint32_t len,
+                                     uint32_t letter, lv_base_dir_t base_dir)
 {
     lv_base_dir_t bracket_dir = LV_BASE_DIR_NEUTRAL;
 
@@ -662,19 +667,19 @@ static lv_base_dir_t bracket_process(const char * txt, uint32_t next_pos, uint32
     /*The letter was an opening bracket*/
     if(bracket_left[i] != '\0') {
 
-        if(bracket_dir == LV_BASE_DIR_NEUTRAL || br_stack_p == LV_BIDI_BRACKLET_DEPTH) return LV_BASE_DIR_NEUTRAL;
+        if(bracket_dir == LV_BASE_DIR_NEUTRAL || br->cnt == LV_BIDI_BRACKLET_DEPTH) return LV_BASE_DIR_NEUTRAL;
 
-        br_stack[br_stack_p].bracklet_pos = i;
-        br_stack[br_stack_p].dir = bracket_dir;
+        br->stack[br->cnt].bracklet_pos = i;
+        br->stack[br->cnt].dir = bracket_dir;
 
-        br_stack_p++;
+        br->cnt++;
         return bracket_dir;
     }
-    else if(br_stack_p > 0) {
+    else if(br->cnt > 0) {
         /*Is the letter a closing bracket of the last opening?*/
-        if(letter == bracket_right[br_stack[br_stack_p - 1].bracklet_pos]) {
-            bracket_dir = br_stack[br_stack_p - 1].dir;
-            br_stack_p--;
+        if(letter == bracket_right[br->stack[br->cnt - 1].bracklet_pos]) {
+            bracket_dir = br->stack[br->cnt - 1].dir;
+            br->cnt--;
             return bracket_dir;
         }
     }
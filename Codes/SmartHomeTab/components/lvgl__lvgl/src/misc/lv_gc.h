@@ -40,8 +40,25 @@ extern "C" {
 #define LV_DISPATCH10(f, t, n)
 #define LV_DISPATCH11(f, t, n)          LV_DISPATCH(f, t, n)
 
+/*Scratch state of the renderer. The `_lv_scratch` root is the LVGL task's; with LV_USE_REFR_PARALLEL
+ *every thread of a parallel refresh has one more while it draws. Use it through `_lv_scratch_get()`.*/
+typedef struct {
+    lv_mem_buf_arr_t mem_buf;
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_radius_circle_dsc_arr_t circle_cache;
+    _lv_draw_mask_saved_arr_t mask_list;
+#endif
+    struct _lv_event_t * event_head;        /*The events being sent*/
+    const struct _lv_obj_t * draw_in_obj;   /*See `_lv_obj_event_base_draw_in()`*/
+    const lv_area_t * draw_in_coords;
+    lv_opa_t letter_opa_table[256];         /*Glyph opacities scaled by `letter_opa`*/
+    lv_opa_t letter_opa;
+    uint8_t letter_bpp;
+} _lv_scratch_t;
+
 #define LV_ITERATE_ROOTS(f)                                                                            \
     LV_DISPATCH(f, lv_ll_t, _lv_timer_ll) /*Linked list to store the lv_timers*/                       \
+    LV_DISPATCH(f, lv_timer_t **, _lv_timer_heap) /*The running timers, a min-heap of their deadlines*/ \
     LV_DISPATCH(f, lv_ll_t, _lv_disp_ll)  /*Linked list of display device*/                            \
     LV_DISPATCH(f, lv_ll_t, _lv_indev_ll) /*Linked list of input device*/                              \
     LV_DISPATCH(f, lv_ll_t, _lv_fsdrv_ll)                                                              \
@@ -53,12 +70,11 @@ extern "C" {
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)              \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)              \
     LV_DISPATCH(f, lv_timer_t*, _lv_timer_act)                                                         \
-    LV_DISPATCH(f, lv_mem_buf_arr_t , lv_mem_buf)                                                      \
-    LV_DISPATCH_COND(f, _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1)  \
-    LV_DISPATCH_COND(f, _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)            \
+    LV_DISPATCH(f, _lv_scratch_t, _lv_scratch)                                                         \
     LV_DISPATCH(f, void * , _lv_theme_default_styles)                                                  \
     LV_DISPATCH(f, void * , _lv_theme_basic_styles)                                                  \
     LV_DISPATCH_COND(f, uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)                    \
+    LV_DISPATCH_COND(f, void *, _lv_font_bitmap_cache_list, LV_USE_FONT_COMPRESSED, 1)                 \
     LV_DISPATCH(f, uint8_t * , _lv_grad_cache_mem)                                                     \
     LV_DISPATCH(f, uint8_t * , _lv_style_custom_prop_flag_lookup_table)
 
@@ -69,6 +85,9 @@ extern "C" {
 #if LV_MEM_CUSTOM != 1
 #error "GC requires CUSTOM_MEM"
 #endif /*LV_MEM_CUSTOM*/
+#if LV_USE_REFR_PARALLEL
+#error "GC can't scan the scratch state of the threads of LV_USE_REFR_PARALLEL"
+#endif /*LV_USE_REFR_PARALLEL*/
 #include LV_GC_INCLUDE
 #else  /*LV_ENABLE_GC*/
 #define LV_GC_ROOT(x) x
@@ -86,6 +105,16 @@ LV_ITERATE_ROOTS(LV_EXTERN_ROOT)
 
 void _lv_gc_clear_roots(void);
 
+#if LV_USE_REFR_PARALLEL
+/**
+ * Get the scratch state of the calling thread
+ * @return  the state of the worker while the threads of a parallel refresh run, else the `_lv_scratch` root
+ */
+_lv_scratch_t * _lv_scratch_get(void);
+#else
+#define _lv_scratch_get() (&LV_GC_ROOT(_lv_scratch))
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -12,6 +12,7 @@
 #include "lv_gc.h"
 #include "lv_assert.h"
 #include "lv_log.h"
+#include "../core/lv_refr.h"
 
 #if LV_MEM_CUSTOM != 0
     #include LV_MEM_CUSTOM_INCLUDE
@@ -130,6 +131,9 @@ void * lv_mem_alloc(size_t size)
         return &zero_mem;
     }
 
+    /*The threads of a parallel refresh allocate too*/
+    lv_refr_lock_shared();
+
 #if LV_MEM_CUSTOM == 0
     void * alloc = lv_tlsf_malloc(tlsf, size);
 #else
@@ -159,6 +163,7 @@ void * lv_mem_alloc(size_t size)
 #endif
         MEM_TRACE("allocated at %p", alloc);
     }
+    lv_refr_unlock_shared();
     return alloc;
 }
 
@@ -172,6 +177,7 @@ void lv_mem_free(void * data)
     if(data == &zero_mem) return;
     if(data == NULL) return;
 
+    lv_refr_lock_shared();
 #if LV_MEM_CUSTOM == 0
 #  if LV_MEM_ADD_JUNK
     lv_memset(data, 0xbb, lv_tlsf_block_size(data));
@@ -182,6 +188,7 @@ void lv_mem_free(void * data)
 #else
     LV_MEM_CUSTOM_FREE(data);
 #endif
+    lv_refr_unlock_shared();
 }
 
 /**
@@ -202,11 +209,13 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
 
     if(data_p == &zero_mem) return lv_mem_alloc(new_size);
 
+    lv_refr_lock_shared();
 #if LV_MEM_CUSTOM == 0
     void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
 #else
     void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
 #endif
+    lv_refr_unlock_shared();
     if(new_p == NULL) {
         LV_LOG_ERROR("couldn't allocate memory");
         return NULL;
@@ -250,7 +259,10 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #if LV_MEM_CUSTOM == 0
     MEM_TRACE("begin");
 
+    lv_refr_lock_shared();
     lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
+    mon_p->max_used = max_used;
+    lv_refr_unlock_shared();
 
     mon_p->total_size = LV_MEM_SIZE;
     mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
@@ -262,8 +274,6 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
         mon_p->frag_pct = 0; /*no fragmentation if all the RAM is used*/
     }
 
-    mon_p->max_used = max_used;
-
     MEM_TRACE("finished");
 #endif
 }
@@ -278,44 +288,46 @@ void * lv_mem_buf_get(uint32_t size)
 
     MEM_TRACE("begin, getting %d bytes", size);
 
+    lv_mem_buf_t * bufs = _lv_scratch_get()->mem_buf;
+
     /*Try to find a free buffer with suitable size*/
     int8_t i_guess = -1;
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).used == 0 && LV_GC_ROOT(lv_mem_buf[i]).size >= size) {
-            if(LV_GC_ROOT(lv_mem_buf[i]).size == size) {
-                LV_GC_ROOT(lv_mem_buf[i]).used = 1;
-                return LV_GC_ROOT(lv_mem_buf[i]).p;
+        if(bufs[i].used == 0 && bufs[i].size >= size) {
+            if(bufs[i].size == size) {
+                bufs[i].used = 1;
+                return bufs[i].p;
             }
             else if(i_guess < 0) {
                 i_guess = i;
             }
             /*If size of `i` is closer to `size` prefer it*/
-            else if(LV_GC_ROOT(lv_mem_buf[i]).size < LV_GC_ROOT(lv_mem_buf[i_guess]).size) {
+            else if(bufs[i].size < bufs[i_guess].size) {
                 i_guess = i;
             }
         }
     }
 
     if(i_guess >= 0) {
-        LV_GC_ROOT(lv_mem_buf[i_guess]).used = 1;
+        bufs[i_guess].used = 1;
         MEM_TRACE("returning already allocated buffer (buffer id: %d, address: %p)", i_guess,
-                  LV_GC_ROOT(lv_mem_buf[i_guess]).p);
-        return LV_GC_ROOT(lv_mem_buf[i_guess]).p;
+                  bufs[i_guess].p);
+        return bufs[i_guess].p;
     }
 
     /*Reallocate a free buffer*/
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).used == 0) {
+        if(bufs[i].used == 0) {
             /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
-            void * buf = lv_mem_realloc(LV_GC_ROOT(lv_mem_buf[i]).p, size);
+            void * buf = lv_mem_realloc(bufs[i].p, size);
             LV_ASSERT_MSG(buf != NULL, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)");
             if(buf == NULL) return NULL;
 
-            LV_GC_ROOT(lv_mem_buf[i]).used = 1;
-            LV_GC_ROOT(lv_mem_buf[i]).size = size;
-            LV_GC_ROOT(lv_mem_buf[i]).p    = buf;
-            MEM_TRACE("allocated (buffer id: %d, address: %p)", i, LV_GC_ROOT(lv_mem_buf[i]).p);
-            return LV_GC_ROOT(lv_mem_buf[i]).p;
+            bufs[i].used = 1;
+            bufs[i].size = size;
+            bufs[i].p    = buf;
+            MEM_TRACE("allocated (buffer id: %d, address: %p)", i, bufs[i].p);
+            return bufs[i].p;
         }
     }
 
@@ -332,9 +344,10 @@ void lv_mem_buf_release(void * p)
 {
     MEM_TRACE("begin (address: %p)", p);
 
+    lv_mem_buf_t * bufs = _lv_scratch_get()->mem_buf;
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).p == p) {
-            LV_GC_ROOT(lv_mem_buf[i]).used = 0;
+        if(bufs[i].p == p) {
+            bufs[i].used = 0;
             return;
         }
     }
@@ -347,12 +360,13 @@ void lv_mem_buf_release(void * p)
  */
 void lv_mem_buf_free_all(void)
 {
+    lv_mem_buf_t * bufs = _lv_scratch_get()->mem_buf;
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).p) {
-            lv_mem_free(LV_GC_ROOT(lv_mem_buf[i]).p);
-            LV_GC_ROOT(lv_mem_buf[i]).p = NULL;
-            LV_GC_ROOT(lv_mem_buf[i]).used = 0;
-            LV_GC_ROOT(lv_mem_buf[i]).size = 0;
+        if(bufs[i].p) {
+            lv_mem_free(bufs[i].p);
+            bufs[i].p = NULL;
+            bufs[i].used = 0;
+            bufs[i].size = 0;
         }
     }
 }
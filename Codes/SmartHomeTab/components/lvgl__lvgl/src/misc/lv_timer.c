@@ -17,6 +17,8 @@
  *********************/
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_IDX_NONE   UINT32_MAX  /*`heap_idx` of the paused timers*/
+#define HEAP_MIN_SIZE   8
 
 /**********************
  *      TYPEDEFS
@@ -27,14 +29,22 @@
  **********************/
 static bool lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static bool heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_update(lv_timer_t * timer);
+static bool heap_before(const lv_timer_t * a, const lv_timer_t * b);
+static void heap_set(uint32_t idx, lv_timer_t * timer);
+static void heap_sift_up(uint32_t idx);
+static void heap_sift_down(uint32_t idx);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
-static bool timer_deleted;
-static bool timer_created;
+static uint32_t heap_cnt;       /*Timers in `_lv_timer_heap`*/
+static uint32_t heap_size;      /*Allocated places in `_lv_timer_heap`*/
+static uint32_t handler_run;    /*Incremented in every `lv_timer_handler` call*/
 
 /**********************
  *      MACROS
@@ -55,6 +65,9 @@ static bool timer_created;
 void _lv_timer_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+    LV_GC_ROOT(_lv_timer_heap) = NULL;
+    heap_cnt = 0;
+    heap_size = 0;
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
@@ -95,40 +108,18 @@ uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    do {
-        timer_deleted             = false;
-        timer_created             = false;
-        LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-        while(LV_GC_ROOT(_lv_timer_act)) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
-
-            if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(timer_created || timer_deleted) {
-                    TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
-        }
-    } while(LV_GC_ROOT(_lv_timer_act));
-
-    uint32_t time_till_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_till_next)
-                time_till_next = delay;
-        }
-
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
+    /*Run the due timers in the order of their deadlines, each at most once.
+     *Timers created, deleted or rescheduled by the callbacks are placed in the heap right away.*/
+    handler_run++;
+    while(heap_cnt > 0) {
+        lv_timer_t * timer = LV_GC_ROOT(_lv_timer_heap)[0];
+        if(timer->handler_run == handler_run) break;    /*A timer with 0 period which ran already*/
+        if(lv_timer_time_remaining(timer) > 0) break;
+        lv_timer_exec(timer);
     }
+    LV_GC_ROOT(_lv_timer_act) = NULL;
+
+    uint32_t time_till_next = lv_timer_get_time_till_next();
 
     busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
@@ -178,8 +169,13 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->paused = 0;
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
+    new_timer->handler_run = handler_run - 1;
 
-    timer_created = true;
+    if(!heap_insert(new_timer)) {
+        _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), new_timer);
+        lv_mem_free(new_timer);
+        return NULL;
+    }
 
     return new_timer;
 }
@@ -200,8 +196,9 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
  */
 void lv_timer_del(lv_timer_t * timer)
 {
+    heap_remove(timer);
     _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), timer);
-    timer_deleted = true;
+    if(LV_GC_ROOT(_lv_timer_act) == timer) LV_GC_ROOT(_lv_timer_act) = NULL;   /*Deleted in its callback*/
 
     lv_mem_free(timer);
 }
@@ -212,11 +209,15 @@ void lv_timer_del(lv_timer_t * timer)
  */
 void lv_timer_pause(lv_timer_t * timer)
 {
+    if(timer->paused) return;
     timer->paused = true;
+    heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
+    if(!timer->paused) return;
+    if(!heap_insert(timer)) return;    /*Stays paused*/
     timer->paused = false;
 }
 
@@ -228,6 +229,7 @@ void lv_timer_resume(lv_timer_t * timer)
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     timer->period = period;
+    heap_update(timer);
 }
 
 /**
@@ -237,6 +239,7 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 void lv_timer_ready(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get() - timer->period - 1;
+    heap_update(timer);
 }
 
 /**
@@ -257,6 +260,7 @@ void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 void lv_timer_reset(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get();
+    heap_update(timer);
 }
 
 /**
@@ -277,6 +281,12 @@ uint8_t lv_timer_get_idle(void)
     return idle_last;
 }
 
+uint32_t lv_timer_get_time_till_next(void)
+{
+    if(heap_cnt == 0) return LV_NO_TIMER_READY;
+    return lv_timer_time_remaining(LV_GC_ROOT(_lv_timer_heap)[0]);
+}
+
 /**
  * Iterate through the timers
  * @param timer NULL to start iteration or the previous return value to get the next timer
@@ -301,14 +311,17 @@ static bool lv_timer_exec(lv_timer_t * timer)
 {
     if(timer->paused) return false;
 
+    LV_GC_ROOT(_lv_timer_act) = timer;
     bool exec = false;
     if(lv_timer_time_remaining(timer) == 0) {
         /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
+         * Schedule the next run before too as the callback might reschedule or delete the timer*/
         int32_t original_repeat_count = timer->repeat_count;
         if(timer->repeat_count > 0) timer->repeat_count--;
         timer->last_run = lv_tick_get();
+        timer->handler_run = handler_run;
+        heap_update(timer);
+
         TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
         if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
         TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
@@ -316,7 +329,7 @@ static bool lv_timer_exec(lv_timer_t * timer)
         exec = true;
     }
 
-    if(timer_deleted == false) { /*The timer might be deleted by itself as well*/
+    if(LV_GC_ROOT(_lv_timer_act) == timer) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             TIMER_TRACE("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
             lv_timer_del(timer);
@@ -339,3 +352,108 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
         return 0;
     return timer->period - elp;
 }
+
+/**
+ * Add a timer to the deadline heap
+ * @param timer pointer to lv_timer, not in the heap
+ * @return false: out of memory
+ */
+static bool heap_insert(lv_timer_t * timer)
+{
+    if(heap_cnt == heap_size) {
+        uint32_t new_size = heap_size ? heap_size * 2 : HEAP_MIN_SIZE;
+        lv_timer_t ** new_heap = lv_mem_realloc(LV_GC_ROOT(_lv_timer_heap), new_size * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_heap);
+        if(new_heap == NULL) {
+            timer->heap_idx = HEAP_IDX_NONE;
+            return false;
+        }
+        LV_GC_ROOT(_lv_timer_heap) = new_heap;
+        heap_size = new_size;
+    }
+
+    heap_set(heap_cnt, timer);
+    heap_cnt++;
+    heap_sift_up(timer->heap_idx);
+    return true;
+}
+
+/**
+ * Remove a timer from the deadline heap
+ * @param timer pointer to lv_timer, in the heap or not
+ */
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t idx = timer->heap_idx;
+    if(idx == HEAP_IDX_NONE) return;
+
+    timer->heap_idx = HEAP_IDX_NONE;
+    heap_cnt--;
+    if(idx == heap_cnt) return;
+
+    /*Move the last timer to the hole, then to its place*/
+    lv_timer_t * last = LV_GC_ROOT(_lv_timer_heap)[heap_cnt];
+    heap_set(idx, last);
+    heap_update(last);
+}
+
+/**
+ * Move a timer to its place in the heap after its deadline changed
+ * @param timer pointer to lv_timer, in the heap or not
+ */
+static void heap_update(lv_timer_t * timer)
+{
+    uint32_t idx = timer->heap_idx;
+    if(idx == HEAP_IDX_NONE) return;
+
+    heap_sift_up(idx);
+    heap_sift_down(timer->heap_idx);
+}
+
+/**
+ * Tell if a timer is due before an other. Deadlines are compared with the tick wrapping around,
+ * so they have to be closer than 2^31 ms (~24 days).
+ * @param a pointer to lv_timer
+ * @param b pointer to lv_timer
+ * @return true: `a` is due first
+ */
+static bool heap_before(const lv_timer_t * a, const lv_timer_t * b)
+{
+    uint32_t deadline_a = a->last_run + a->period;
+    uint32_t deadline_b = b->last_run + b->period;
+    return (int32_t)(deadline_a - deadline_b) < 0;
+}
+
+static void heap_set(uint32_t idx, lv_timer_t * timer)
+{
+    LV_GC_ROOT(_lv_timer_heap)[idx] = timer;
+    timer->heap_idx = idx;
+}
+
+static void heap_sift_up(uint32_t idx)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[idx];
+    while(idx > 0) {
+        uint32_t parent = (idx - 1) / 2;
+        if(!heap_before(timer, heap[parent])) break;
+        heap_set(idx, heap[parent]);
+        idx = parent;
+    }
+    heap_set(idx, timer);
+}
+
+static void heap_sift_down(uint32_t idx)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[idx];
+    while(1) {
+        uint32_t child = idx * 2 + 1;
+        if(child >= heap_cnt) break;
+        if(child + 1 < heap_cnt && heap_before(heap[child + 1], heap[child])) child++;
+        if(!heap_before(heap[child], timer)) break;
+        heap_set(idx, heap[child]);
+        idx = child;
+    }
+    heap_set(idx, timer);
+}
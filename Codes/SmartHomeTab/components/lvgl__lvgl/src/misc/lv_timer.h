@@ -48,6 +48,8 @@ typedef struct _lv_timer_t {
     void * user_data; /**< Custom user data*/
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
     uint32_t paused : 1;
+    uint32_t heap_idx; /**< Position in the deadline heap (internal)*/
+    uint32_t handler_run; /**< The `lv_timer_handler` call it last ran in (internal)*/
 } lv_timer_t;
 
 /**********************
@@ -165,6 +167,14 @@ void lv_timer_enable(bool en);
  */
 uint8_t lv_timer_get_idle(void);
 
+/**
+ * Get the time until the next timer is due, without running any timer.
+ * A tickless port can sleep this long after another thread created, resumed or reset a timer.
+ * @return the time until the first not paused timer is due (0 if it's late) or
+ *         `LV_NO_TIMER_READY` if there are no such timers
+ */
+uint32_t lv_timer_get_time_till_next(void);
+
 /**
  * Iterate through the timers
  * @param timer NULL to start iteration or the previous return value to get the next timer
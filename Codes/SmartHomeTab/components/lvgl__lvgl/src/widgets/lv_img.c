@@ -597,15 +597,10 @@ static void draw_img(lv_event_t * e)
             bg_coords.y2 += obj->coords.y1;
         }
 
-        lv_area_t ori_coords;
-        lv_area_copy(&ori_coords, &obj->coords);
-        lv_area_copy(&obj->coords, &bg_coords);
-
-        lv_res_t res = lv_obj_event_base(MY_CLASS, e);
+        /*Let `lv_obj` draw the background there*/
+        lv_res_t res = _lv_obj_event_base_draw_in(MY_CLASS, e, &bg_coords);
         if(res != LV_RES_OK) return;
 
-        lv_area_copy(&obj->coords, &ori_coords);
-
         if(code == LV_EVENT_DRAW_MAIN) {
             if(img->h == 0 || img->w == 0) return;
             if(img->zoom == 0) return;
@@ -0,0 +1,190 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <string.h>
+
+#define CHART_W     200
+#define CHART_H     120
+#define POINT_CNT   21      /*The points are 10 px apart so the cached planes scroll exactly*/
+#define UNEVEN_CNT  14      /*200 / 13 px apart: the scrolled segments are off by 1 px until a window scrolled*/
+
+extern lv_color_t test_fb[];
+
+static lv_color_t cached_fb[800 * 480];
+static lv_opa_t cache_buf[2 * CHART_W * CHART_H];
+
+static lv_obj_t * chart;
+static lv_chart_series_t * ser1;
+static lv_chart_series_t * ser2;
+
+static void create_chart(void)
+{
+    chart = lv_chart_create(lv_scr_act());
+    lv_obj_set_size(chart, CHART_W, CHART_H);
+    lv_obj_set_pos(chart, 50, 50);
+    lv_obj_set_style_pad_all(chart, 0, 0);
+    lv_obj_set_style_border_width(chart, 0, 0);
+    lv_obj_set_style_line_width(chart, 3, LV_PART_ITEMS);
+    lv_chart_set_point_count(chart, POINT_CNT);
+    ser1 = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_RED), LV_CHART_AXIS_PRIMARY_Y);
+    ser2 = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_BLUE), LV_CHART_AXIS_PRIMARY_Y);
+    lv_obj_update_layout(chart);
+}
+
+static void append(uint32_t cnt)
+{
+    static uint32_t seq;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        seq++;
+        lv_chart_set_next_value(chart, ser1, (lv_coord_t)((seq * 37) % 100));
+        lv_chart_set_next_value(chart, ser2, (lv_coord_t)((seq * 53 + 20) % 100));
+    }
+}
+
+static void refr_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Draw the lines directly and compare with what was drawn from the planes. They are
+ *blended from rounded opacities, so allow a little difference.*/
+static void assert_cached_like_direct(void)
+{
+    refr_screen();
+    memcpy(cached_fb, test_fb, sizeof(cached_fb));
+    lv_chart_set_cache_buf(chart, NULL, 0);
+    refr_screen();
+
+    uint32_t i;
+    for(i = 0; i < 800 * 480; i++) {
+        lv_color32_t a, b;
+        a.full = lv_color_to32(cached_fb[i]);
+        b.full = lv_color_to32(test_fb[i]);
+        TEST_ASSERT_INT_WITHIN(4, LV_COLOR_GET_R32(b), LV_COLOR_GET_R32(a));
+        TEST_ASSERT_INT_WITHIN(4, LV_COLOR_GET_G32(b), LV_COLOR_GET_G32(a));
+        TEST_ASSERT_INT_WITHIN(4, LV_COLOR_GET_B32(b), LV_COLOR_GET_B32(a));
+    }
+}
+
+void setUp(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_chart_cache_size(void)
+{
+    create_chart();
+    TEST_ASSERT_EQUAL_UINT32(2 * CHART_W * CHART_H, lv_chart_get_cache_size(chart));
+}
+
+void test_chart_cache_draws_like_direct(void)
+{
+    create_chart();
+    lv_chart_set_cache_buf(chart, cache_buf, sizeof(cache_buf));
+
+    /*Draw the planes in full and then append one by one, more than a full scroll*/
+    append(1);
+    refr_screen();
+    append(POINT_CNT + 7);
+    TEST_ASSERT_TRUE(((lv_chart_t *)chart)->cache_valid);
+    assert_cached_like_direct();
+}
+
+void test_chart_cache_appends_like_fresh_draw(void)
+{
+    create_chart();
+    lv_chart_set_point_count(chart, UNEVEN_CNT);
+    lv_chart_set_cache_buf(chart, cache_buf, sizeof(cache_buf));
+
+    /*The planes are drawn in full on the first append and again after every UNEVEN_CNT - 1*/
+    append(1);
+    refr_screen();
+    append(2 * (UNEVEN_CNT - 1));
+    TEST_ASSERT_TRUE(((lv_chart_t *)chart)->cache_valid);
+    assert_cached_like_direct();
+}
+
+void test_chart_cache_invalidates_only_the_plot(void)
+{
+    create_chart();
+    lv_obj_set_style_pad_all(chart, 20, 0);
+    lv_obj_update_layout(chart);
+    lv_chart_set_cache_buf(chart, cache_buf, sizeof(cache_buf));
+    append(1);
+    lv_refr_now(NULL);
+
+    append(1);
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_area_t plot_area;
+    lv_obj_get_content_coords(chart, &plot_area);
+    lv_coord_t ext = lv_obj_get_style_line_width(chart, LV_PART_ITEMS) + lv_obj_get_style_width(chart, LV_PART_INDICATOR);
+    lv_area_increase(&plot_area, ext, ext);
+    lv_obj_get_transformed_area(chart, &plot_area, true, false);    /*Adds the margin of invalidated areas*/
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_TRUE(_lv_area_is_in(&disp->inv_areas[0], &plot_area, 0));
+    TEST_ASSERT_LESS_THAN(lv_area_get_size(&chart->coords), lv_area_get_size(&disp->inv_areas[0]));
+}
+
+void test_chart_cache_redraws_changed_point(void)
+{
+    create_chart();
+    lv_chart_set_cache_buf(chart, cache_buf, sizeof(cache_buf));
+    append(POINT_CNT);
+
+    lv_chart_set_value_by_id(chart, ser1, (ser1->start_point + 5) % POINT_CNT, 90);
+    TEST_ASSERT_TRUE(((lv_chart_t *)chart)->cache_valid);
+    assert_cached_like_direct();
+}
+
+void test_chart_cache_dropped_on_change(void)
+{
+    create_chart();
+    lv_chart_set_cache_buf(chart, cache_buf, sizeof(cache_buf));
+    append(3);
+    TEST_ASSERT_TRUE(((lv_chart_t *)chart)->cache_valid);
+
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 200);
+    TEST_ASSERT_FALSE(((lv_chart_t *)chart)->cache_valid);
+
+    append(1);
+    TEST_ASSERT_TRUE(((lv_chart_t *)chart)->cache_valid);
+    lv_obj_set_width(chart, CHART_W - 10);
+    lv_obj_update_layout(chart);
+    TEST_ASSERT_FALSE(((lv_chart_t *)chart)->cache_valid);
+}
+
+void test_chart_cache_follows_style_change(void)
+{
+    create_chart();
+    lv_chart_set_cache_buf(chart, cache_buf, sizeof(cache_buf));
+    append(3);
+    refr_screen();
+
+    /*No event tells the chart about it, the planes must not be used anyway*/
+    lv_obj_set_style_line_width(chart, 1, LV_PART_ITEMS);
+    assert_cached_like_direct();
+}
+
+void test_chart_cache_not_used_when_too_small(void)
+{
+    create_chart();
+    lv_chart_set_cache_buf(chart, cache_buf, sizeof(cache_buf) - 1);
+    append(3);
+    TEST_ASSERT_FALSE(((lv_chart_t *)chart)->cache_valid);
+
+    lv_chart_set_cache_buf(chart, cache_buf, sizeof(cache_buf));
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_CIRCULAR);
+    append(3);
+    TEST_ASSERT_FALSE(((lv_chart_t *)chart)->cache_valid);
+}
+
+#endif
@@ -0,0 +1,126 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    _lv_font_clean_up_fmt_txt();
+}
+
+static uint32_t bitmap_size(const lv_font_t * font, uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    if(!lv_font_get_glyph_dsc(font, &g, letter, 0)) return 0;
+    return (g.box_w * g.box_h * g.bpp + 7) / 8;
+}
+
+static void assert_same_bitmap(uint32_t letter)
+{
+    uint32_t size = bitmap_size(&lv_font_montserrat_28, letter);
+    const uint8_t * plain = lv_font_get_glyph_bitmap(&lv_font_montserrat_28, letter);
+    const uint8_t * decompr = lv_font_get_glyph_bitmap(&lv_font_montserrat_28_compressed, letter);
+
+    TEST_ASSERT_EQUAL_UINT32(size, bitmap_size(&lv_font_montserrat_28_compressed, letter));
+    if(size == 0) return;
+    TEST_ASSERT_NOT_NULL(plain);
+    TEST_ASSERT_NOT_NULL(decompr);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plain, decompr, size);
+}
+
+void test_glyph_ids_of_letters_sharing_a_cache_slot(void)
+{
+    /*'A', 'A' + LV_FONT_FMT_TXT_CACHE_SIZE, ... share one slot; a non-existing letter too*/
+    const uint32_t letters[] = {'A', 'A' + LV_FONT_FMT_TXT_CACHE_SIZE, 'A' + 2 * LV_FONT_FMT_TXT_CACHE_SIZE, 0x4E00 + ('A' % LV_FONT_FMT_TXT_CACHE_SIZE)};
+    lv_font_glyph_dsc_t first[4];
+    bool found[4];
+    uint32_t i;
+
+    for(i = 0; i < 4; i++) {
+        found[i] = lv_font_get_glyph_dsc(&lv_font_montserrat_28, &first[i], letters[i], 0);
+    }
+    TEST_ASSERT_TRUE(found[0]);
+    TEST_ASSERT_TRUE(found[1]);
+    TEST_ASSERT_TRUE(found[2]);
+    TEST_ASSERT_FALSE(found[3]);
+
+    /*Look them up again in an order that keeps evicting each other*/
+    for(uint32_t round = 0; round < 3; round++) {
+        for(i = 0; i < 4; i++) {
+            uint32_t k = (i * 3 + round) % 4;
+            lv_font_glyph_dsc_t g;
+            TEST_ASSERT_EQUAL(found[k], lv_font_get_glyph_dsc(&lv_font_montserrat_28, &g, letters[k], 0));
+            if(found[k]) {
+                TEST_ASSERT_EQUAL_INT(first[k].adv_w, g.adv_w);
+                TEST_ASSERT_EQUAL_INT(first[k].box_w, g.box_w);
+                TEST_ASSERT_EQUAL_INT(first[k].box_h, g.box_h);
+                TEST_ASSERT_EQUAL_INT(first[k].ofs_y, g.ofs_y);
+            }
+        }
+    }
+}
+
+void test_decompressed_bitmaps_match_the_plain_font(void)
+{
+    for(uint32_t letter = 0x21; letter < 0x7F; letter++) {
+        assert_same_bitmap(letter);
+    }
+}
+
+void test_decompressed_bitmap_is_reused(void)
+{
+    const uint8_t * first = lv_font_get_glyph_bitmap(&lv_font_montserrat_28_compressed, '8');
+    const uint8_t * other = lv_font_get_glyph_bitmap(&lv_font_montserrat_28_compressed, '0');
+    const uint8_t * again = lv_font_get_glyph_bitmap(&lv_font_montserrat_28_compressed, '8');
+
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_NOT_NULL(other);
+    /*Both glyphs are kept, not decompressed into one shared buffer*/
+    TEST_ASSERT_TRUE(first != other);
+    TEST_ASSERT_EQUAL_PTR(first, again);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(lv_font_get_glyph_bitmap(&lv_font_montserrat_28, '8'), first,
+                                  bitmap_size(&lv_font_montserrat_28, '8'));
+}
+
+void test_bitmap_cache_stays_within_its_size(void)
+{
+    uint32_t total = 0;
+    for(uint32_t letter = 0x21; letter < 0x7F; letter++) {
+        total += bitmap_size(&lv_font_montserrat_28_compressed, letter);
+        lv_font_get_glyph_bitmap(&lv_font_montserrat_28_compressed, letter);
+    }
+    /*All of ASCII doesn't fit, so bitmaps were dropped*/
+    TEST_ASSERT_GREATER_THAN_UINT32(LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE, total);
+
+    const lv_font_fmt_txt_dsc_t * fdsc = lv_font_montserrat_28_compressed.dsc;
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE, fdsc->cache->bitmap_size);
+
+    /*Dropped and re-decompressed glyphs are still right*/
+    assert_same_bitmap('!');
+    assert_same_bitmap('~');
+}
+
+void test_clean_up_frees_the_bitmaps(void)
+{
+    lv_mem_monitor_t mon_before;
+    lv_mem_monitor_t mon_after;
+
+    _lv_font_clean_up_fmt_txt();
+    lv_mem_monitor(&mon_before);
+
+    lv_font_get_glyph_bitmap(&lv_font_montserrat_28_compressed, 'W');
+    _lv_font_clean_up_fmt_txt();
+    lv_mem_monitor(&mon_after);
+
+    const lv_font_fmt_txt_dsc_t * fdsc = lv_font_montserrat_28_compressed.dsc;
+    TEST_ASSERT_NULL(fdsc->cache->bitmaps);
+    TEST_ASSERT_EQUAL_UINT32(0, fdsc->cache->bitmap_size);
+    TEST_ASSERT_EQUAL_UINT32(mon_before.free_size, mon_after.free_size);
+}
+
+#endif
@@ -0,0 +1,190 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_REFR_PARALLEL
+
+#include <pthread.h>
+#include <string.h>
+
+#define WORKERS  4
+
+extern lv_color_t test_fb[];
+
+static lv_color_t serial_fb[800 * 480];
+
+static pthread_mutex_t mux = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+static pthread_mutex_t shared_mux;
+static pthread_t threads[WORKERS];
+static uint32_t job_seq;
+static uint32_t running;
+static lv_refr_job_cb_t job_cb;
+static void * job_ctx;
+static uint32_t jobs_done[WORKERS];
+static bool started;
+
+static void * worker_main(void * arg)
+{
+    uint32_t worker = (uint32_t)(uintptr_t)arg;
+    uint32_t seen = 0;
+
+    pthread_mutex_lock(&mux);
+    while(1) {
+        while(job_seq == seen) pthread_cond_wait(&cond, &mux);
+        seen = job_seq;
+        pthread_mutex_unlock(&mux);
+
+        job_cb(job_ctx, worker);
+
+        pthread_mutex_lock(&mux);
+        jobs_done[worker]++;
+        running--;
+        pthread_cond_broadcast(&cond);
+    }
+    return NULL;
+}
+
+static void run(lv_refr_job_cb_t job, void * ctx)
+{
+    pthread_mutex_lock(&mux);
+    job_cb = job;
+    job_ctx = ctx;
+    running = WORKERS;
+    job_seq++;
+    pthread_cond_broadcast(&cond);
+    while(running > 0) pthread_cond_wait(&cond, &mux);
+    pthread_mutex_unlock(&mux);
+}
+
+static uint32_t worker_id(void)
+{
+    uint32_t i;
+    for(i = 0; i < WORKERS; i++) {
+        if(pthread_equal(threads[i], pthread_self())) return i;
+    }
+    TEST_FAIL_MESSAGE("worker_id called outside the workers");
+    return 0;
+}
+
+static void lock(void)
+{
+    pthread_mutex_lock(&shared_mux);
+}
+
+static void unlock(void)
+{
+    pthread_mutex_unlock(&shared_mux);
+}
+
+static void start_workers(void)
+{
+    if(started) return;
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&shared_mux, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    uint32_t i;
+    for(i = 0; i < WORKERS; i++) {
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[i], NULL, worker_main, (void *)(uintptr_t)i));
+    }
+    started = true;
+}
+
+static void create_ui(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 300, 300);
+    lv_obj_set_pos(obj, 40, 60);
+    lv_obj_set_style_radius(obj, 40, 0);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_bg_grad_color(obj, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_shadow_width(obj, 30, 0);
+    lv_obj_set_style_border_width(obj, 5, 0);
+    lv_obj_set_style_clip_corner(obj, true, 0);
+
+    lv_obj_t * label = lv_label_create(obj);
+    lv_label_set_text(label, "Rendered in bands\nacross the threads");
+    lv_obj_center(label);
+
+    lv_obj_t * bar = lv_bar_create(lv_scr_act());
+    lv_obj_set_size(bar, 360, 200);
+    lv_obj_set_pos(bar, 400, 100);
+    lv_bar_set_value(bar, 60, LV_ANIM_OFF);
+
+    lv_obj_t * arc = lv_arc_create(lv_scr_act());
+    lv_obj_set_size(arc, 150, 150);
+    lv_obj_set_pos(arc, 500, 320);
+    lv_arc_set_value(arc, 70);
+}
+
+void setUp(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void tearDown(void)
+{
+    lv_refr_set_parallel(NULL);
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_refr_parallel_renders_like_serial(void)
+{
+    create_ui();
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    memcpy(serial_fb, test_fb, sizeof(serial_fb));
+
+    start_workers();
+    lv_refr_parallel_t par = {
+        .run = run,
+        .worker_id = worker_id,
+        .lock = lock,
+        .unlock = unlock,
+        .worker_cnt = WORKERS,
+    };
+    lv_refr_set_parallel(&par);
+    memset(jobs_done, 0, sizeof(jobs_done));
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    uint32_t i;
+    for(i = 0; i < WORKERS; i++) {
+        TEST_ASSERT_GREATER_THAN_UINT32(0, jobs_done[i]);
+    }
+    TEST_ASSERT_EQUAL_MEMORY(serial_fb, test_fb, sizeof(serial_fb));
+}
+
+void test_refr_parallel_keeps_short_areas_serial(void)
+{
+    start_workers();
+    lv_refr_parallel_t par = {
+        .run = run,
+        .worker_id = worker_id,
+        .lock = lock,
+        .unlock = unlock,
+        .worker_cnt = WORKERS,
+    };
+    lv_refr_set_parallel(&par);
+    lv_refr_now(NULL);
+    memset(jobs_done, 0, sizeof(jobs_done));
+
+    /*Lower than two bands*/
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 200, LV_REFR_PARALLEL_MIN_ROWS);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(0, jobs_done[0]);
+}
+
+#endif
+
+#endif
@@ -106,4 +106,91 @@ void test_inherit_meta_with_lower_precedence_style(void)
     TEST_ASSERT_EQUAL_HEX(lv_color_hex(0xff0000).full, lv_obj_get_style_text_color(grandchild, LV_PART_MAIN).full);
 }
 
+void test_style_cache_follows_state(void)
+{
+    lv_obj_clean(lv_scr_act());   /*Earlier tests leave objects with styles from their stack*/
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x0000ff), LV_PART_MAIN);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0xff0000), LV_PART_MAIN | LV_STATE_PRESSED);
+    lv_refr_now(NULL);  /*Drawing creates the cache*/
+
+    TEST_ASSERT_EQUAL_HEX(lv_color_hex(0x0000ff).full, lv_obj_get_style_bg_color(obj, LV_PART_MAIN).full);
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_HEX(lv_color_hex(0xff0000).full, lv_obj_get_style_bg_color(obj, LV_PART_MAIN).full);
+    lv_obj_clear_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_HEX(lv_color_hex(0x0000ff).full, lv_obj_get_style_bg_color(obj, LV_PART_MAIN).full);
+
+    lv_obj_del(obj);
+}
+
+void test_style_cache_follows_style_changes(void)
+{
+    lv_obj_clean(lv_scr_act());   /*Earlier tests leave objects with styles from their stack*/
+    lv_obj_t * parent = lv_obj_create(lv_scr_act());
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_t * label = lv_label_create(parent);
+    lv_coord_t theme_width = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_border_width(&style, 3);
+    lv_obj_add_style(obj, &style, LV_PART_MAIN);
+    lv_obj_set_style_text_color(parent, lv_color_hex(0x00ff00), LV_PART_MAIN);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    lv_style_set_border_width(&style, 5);
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    /*Reported changes are seen even if refreshing is disabled*/
+    lv_obj_enable_style_refresh(false);
+    lv_style_set_border_width(&style, 7);
+    lv_obj_report_style_change(&style);
+    lv_obj_enable_style_refresh(true);
+    TEST_ASSERT_EQUAL(7, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    lv_obj_set_style_border_width(obj, 9, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(9, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_BORDER_WIDTH, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(7, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    lv_obj_remove_style(obj, &style, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(theme_width, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    /*Inherited from the parent*/
+    TEST_ASSERT_EQUAL_HEX(lv_color_hex(0x00ff00).full, lv_obj_get_style_text_color(label, LV_PART_MAIN).full);
+    lv_obj_set_style_text_color(parent, lv_color_hex(0x123456), LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_HEX(lv_color_hex(0x123456).full, lv_obj_get_style_text_color(label, LV_PART_MAIN).full);
+
+    lv_obj_del(parent);
+}
+
+void test_style_cache_matches_uncached_lookup(void)
+{
+    lv_obj_clean(lv_scr_act());   /*Earlier tests leave objects with styles from their stack*/
+    static const lv_part_t parts[] = {LV_PART_MAIN, LV_PART_SCROLLBAR, LV_PART_INDICATOR, LV_PART_KNOB};
+    lv_obj_t * obj = lv_slider_create(lv_scr_act());
+    lv_obj_set_style_radius(obj, 4, LV_PART_KNOB);
+    lv_obj_set_style_pad_all(obj, 6, LV_PART_INDICATOR);
+    lv_obj_add_state(obj, LV_STATE_FOCUSED);
+    lv_refr_now(NULL);
+
+    /*More properties than entries, read twice to have hits and collisions*/
+    uint32_t round;
+    for(round = 0; round < 2; round++) {
+        uint32_t p;
+        for(p = 0; p < sizeof(parts) / sizeof(parts[0]); p++) {
+            lv_style_prop_t prop;
+            for(prop = 1; prop <= _LV_STYLE_LAST_BUILT_IN_PROP; prop++) {
+                lv_style_value_t v = lv_obj_get_style_prop(obj, parts[p], prop);
+                obj->skip_trans = 1;    /*Bypasses the cache*/
+                lv_style_value_t ref = lv_obj_get_style_prop(obj, parts[p], prop);
+                obj->skip_trans = 0;
+                TEST_ASSERT_EQUAL_INT32(ref.num, v.num);
+            }
+        }
+    }
+
+    lv_obj_del(obj);
+}
+
 #endif
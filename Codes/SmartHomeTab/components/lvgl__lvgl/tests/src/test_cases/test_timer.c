@@ -0,0 +1,205 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define PAUSED_MAX  16
+
+static lv_timer_t * paused[PAUSED_MAX];
+static uint32_t paused_cnt;
+static uint32_t run_cnt;
+static lv_timer_t * run_order[4];
+static uint32_t run_order_cnt;
+
+/*Keep LVGL's own timers out of the way*/
+void setUp(void)
+{
+    paused_cnt = 0;
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    while(timer) {
+        if(!timer->paused) {
+            TEST_ASSERT_LESS_THAN_UINT32(PAUSED_MAX, paused_cnt);
+            lv_timer_pause(timer);
+            paused[paused_cnt++] = timer;
+        }
+        timer = lv_timer_get_next(timer);
+    }
+    run_cnt = 0;
+    run_order_cnt = 0;
+}
+
+void tearDown(void)
+{
+    uint32_t i;
+    for(i = 0; i < paused_cnt; i++) lv_timer_resume(paused[i]);
+}
+
+static uint32_t timer_cnt(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    while(timer) {
+        cnt++;
+        timer = lv_timer_get_next(timer);
+    }
+    return cnt;
+}
+
+static void count_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    run_cnt++;
+}
+
+static void order_cb(lv_timer_t * timer)
+{
+    run_order[run_order_cnt++] = timer;
+}
+
+static void create_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    lv_timer_t * once = lv_timer_create(count_cb, 0, NULL);
+    lv_timer_set_repeat_count(once, 1);
+}
+
+static void del_other_cb(lv_timer_t * timer)
+{
+    run_cnt++;
+    lv_timer_del(timer->user_data);
+    lv_timer_del(timer);
+}
+
+void test_timer_runs_due_timers_in_deadline_order(void)
+{
+    lv_timer_t * a = lv_timer_create(order_cb, 30000, NULL);
+    lv_timer_t * b = lv_timer_create(order_cb, 20000, NULL);
+    lv_timer_t * c = lv_timer_create(order_cb, 10000, NULL);
+
+    /*Late by 10, 20 and 30 seconds*/
+    uint32_t now = lv_tick_get();
+    a->last_run = now - 40000;
+    b->last_run = now - 40000;
+    c->last_run = now - 40000;
+    lv_timer_set_period(a, 30000);
+    lv_timer_set_period(b, 20000);
+    lv_timer_set_period(c, 10000);
+
+    lv_timer_handler();
+
+    TEST_ASSERT_EQUAL_UINT32(3, run_order_cnt);
+    TEST_ASSERT_EQUAL_PTR(c, run_order[0]);
+    TEST_ASSERT_EQUAL_PTR(b, run_order[1]);
+    TEST_ASSERT_EQUAL_PTR(a, run_order[2]);
+
+    lv_timer_del(a);
+    lv_timer_del(b);
+    lv_timer_del(c);
+}
+
+void test_timer_time_till_next(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_get_time_till_next());
+
+    lv_timer_t * timer = lv_timer_create(count_cb, 5000, NULL);
+    lv_timer_t * later = lv_timer_create(count_cb, 8000, NULL);
+    TEST_ASSERT_UINT32_WITHIN(100, 4950, lv_timer_get_time_till_next());
+
+    lv_timer_pause(timer);
+    TEST_ASSERT_UINT32_WITHIN(100, 7950, lv_timer_get_time_till_next());
+
+    lv_timer_resume(timer);
+    lv_timer_ready(timer);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_timer_get_time_till_next());
+    TEST_ASSERT_UINT32_WITHIN(100, 4950, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+
+    lv_timer_del(timer);
+    lv_timer_del(later);
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_get_time_till_next());
+}
+
+void test_timer_zero_period_runs_once_per_call(void)
+{
+    lv_timer_t * timer = lv_timer_create(count_cb, 0, NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(0, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+
+    lv_timer_del(timer);
+}
+
+void test_timer_created_in_callback_runs_in_the_same_call(void)
+{
+    uint32_t cnt = timer_cnt();
+    lv_timer_t * timer = lv_timer_create(create_cb, 10000, NULL);
+    lv_timer_set_repeat_count(timer, 1);
+    lv_timer_ready(timer);
+
+    lv_timer_handler();
+
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_EQUAL_UINT32(cnt, timer_cnt());     /*Both deleted after their last run*/
+}
+
+void test_timer_deleted_in_callback(void)
+{
+    uint32_t cnt = timer_cnt();
+    lv_timer_t * other = lv_timer_create(count_cb, 10000, NULL);
+    lv_timer_t * timer = lv_timer_create(del_other_cb, 10000, other);
+
+    /*Both due, `timer` first*/
+    timer->last_run = lv_tick_get() - 20000;
+    lv_timer_set_period(timer, 10000);
+    lv_timer_ready(other);
+
+    lv_timer_handler();
+
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_EQUAL_UINT32(cnt, timer_cnt());
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_get_time_till_next());
+}
+
+void test_timer_repeat_count(void)
+{
+    uint32_t cnt = timer_cnt();
+    lv_timer_t * timer = lv_timer_create(count_cb, 10000, NULL);
+    lv_timer_set_repeat_count(timer, 2);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(0, run_cnt);
+
+    lv_timer_ready(timer);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_EQUAL_UINT32(cnt + 1, timer_cnt());
+
+    lv_timer_ready(timer);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+    TEST_ASSERT_EQUAL_UINT32(cnt, timer_cnt());
+}
+
+void test_timer_many(void)
+{
+    lv_timer_t * timers[64];
+    uint32_t i;
+    for(i = 0; i < 64; i++) {
+        timers[i] = lv_timer_create(count_cb, 1000 + (i * 37) % 64 * 100, NULL);
+    }
+    TEST_ASSERT_UINT32_WITHIN(100, 950, lv_timer_get_time_till_next());
+
+    /*Remove them in an other order than they were created*/
+    for(i = 0; i < 64; i += 2) lv_timer_del(timers[i]);
+    for(i = 1; i < 64; i += 2) {
+        lv_timer_ready(timers[i]);
+        TEST_ASSERT_EQUAL_UINT32(0, lv_timer_get_time_till_next());
+        lv_timer_pause(timers[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_get_time_till_next());
+    for(i = 1; i < 64; i += 2) lv_timer_del(timers[i]);
+}
+
+#endif
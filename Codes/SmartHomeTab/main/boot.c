@@ -0,0 +1,101 @@
+#include "boot.h"
+#include <assert.h>
+#include <stdlib.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/task.h"
+
+static const char *TAG = "BOOT";
+
+typedef struct {
+    uint32_t start_ms;
+    uint32_t done_ms;
+} boot_times_t;
+
+static const boot_stage_t *stages;
+static size_t stage_cnt;
+static EventGroupHandle_t done_bits;
+static uint32_t claimed;                    // stages boot_done() was called for, under claim_lock
+static portMUX_TYPE claim_lock = portMUX_INITIALIZER_UNLOCKED;
+static boot_times_t times[BOOT_MAX_STAGES];
+
+static uint32_t now_ms(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+// The dependency that completed last, which the stage waited for
+static int last_dep(uint32_t deps)
+{
+    int last = -1;
+    for (size_t i = 0; i < stage_cnt; i++) {
+        if ((deps & BOOT_DEP(i)) && (last < 0 || times[i].done_ms > times[last].done_ms)) last = (int) i;
+    }
+    return last;
+}
+
+static void stage_task(void *arg)
+{
+    int i = (int)(intptr_t) arg;
+    const boot_stage_t *s = &stages[i];
+
+    if (s->deps) xEventGroupWaitBits(done_bits, s->deps, pdFALSE, pdTRUE, portMAX_DELAY);
+    times[i].start_ms = now_ms();
+    s->run();
+    boot_done(i);
+    vTaskDelete(NULL);
+}
+
+void boot_done(int stage)
+{
+    if (done_bits == NULL || stage < 0 || (size_t) stage >= stage_cnt) return;
+
+    // Only the first of concurrent calls completes the stage
+    taskENTER_CRITICAL(&claim_lock);
+    bool first = (claimed & BOOT_DEP(stage)) == 0;
+    claimed |= BOOT_DEP(stage);
+    taskEXIT_CRITICAL(&claim_lock);
+    if (!first) return;
+
+    const boot_stage_t *s = &stages[stage];
+    times[stage].done_ms = now_ms();
+    if (s->run) {
+        int dep = last_dep(s->deps);
+        ESP_LOGI(TAG, "%-12s done at %6u ms, ran %5u ms after %s", s->name, (unsigned) times[stage].done_ms,
+                 (unsigned)(times[stage].done_ms - times[stage].start_ms), dep < 0 ? "boot" : stages[dep].name);
+    } else {
+        ESP_LOGI(TAG, "%-12s done at %6u ms", s->name, (unsigned) times[stage].done_ms);
+    }
+    xEventGroupSetBits(done_bits, BOOT_DEP(stage));
+}
+
+bool boot_is_done(int stage)
+{
+    if (done_bits == NULL || stage < 0 || (size_t) stage >= stage_cnt) return false;
+    return (xEventGroupGetBits(done_bits) & BOOT_DEP(stage)) != 0;
+}
+
+void boot_start(const boot_stage_t *table, size_t cnt)
+{
+    assert(done_bits == NULL && cnt <= BOOT_MAX_STAGES);
+
+    stages = table;
+    stage_cnt = cnt;
+    done_bits = xEventGroupCreate();
+    assert(done_bits);
+
+    for (size_t i = 0; i < cnt; i++) {
+        const boot_stage_t *s = &stages[i];
+        if (s->run == NULL) continue;
+
+        BaseType_t core = s->core < 0 ? tskNO_AFFINITY : s->core;
+        BaseType_t ret = xTaskCreatePinnedToCore(stage_task, s->name, s->stack, (void *)(intptr_t) i,
+                                                 uxTaskPriorityGet(NULL), NULL, core);
+        if (ret != pdPASS) {
+            ESP_LOGE(TAG, "Cannot start %s", s->name);
+            abort();
+        }
+    }
+}
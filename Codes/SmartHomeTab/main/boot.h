@@ -0,0 +1,37 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BOOT_MAX_STAGES     24              // bits of a FreeRTOS event group
+#define BOOT_DEP(stage)     (1u << (stage))
+#define BOOT_ANY_CORE       (-1)
+
+/**
+ * One step of the boot. A stage with a `run` function gets its own task, which waits until
+ * every stage in `deps` has completed, runs it and completes the stage. A stage without one
+ * is an event: it completes when boot_done() is called, e.g. from a callback, and its `deps`
+ * only tell which stages lead to it.
+ */
+typedef struct {
+    const char *name;
+    void (*run)(void);
+    uint32_t deps;                          // BOOT_DEP() of the stages to wait for
+    uint32_t stack;                         // stack of the task (bytes)
+    int core;                               // core of the task, or BOOT_ANY_CORE
+} boot_stage_t;
+
+/**
+ * @brief Start the stages, concurrently as far as their dependencies allow.
+ *
+ * Each completed stage is logged with the time it completed and, for stages that run, the
+ * time it started and the dependency it waited for last, in ms since boot: following those
+ * back gives the critical path to e.g. the first frame. The table must stay valid. Call once.
+ */
+void boot_start(const boot_stage_t *stages, size_t cnt);
+
+// Complete a stage. Later calls for the same stage are ignored. Any task.
+void boot_done(int stage);
+
+// Whether a stage has completed. Any task.
+bool boot_is_done(int stage);
@@ -0,0 +1,296 @@
+#include "i2c_bus.h"
+#include <assert.h>
+#include <string.h>
+#include "driver/i2c.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#define I2C_BUS_PORT            I2C_NUM_0
+#define BUS_TIMEOUT_TICKS       pdMS_TO_TICKS(I2C_BUS_TIMEOUT_MS)
+#define BUS_TASK_STACK_SIZE     (3 * 1024)
+#define BUS_TASK_PRIORITY       (CONFIG_EXAMPLE_LVGL_PORT_TASK_PRIORITY + 2)   // above the touch task
+
+_Static_assert(configTASK_NOTIFICATION_ARRAY_ENTRIES > I2C_BUS_NOTIFY_INDEX,
+               "CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES must be at least 3");
+
+static const char *TAG = "I2C_BUS";
+static TaskHandle_t bus_task_handle = NULL;
+
+// ------------------------------------------------------------
+// JOBS
+// One queue per priority; the caller sleeps until the bus task
+// has run its job and stored the result.
+// ------------------------------------------------------------
+typedef struct {
+    i2c_bus_job_fn_t fn;
+    void *arg;
+    TaskHandle_t waiter;
+    esp_err_t *result;
+} bus_job_t;
+
+static QueueHandle_t job_queues[I2C_BUS_PRIO_MAX];
+
+// ------------------------------------------------------------
+// SEQUENCES
+// A slot is free when cnt is 0. Written by submitters and the
+// bus task, under seq_lock.
+// ------------------------------------------------------------
+typedef struct {
+    int channel;
+    uint8_t cnt;
+    uint8_t next;               // index of the next step
+    int64_t due_us;             // esp_timer time the next step is due
+    i2c_bus_step_t steps[I2C_BUS_SEQ_MAX_STEPS];
+} bus_seq_t;
+
+static portMUX_TYPE seq_lock = portMUX_INITIALIZER_UNLOCKED;
+static bus_seq_t seqs[I2C_BUS_SEQ_MAX];
+
+// ------------------------------------------------------------
+// RAW TRANSFERS (bus task only)
+// ------------------------------------------------------------
+static esp_err_t raw_probe(uint8_t addr)
+{
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    if (cmd == NULL) return ESP_ERR_NO_MEM;
+
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_stop(cmd);
+    esp_err_t err = i2c_master_cmd_begin(I2C_BUS_PORT, cmd, BUS_TIMEOUT_TICKS);
+    i2c_cmd_link_delete(cmd);
+    return err;
+}
+
+static esp_err_t raw_write_reg(uint8_t addr, uint8_t reg, const uint8_t *data, size_t len)
+{
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    if (cmd == NULL) return ESP_ERR_NO_MEM;
+
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, reg, true);
+    if (len > 0) {
+        i2c_master_write(cmd, data, len, true);
+    }
+    i2c_master_stop(cmd);
+    esp_err_t err = i2c_master_cmd_begin(I2C_BUS_PORT, cmd, BUS_TIMEOUT_TICKS);
+    i2c_cmd_link_delete(cmd);
+    return err;
+}
+
+typedef enum {
+    XFER_PROBE,
+    XFER_WRITE,
+    XFER_WRITE_REG,
+    XFER_READ_REG,
+} xfer_op_t;
+
+typedef struct {
+    xfer_op_t op;
+    uint8_t addr;
+    uint8_t reg;
+    const uint8_t *wdata;
+    uint8_t *rdata;
+    size_t len;
+} xfer_t;
+
+static esp_err_t xfer_job(void *arg)
+{
+    const xfer_t *x = arg;
+
+    switch (x->op) {
+    case XFER_PROBE:
+        return raw_probe(x->addr);
+    case XFER_WRITE:
+        return i2c_master_write_to_device(I2C_BUS_PORT, x->addr, x->wdata, x->len, BUS_TIMEOUT_TICKS);
+    case XFER_WRITE_REG:
+        return raw_write_reg(x->addr, x->reg, x->wdata, x->len);
+    case XFER_READ_REG:
+        return i2c_master_write_read_device(I2C_BUS_PORT, x->addr, &x->reg, 1, x->rdata, x->len,
+                                            BUS_TIMEOUT_TICKS);
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
+// ------------------------------------------------------------
+// BUS TASK
+// Touch jobs first, then due sequence steps, then control and
+// background jobs. Sleeps until a submission or the next step.
+// ------------------------------------------------------------
+
+// Take the earliest due step. Otherwise return false and the time to the next step (-1: none).
+static bool seq_take_step(int64_t now, i2c_bus_step_t *step, int64_t *wait_us)
+{
+    bus_seq_t *due = NULL;
+
+    *wait_us = -1;
+    taskENTER_CRITICAL(&seq_lock);
+    for (int i = 0; i < I2C_BUS_SEQ_MAX; i++) {
+        bus_seq_t *s = &seqs[i];
+        if (s->cnt == 0) continue;
+        if (s->due_us <= now) {
+            if (due == NULL || s->due_us < due->due_us) due = s;
+        } else if (*wait_us < 0 || s->due_us - now < *wait_us) {
+            *wait_us = s->due_us - now;
+        }
+    }
+    if (due) {
+        *step = due->steps[due->next++];
+        if (due->next == due->cnt) {
+            due->cnt = 0;
+        } else {
+            due->due_us = now + step->delay_ms * 1000;
+        }
+    }
+    taskEXIT_CRITICAL(&seq_lock);
+    return due != NULL;
+}
+
+static void job_run(const bus_job_t *job)
+{
+    *job->result = job->fn(job->arg);
+    xTaskNotifyGiveIndexed(job->waiter, I2C_BUS_NOTIFY_INDEX);
+}
+
+static void bus_task(void *arg)
+{
+    bus_job_t job;
+    i2c_bus_step_t step;
+    int64_t wait_us;
+
+    while (1) {
+        if (xQueueReceive(job_queues[I2C_BUS_PRIO_TOUCH], &job, 0) == pdTRUE) {
+            job_run(&job);
+        } else if (seq_take_step(esp_timer_get_time(), &step, &wait_us)) {
+            esp_err_t err = i2c_master_write_to_device(I2C_BUS_PORT, step.addr, &step.data, 1, BUS_TIMEOUT_TICKS);
+            if (err != ESP_OK) {
+                ESP_LOGW(TAG, "0x%02x <- 0x%02x failed: %s", step.addr, step.data, esp_err_to_name(err));
+            }
+        } else if (xQueueReceive(job_queues[I2C_BUS_PRIO_CONTROL], &job, 0) == pdTRUE ||
+                   xQueueReceive(job_queues[I2C_BUS_PRIO_BACKGROUND], &job, 0) == pdTRUE) {
+            job_run(&job);
+        } else {
+            // Submissions notify this task, so nothing is missed between the checks and the wait
+            ulTaskNotifyTake(pdTRUE, (wait_us < 0) ? portMAX_DELAY : pdMS_TO_TICKS((wait_us + 999) / 1000));
+        }
+    }
+}
+
+// ------------------------------------------------------------
+// INIT
+// ------------------------------------------------------------
+esp_err_t i2c_bus_init(void)
+{
+    i2c_config_t conf = {
+        .mode = I2C_MODE_MASTER,
+        .sda_io_num = I2C_BUS_SDA_IO,
+        .scl_io_num = I2C_BUS_SCL_IO,
+        .sda_pullup_en = GPIO_PULLUP_ENABLE,
+        .scl_pullup_en = GPIO_PULLUP_ENABLE,
+        .master.clk_speed = I2C_BUS_FREQ_HZ
+    };
+
+    esp_err_t err = i2c_param_config(I2C_BUS_PORT, &conf);
+    if (err == ESP_OK) {
+        err = i2c_driver_install(I2C_BUS_PORT, conf.mode, 0, 0, 0);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "I2C init failed: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    for (int i = 0; i < I2C_BUS_PRIO_MAX; i++) {
+        job_queues[i] = xQueueCreate(I2C_BUS_QUEUE_LEN, sizeof(bus_job_t));
+        if (job_queues[i] == NULL) return ESP_ERR_NO_MEM;
+    }
+    if (xTaskCreate(bus_task, "i2c_bus", BUS_TASK_STACK_SIZE, NULL, BUS_TASK_PRIORITY,
+                    &bus_task_handle) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "I2C bus at %d Hz", I2C_BUS_FREQ_HZ);
+    return ESP_OK;
+}
+
+// ------------------------------------------------------------
+// SUBMISSION
+// ------------------------------------------------------------
+esp_err_t i2c_bus_run(i2c_bus_prio_t prio, i2c_bus_job_fn_t fn, void *arg)
+{
+    assert(bus_task_handle && "i2c_bus_init must be called first");
+    assert(prio < I2C_BUS_PRIO_MAX);
+
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    if (self == bus_task_handle) {
+        return fn(arg);     // Already inside a job
+    }
+
+    esp_err_t result = ESP_FAIL;
+    bus_job_t job = { .fn = fn, .arg = arg, .waiter = self, .result = &result };
+    xQueueSend(job_queues[prio], &job, portMAX_DELAY);
+    xTaskNotifyGive(bus_task_handle);
+    ulTaskNotifyTakeIndexed(I2C_BUS_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+    return result;
+}
+
+esp_err_t i2c_bus_submit_seq(int channel, const i2c_bus_step_t *steps, size_t cnt)
+{
+    bus_seq_t *slot = NULL;
+
+    assert(bus_task_handle && "i2c_bus_init must be called first");
+    if (cnt == 0 || cnt > I2C_BUS_SEQ_MAX_STEPS) return ESP_ERR_INVALID_ARG;
+
+    taskENTER_CRITICAL(&seq_lock);
+    for (int i = 0; i < I2C_BUS_SEQ_MAX && slot == NULL; i++) {
+        if (seqs[i].cnt != 0 && seqs[i].channel == channel) slot = &seqs[i];
+    }
+    for (int i = 0; i < I2C_BUS_SEQ_MAX && slot == NULL; i++) {
+        if (seqs[i].cnt == 0) slot = &seqs[i];
+    }
+    if (slot) {
+        memcpy(slot->steps, steps, cnt * sizeof(steps[0]));
+        slot->channel = channel;
+        slot->cnt = cnt;
+        slot->next = 0;
+        slot->due_us = 0;   // first step is due now
+    }
+    taskEXIT_CRITICAL(&seq_lock);
+
+    if (slot == NULL) {
+        ESP_LOGW(TAG, "No free sequence slot for channel %d", channel);
+        return ESP_ERR_NO_MEM;
+    }
+    xTaskNotifyGive(bus_task_handle);
+    return ESP_OK;
+}
+
+// ------------------------------------------------------------
+// BLOCKING TRANSFERS
+// ------------------------------------------------------------
+bool i2c_bus_probe(uint8_t addr)
+{
+    xfer_t x = { .op = XFER_PROBE, .addr = addr };
+    return i2c_bus_run(I2C_BUS_PRIO_BACKGROUND, xfer_job, &x) == ESP_OK;
+}
+
+esp_err_t i2c_bus_write(uint8_t addr, const uint8_t *data, size_t len)
+{
+    xfer_t x = { .op = XFER_WRITE, .addr = addr, .wdata = data, .len = len };
+    return i2c_bus_run(I2C_BUS_PRIO_BACKGROUND, xfer_job, &x);
+}
+
+esp_err_t i2c_bus_write_reg(uint8_t addr, uint8_t reg, const uint8_t *data, size_t len)
+{
+    xfer_t x = { .op = XFER_WRITE_REG, .addr = addr, .reg = reg, .wdata = data, .len = len };
+    return i2c_bus_run(I2C_BUS_PRIO_BACKGROUND, xfer_job, &x);
+}
+
+esp_err_t i2c_bus_read_reg(uint8_t addr, uint8_t reg, uint8_t *data, size_t len)
+{
+    xfer_t x = { .op = XFER_READ_REG, .addr = addr, .reg = reg, .rdata = data, .len = len };
+    return i2c_bus_run(I2C_BUS_PRIO_BACKGROUND, xfer_job, &x);
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+// Shared I2C bus of the board: backlight/buzzer controller, GT911 touch and PCF8563 RTC.
+// All transfers run in one bus task, which takes them in priority order.
+#define I2C_BUS_SDA_IO          15
+#define I2C_BUS_SCL_IO          16
+#define I2C_BUS_FREQ_HZ         CONFIG_SMARTHOME_I2C_FREQ_HZ
+#define I2C_BUS_TIMEOUT_MS      200
+#define I2C_BUS_QUEUE_LEN       8       // Pending jobs per priority
+#define I2C_BUS_SEQ_MAX         4       // Sequences running at the same time
+#define I2C_BUS_SEQ_MAX_STEPS   48      // Steps per sequence
+#define I2C_BUS_NOTIFY_INDEX    2       // Task notification index a caller of i2c_bus_run() waits on
+
+typedef enum {
+    I2C_BUS_PRIO_TOUCH,         // Touch reads, ahead of everything else
+    I2C_BUS_PRIO_CONTROL,       // Backlight and buzzer; sequence steps run at this priority
+    I2C_BUS_PRIO_BACKGROUND,    // RTC and other periodic reads
+    I2C_BUS_PRIO_MAX,
+} i2c_bus_prio_t;
+
+// A job runs in the bus task and may call the transfer functions below, or drivers
+// that use the I2C port directly (esp_lcd_touch)
+typedef esp_err_t (*i2c_bus_job_fn_t)(void *arg);
+
+// One write of a timed sequence
+typedef struct {
+    uint8_t addr;
+    uint8_t data;
+    uint16_t delay_ms;          // Wait after this write before the next step
+} i2c_bus_step_t;
+
+// Install the I2C driver and start the bus task. Call once, before any other function of this file.
+esp_err_t i2c_bus_init(void);
+
+// Run a job in the bus task and wait for its result. Must not be called from the LVGL
+// task; use i2c_bus_submit_seq() there.
+esp_err_t i2c_bus_run(i2c_bus_prio_t prio, i2c_bus_job_fn_t fn, void *arg);
+
+// Start a sequence of single byte writes without waiting. A sequence still running on the
+// same channel is replaced, e.g. a new backlight level cancels a fade. The bus serves other
+// jobs during the delays. Returns ESP_ERR_NO_MEM if all sequence slots are in use.
+esp_err_t i2c_bus_submit_seq(int channel, const i2c_bus_step_t *steps, size_t cnt);
+
+// Blocking transfers at background priority. Called from a job, they run directly.
+bool i2c_bus_probe(uint8_t addr);
+esp_err_t i2c_bus_write(uint8_t addr, const uint8_t *data, size_t len);
+esp_err_t i2c_bus_write_reg(uint8_t addr, uint8_t reg, const uint8_t *data, size_t len);
+esp_err_t i2c_bus_read_reg(uint8_t addr, uint8_t reg, uint8_t *data, size_t len);
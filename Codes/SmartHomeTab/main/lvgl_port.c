@@ -12,14 +12,33 @@
 #include "esp_lcd_touch.h"
 #include "esp_timer.h"
 #include "esp_log.h"
+#include <string.h>
 #include "lvgl.h"
 #include "lvgl_port.h"
+#include "lvgl_port_draw.h"
+#include "lvgl_port_parallel.h"
+#include "lvgl_port_perf.h"
+#include "lvgl_port_touch.h"
+#include "lvgl_port_rotate.h"
 
 static const char *TAG = "lv_port";                      // Tag for logging
 static SemaphoreHandle_t lvgl_mux;                       // LVGL mutex for synchronization
 static TaskHandle_t lvgl_task_handle = NULL;             // Handle for the LVGL task
 
+#if LVGL_PORT_TICKLESS
+_Static_assert(configTASK_NOTIFICATION_ARRAY_ENTRIES > LVGL_PORT_WAKE_NOTIFY_INDEX,
+               "CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES must be at least 2");
+#endif
+
+static portMUX_TYPE trigger_lock = portMUX_INITIALIZER_UNLOCKED; // Protects the triggered timer set
+static lv_timer_t *triggered[LVGL_PORT_TRIGGER_MAX];     // Timers to resume and run at the next wakeup
+static int triggered_cnt = 0;                            // Number of triggered timers
+#if LVGL_PORT_TICKLESS
+static uint32_t lvgl_due_ms;                             // LVGL tick at which the LVGL task wakes next, protected by lvgl_mux
+#endif
+
 #if EXAMPLE_LVGL_PORT_ROTATION_DEGREE != 0
+#if LVGL_PORT_FULL_REFRESH
 // Function to get the next frame buffer for double buffering
 static void *get_next_frame_buffer(esp_lcd_panel_handle_t panel_handle)
 {
@@ -34,164 +53,122 @@ static void *get_next_frame_buffer(esp_lcd_panel_handle_t panel_handle)
     }
     return next_fb;                                       // Return the next frame buffer
 }
+#endif /* LVGL_PORT_FULL_REFRESH */
+#endif /* EXAMPLE_LVGL_PORT_ROTATION_DEGREE */
 
-// Function to rotate and copy pixels from one buffer to another
-IRAM_ATTR static void rotate_copy_pixel(const uint16_t *from, uint16_t *to, uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end, uint16_t w, uint16_t h, uint16_t rotation)
+#if LVGL_PORT_DIRECT_MODE || (LVGL_PORT_FULL_REFRESH && LVGL_PORT_LCD_RGB_BUFFER_NUMS == 2)
+// Block until the RGB panel has started sending the frame buffer passed to esp_lcd_panel_draw_bitmap()
+static void wait_for_vsync(void)
 {
-    int from_index = 0;                                   // Index for source buffer
-    int to_index = 0;                                     // Index for destination buffer
-    int to_index_const = 0;                               // Constant index for destination buffer
-
-    switch (rotation) {
-    case 90:
-        to_index_const = (w - x_start - 1) * h;          // Calculate constant index for 90-degree rotation
-        for (int from_y = y_start; from_y < y_end + 1; from_y++) {
-            from_index = from_y * w + x_start;           // Calculate index in the source buffer
-            to_index = to_index_const + from_y;          // Calculate index in the destination buffer
-            for (int from_x = x_start; from_x < x_end + 1; from_x++) {
-                *(to + to_index) = *(from + from_index);  // Copy pixel
-                from_index += 1;                          // Move to the next pixel in the source
-                to_index -= h;                            // Move to the next pixel in the destination
-            }
-        }
-        break;
-    case 180:
-        to_index_const = h * w - x_start - 1;            // Calculate constant index for 180-degree rotation
-        for (int from_y = y_start; from_y < y_end + 1; from_y++) {
-            from_index = from_y * w + x_start;           // Calculate index in the source buffer
-            to_index = to_index_const - from_y * w;      // Calculate index in the destination buffer
-            for (int from_x = x_start; from_x < x_end + 1; from_x++) {
-                *(to + to_index) = *(from + from_index);  // Copy pixel
-                from_index += 1;                          // Move to the next pixel in the source
-                to_index -= 1;                            // Move to the next pixel in the destination
-            }
-        }
-        break;
-    case 270:
-        to_index_const = (x_start + 1) * h - 1;          // Calculate constant index for 270-degree rotation
-        for (int from_y = y_start; from_y < y_end + 1; from_y++) {
-            from_index = from_y * w + x_start;           // Calculate index in the source buffer
-            to_index = to_index_const - from_y;          // Calculate index in the destination buffer
-            for (int from_x = x_start; from_x < x_end + 1; from_x++) {
-                *(to + to_index) = *(from + from_index);  // Copy pixel
-                from_index += 1;                          // Move to the next pixel in the source
-                to_index += h;                            // Move to the next pixel in the destination
-            }
-        }
-        break;
-    default:
-        break;                                             // Do nothing for unsupported rotation angles
-    }
+    int64_t start = esp_timer_get_time();
+    ulTaskNotifyValueClear(NULL, ULONG_MAX);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    lvgl_port_perf_vsync(esp_timer_get_time() - start);
 }
-#endif /* EXAMPLE_LVGL_PORT_ROTATION_DEGREE */
+#endif
 
 #if LVGL_PORT_AVOID_TEAR_ENABLE
 #if LVGL_PORT_DIRECT_MODE
 #if EXAMPLE_LVGL_PORT_ROTATION_DEGREE != 0
 
-// Structure to store information about dirty areas that need refreshing
+#define LVGL_PORT_DIRTY_RECT_MAX    (16)                  // Maximum number of stale rectangles tracked per frame buffer
+
+// Structure to store the areas of one RGB frame buffer that no longer match LVGL's buffer
 typedef struct {
-    uint16_t inv_p;                                   // Number of invalid areas
-    uint8_t inv_area_joined[LV_INV_BUF_SIZE];       // Array to track joined invalid areas
-    lv_area_t inv_areas[LV_INV_BUF_SIZE];            // Array of invalid areas
-} lv_port_dirty_area_t;
-
-// Enumeration for flush status
-typedef enum {
-    FLUSH_STATUS_PART,                                // Partial flush
-    FLUSH_STATUS_FULL                                 // Full flush
-} lv_port_flush_status_t;
-
-// Enumeration for flush probe results
-typedef enum {
-    FLUSH_PROBE_PART_COPY,                           // Probe result for partial copy
-    FLUSH_PROBE_SKIP_COPY,                           // Probe result to skip copy
-    FLUSH_PROBE_FULL_COPY,                           // Probe result for full copy
-} lv_port_flush_probe_t;
-
-static lv_port_dirty_area_t dirty_area;             // Instance of dirty area structure
-
-// Function to save the current dirty area information
-static void flush_dirty_save(lv_port_dirty_area_t *dirty_area)
+    uint16_t cnt;                                     // Number of stale rectangles
+    lv_area_t rects[LVGL_PORT_DIRTY_RECT_MAX];        // Stale rectangles, in LVGL coordinates
+} lv_port_dirty_region_t;
+
+static void *rgb_fb[2] = { NULL };                    // The two RGB frame buffers
+static int rgb_next_fb = 0;                           // Index of the frame buffer to fill next
+static lv_port_dirty_region_t rgb_fb_dirty[2];        // Stale areas of each RGB frame buffer
+
+static void dirty_region_remove(lv_port_dirty_region_t *region, int i)
 {
-    lv_disp_t *disp = _lv_refr_get_disp_refreshing(); // Get the currently refreshing display
-    dirty_area->inv_p = disp->inv_p;                  // Save the number of invalid areas
-    for (int i = 0; i < disp->inv_p; i++) {
-        dirty_area->inv_area_joined[i] = disp->inv_area_joined[i]; // Save joined areas status
-        dirty_area->inv_areas[i] = disp->inv_areas[i]; // Save invalid areas
-    }
+    region->rects[i] = region->rects[--region->cnt];  // Order doesn't matter, move the last one here
 }
 
 /**
- * @brief Probe dirty area to copy
+ * @brief Add an area to the stale region of a frame buffer
  *
- * @note This function is used to avoid tearing effect, and only works with LVGL direct mode.
+ * Rectangles are merged whenever their bounding box is not larger than the two of them,
+ * so overlapping updates (e.g. a fade redrawing the same area every frame) are copied once.
  *
  */
-static lv_port_flush_probe_t flush_copy_probe(lv_disp_drv_t *drv)
+static void dirty_region_add(lv_port_dirty_region_t *region, const lv_area_t *area)
 {
-    static lv_port_flush_status_t prev_status = FLUSH_STATUS_PART; // Previous flush status
-    lv_port_flush_status_t cur_status;                            // Current flush status
-    lv_port_flush_probe_t probe_result;                           // Result of the probe
-    lv_disp_t *disp_refr = _lv_refr_get_disp_refreshing();       // Get the currently refreshing display
-
-    uint32_t flush_ver = 0;                                       // Vertical size to flush
-    uint32_t flush_hor = 0;                                       // Horizontal size to flush
-    for (int i = 0; i < disp_refr->inv_p; i++) {
-        if (disp_refr->inv_area_joined[i] == 0) {
-            flush_ver = (disp_refr->inv_areas[i].y2 + 1 - disp_refr->inv_areas[i].y1); // Calculate vertical flush size
-            flush_hor = (disp_refr->inv_areas[i].x2 + 1 - disp_refr->inv_areas[i].x1); // Calculate horizontal flush size
-            break; // Exit the loop after finding the first unjoined area
+    lv_area_t merged = *area;
+    bool joined = true;
+
+    while (joined) {
+        joined = false;
+        for (int i = 0; i < region->cnt; i++) {
+            if (_lv_area_is_in(&merged, &region->rects[i], 0)) {
+                return; // Already stale
+            }
+            if (!_lv_area_is_on(&merged, &region->rects[i])) {
+                continue;
+            }
+            lv_area_t join;
+            _lv_area_join(&join, &merged, &region->rects[i]);
+            if (lv_area_get_size(&join) <= lv_area_get_size(&merged) + lv_area_get_size(&region->rects[i])) {
+                merged = join;
+                dirty_region_remove(region, i);
+                joined = true; // The bigger rectangle may now touch others
+                break;
+            }
         }
     }
-    /* Check if the current full screen refreshes */
-    cur_status = ((flush_ver == drv->ver_res) && (flush_hor == drv->hor_res)) ? (FLUSH_STATUS_FULL) : (FLUSH_STATUS_PART);
-
-    // Determine the probe result based on previous and current status
-    if (prev_status == FLUSH_STATUS_FULL) {
-        if ((cur_status == FLUSH_STATUS_PART)) {
-            probe_result = FLUSH_PROBE_FULL_COPY; // Full copy needed
-        } else {
-            probe_result = FLUSH_PROBE_SKIP_COPY; // Skip copy
+
+    if (region->cnt == LVGL_PORT_DIRTY_RECT_MAX) {
+        // No room left: fold into the rectangle that grows the least
+        int best = 0;
+        uint32_t best_growth = UINT32_MAX;
+        for (int i = 0; i < region->cnt; i++) {
+            lv_area_t join;
+            _lv_area_join(&join, &merged, &region->rects[i]);
+            uint32_t growth = lv_area_get_size(&join) - lv_area_get_size(&region->rects[i]);
+            if (growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
         }
-    } else {
-        probe_result = FLUSH_PROBE_PART_COPY; // Partial copy needed
+        _lv_area_join(&merged, &merged, &region->rects[best]);
+        dirty_region_remove(region, best);
     }
-    prev_status = cur_status; // Update previous status
-
-    return probe_result; // Return the result of the probe
+    region->rects[region->cnt++] = merged;
 }
 
-// Inline function to get the next buffer for flushing
-static inline void *flush_get_next_buf(void *panel_handle)
+// Mark the whole screen as stale in both frame buffers
+static void dirty_region_init(esp_lcd_panel_handle_t panel_handle)
 {
-    return get_next_frame_buffer(panel_handle); // Return the next frame buffer
+    ESP_ERROR_CHECK(esp_lcd_rgb_panel_get_frame_buffer(panel_handle, 2, &rgb_fb[0], &rgb_fb[1])); // Get the frame buffers
+    rgb_next_fb = 1;                                  // The first frame buffer is on screen at start
+
+    lv_area_t screen = { 0, 0, LV_HOR_RES - 1, LV_VER_RES - 1 };
+    for (int i = 0; i < 2; i++) {
+        rgb_fb_dirty[i].cnt = 0;
+        dirty_region_add(&rgb_fb_dirty[i], &screen);
+    }
 }
 
 /**
- * @brief Copy dirty area
+ * @brief Bring a frame buffer up to date by copying its stale areas
  *
  * @note This function is used to avoid tearing effect, and only works with LVGL direct mode.
+ *       LVGL's own buffer always holds the complete current frame, so it is the source of every copy.
  *
  */
-static void flush_dirty_copy(void *dst, void *src, lv_port_dirty_area_t *dirty_area)
+static void flush_dirty_copy(void *dst, void *src, lv_port_dirty_region_t *region)
 {
-    lv_coord_t x_start, x_end, y_start, y_end; // Coordinates for the area to be copied
-    for (int i = 0; i < dirty_area->inv_p; i++) {
-        /* Refresh the unjoined areas */
-        if (dirty_area->inv_area_joined[i] == 0) {
-            x_start = dirty_area->inv_areas[i].x1; // Start X coordinate
-            x_end = dirty_area->inv_areas[i].x2;   // End X coordinate
-            y_start = dirty_area->inv_areas[i].y1; // Start Y coordinate
-            y_end = dirty_area->inv_areas[i].y2;   // End Y coordinate
-
-            // Rotate and copy pixel data from source to destination buffer
-            rotate_copy_pixel(src, dst, x_start, y_start, x_end, y_end, LV_HOR_RES, LV_VER_RES, EXAMPLE_LVGL_PORT_ROTATION_DEGREE);
-        }
+    for (int i = 0; i < region->cnt; i++) {
+        const lv_area_t *a = &region->rects[i];
+        // Rotate and copy pixel data from source to destination buffer
+        lvgl_port_rotate_copy(src, dst, a->x1, a->y1, a->x2, a->y2, LV_HOR_RES, LV_VER_RES, EXAMPLE_LVGL_PORT_ROTATION_DEGREE);
     }
+    region->cnt = 0;
 }
 
-
 static void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
 {
     esp_lcd_panel_handle_t panel_handle = (esp_lcd_panel_handle_t) drv->user_data; // Get the panel handle from driver user data
@@ -199,67 +176,32 @@ static void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t
     const int offsetx2 = area->x2; // End X coordinate of the area to flush
     const int offsety1 = area->y1; // Start Y coordinate of the area to flush
     const int offsety2 = area->y2; // End Y coordinate of the area to flush
-    void *next_fb = NULL; // Pointer for the next frame buffer
-    lv_port_flush_probe_t probe_result = FLUSH_PROBE_PART_COPY; // Default probe result
-    lv_disp_t *disp = lv_disp_get_default(); // Get the default display
 
     /* Action after last area refresh */
     if (lv_disp_flush_is_last(drv)) {
-        /* Check if the `full_refresh` flag has been triggered */
-        if (drv->full_refresh) {
-            /* Reset flag */
-            drv->full_refresh = 0;
-
-            // Rotate and copy data from the whole screen LVGL's buffer to the next frame buffer
-            next_fb = flush_get_next_buf(panel_handle);
-            rotate_copy_pixel((uint16_t *)color_map, next_fb, offsetx1, offsety1, offsetx2, offsety2, LV_HOR_RES, LV_VER_RES, EXAMPLE_LVGL_PORT_ROTATION_DEGREE);
-
-            /* Switch the current RGB frame buffer to `next_fb` */
-            esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, next_fb);
-
-            /* Wait for the current frame buffer to complete transmission */
-            ulTaskNotifyValueClear(NULL, ULONG_MAX);
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-            /* Synchronously update the dirty area for another frame buffer */
-            flush_dirty_copy(flush_get_next_buf(panel_handle), color_map, &dirty_area);
-            flush_get_next_buf(panel_handle);
-        } else {
-            /* Probe the copy method for the current dirty area */
-            probe_result = flush_copy_probe(drv);
-
-            if (probe_result == FLUSH_PROBE_FULL_COPY) {
-                /* Save current dirty area for the next frame buffer */
-                flush_dirty_save(&dirty_area);
-
-                /* Set LVGL full-refresh flag and set flush ready in advance */
-                drv->full_refresh = 1; // Indicate that a full refresh is required
-                disp->rendering_in_progress = false; // Mark rendering as not in progress
-                lv_disp_flush_ready(drv); // Mark flush as ready
-
-                /* Force to refresh the whole screen, will invoke `flush_callback` recursively */
-                lv_refr_now(_lv_refr_get_disp_refreshing());
-            } else {
-                /* Update current dirty area for the next frame buffer */
-                next_fb = flush_get_next_buf(panel_handle);
-                flush_dirty_save(&dirty_area);
-                flush_dirty_copy(next_fb, color_map, &dirty_area);
-
-                /* Switch the current RGB frame buffer to `next_fb` */
-                esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, next_fb);
-
-                /* Wait for the current frame buffer to complete transmission */
-                ulTaskNotifyValueClear(NULL, ULONG_MAX);
-                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-                if (probe_result == FLUSH_PROBE_PART_COPY) {
-                    /* Synchronously update the dirty area for another frame buffer */
-                    flush_dirty_save(&dirty_area);
-                    flush_dirty_copy(flush_get_next_buf(panel_handle), color_map, &dirty_area);
-                    flush_get_next_buf(panel_handle);
-                }
+        if (rgb_fb[0] == NULL) {
+            dirty_region_init(panel_handle);
+        }
+
+        /* Everything redrawn in this frame is now stale in both frame buffers */
+        lv_disp_t *disp_refr = _lv_refr_get_disp_refreshing(); // Get the currently refreshing display
+        for (int i = 0; i < disp_refr->inv_p; i++) {
+            if (disp_refr->inv_area_joined[i] == 0) {
+                dirty_region_add(&rgb_fb_dirty[0], &disp_refr->inv_areas[i]);
+                dirty_region_add(&rgb_fb_dirty[1], &disp_refr->inv_areas[i]);
             }
         }
+
+        /* Only copy what is stale in the next frame buffer: this frame plus what it missed before */
+        void *next_fb = rgb_fb[rgb_next_fb];
+        flush_dirty_copy(next_fb, color_map, &rgb_fb_dirty[rgb_next_fb]);
+
+        /* Switch the current RGB frame buffer to `next_fb` */
+        esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, next_fb);
+        rgb_next_fb ^= 1;
+
+        /* Wait for the current frame buffer to complete transmission */
+        wait_for_vsync();
     }
 
     lv_disp_flush_ready(drv); // Mark the display flush as complete
@@ -281,8 +223,7 @@ static void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t
         esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map);
 
         /* Wait for the last frame buffer to complete transmission */
-        ulTaskNotifyValueClear(NULL, ULONG_MAX);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        wait_for_vsync();
     }
 
     lv_disp_flush_ready(drv); // Mark the display flush as complete
@@ -303,8 +244,7 @@ static void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t
     esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map);
 
     /* Wait for the last frame buffer to complete transmission */
-    ulTaskNotifyValueClear(NULL, ULONG_MAX);
-    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    wait_for_vsync();
 
     lv_disp_flush_ready(drv); // Mark the display flush as complete
 }
@@ -329,7 +269,7 @@ void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color
     void *next_fb = get_next_frame_buffer(panel_handle); // Get the next frame buffer
 
     /* Rotate and copy dirty area from the current LVGL's buffer to the next RGB frame buffer */
-    rotate_copy_pixel((uint16_t *)color_map, next_fb, offsetx1, offsety1, offsetx2, offsety2, LV_HOR_RES, LV_VER_RES, EXAMPLE_LVGL_PORT_ROTATION_DEGREE);
+    lvgl_port_rotate_copy((uint16_t *)color_map, next_fb, offsetx1, offsety1, offsetx2, offsety2, LV_HOR_RES, LV_VER_RES, EXAMPLE_LVGL_PORT_ROTATION_DEGREE);
 
     /* Switch the current RGB frame buffer to `next_fb` */
     esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, next_fb);
@@ -422,31 +362,74 @@ static lv_disp_t *display_init(esp_lcd_panel_handle_t panel_handle)
     disp_drv.full_refresh = 1; // Enable full refresh
 #elif LVGL_PORT_DIRECT_MODE
     disp_drv.direct_mode = 1; // Enable direct mode
+#endif
+#if LVGL_PORT_DMA_DRAW
+    lvgl_port_draw_attach(&disp_drv); // Draw large fills and copies with the GDMA
 #endif
     return lv_disp_drv_register(&disp_drv); // Register the display driver
 }
 
-static void touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data)
+// Add a timer to the triggered set. Returns false if it was already pending or the set is full.
+static bool trigger_add(lv_timer_t *timer, bool *full)
 {
-    esp_lcd_touch_handle_t tp = (esp_lcd_touch_handle_t)indev_drv->user_data; // Get touchpad handle from user data
-    assert(tp); // Ensure touchpad handle is valid
+    bool added = false;
+    int i;
+
+    taskENTER_CRITICAL(&trigger_lock);
+    for (i = 0; i < triggered_cnt && triggered[i] != timer; i++);
+    if (i == triggered_cnt && triggered_cnt < LVGL_PORT_TRIGGER_MAX) {
+        triggered[triggered_cnt++] = timer;
+        added = true;
+    }
+    *full = (i == triggered_cnt) && !added;
+    taskEXIT_CRITICAL(&trigger_lock);
+    return added;
+}
 
-    uint16_t touchpad_x; // Variable for X coordinate
-    uint16_t touchpad_y; // Variable for Y coordinate
-    uint8_t touchpad_cnt = 0; // Variable for touch count
+// Resume and run the triggered timers, in the LVGL task with the mutex held
+static void trigger_run(void)
+{
+    lv_timer_t *timers[LVGL_PORT_TRIGGER_MAX];
+    int cnt;
+
+    taskENTER_CRITICAL(&trigger_lock);
+    cnt = triggered_cnt;
+    memcpy(timers, triggered, cnt * sizeof(timers[0]));
+    triggered_cnt = 0;
+    taskEXIT_CRITICAL(&trigger_lock);
+
+    for (int i = 0; i < cnt; i++) {
+        lv_timer_resume(timers[i]);
+        lv_timer_ready(timers[i]);
+    }
+}
 
-    /* Read data from touch controller into memory */
-    esp_lcd_touch_read_data(tp); // Read data from touch controller
+static void touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data)
+{
+    lvgl_port_touch_sample_t sample; // Latest sample of the touch task
+    lv_indev_t *indev = lv_indev_get_act(); // The device being read
 
-    /* Read data from touch controller */
-    bool touchpad_pressed = esp_lcd_touch_get_coordinates(tp, &touchpad_x, &touchpad_y, NULL, &touchpad_cnt, 1); // Get touch coordinates
-    if (touchpad_pressed && touchpad_cnt > 0) {
-        data->point.x = touchpad_x; // Set the X coordinate
-        data->point.y = touchpad_y; // Set the Y coordinate
+    if (lvgl_port_touch_get(&sample)) {
+        data->point.x = sample.x; // Set the X coordinate
+        data->point.y = sample.y; // Set the Y coordinate
         data->state = LV_INDEV_STATE_PRESSED; // Set state to pressed
-        ESP_LOGD(TAG, "Touch position: %d,%d", touchpad_x, touchpad_y); // Log touch position
-    } else {
-        data->state = LV_INDEV_STATE_RELEASED; // Set state to released
+        ESP_LOGD(TAG, "Touch position: %d,%d", sample.x, sample.y); // Log touch position
+        return;
+    }
+
+    data->state = LV_INDEV_STATE_RELEASED; // Set state to released
+    if (indev->proc.state == LV_INDEV_STATE_PRESSED) {
+        // Throw the scroll with the velocity the finger left with, measured over every sample of
+        // the touch task instead of the last two positions LVGL read. LVGL moves it once per read.
+        int32_t vx, vy;
+        uint32_t period_ms = indev_drv->read_timer->period;
+        lvgl_port_touch_get_velocity(&vx, &vy);
+        indev->proc.types.pointer.scroll_throw_vect.x = (lv_coord_t)(vx * (int32_t) period_ms / 1000);
+        indev->proc.types.pointer.scroll_throw_vect.y = (lv_coord_t)(vy * (int32_t) period_ms / 1000);
+        indev->proc.types.pointer.scroll_throw_vect_ori = indev->proc.types.pointer.scroll_throw_vect;
+    }
+    if (indev->proc.types.pointer.scroll_obj == NULL) {
+        lv_timer_pause(indev_drv->read_timer); // Sleep until the touch task triggers the next touch
     }
 }
 
@@ -460,11 +443,31 @@ static lv_indev_t *indev_init(esp_lcd_touch_handle_t tp)
     lv_indev_drv_init(&indev_drv_tp); // Initialize the input device driver
     indev_drv_tp.type = LV_INDEV_TYPE_POINTER; // Set the device type to pointer (touchpad)
     indev_drv_tp.read_cb = touchpad_read; // Set the read callback function
-    indev_drv_tp.user_data = tp; // Set user data to the touch panel handle
 
     return lv_indev_drv_register(&indev_drv_tp); // Register the input device driver
 }
 
+#if LVGL_PORT_TICKLESS
+// Advance the LVGL tick to the current time. Called with the LVGL mutex held, so every
+// user of the mutex sees an up-to-date tick without a periodic timer interrupt.
+static void tick_update(void)
+{
+    static uint32_t last_ms = 0; // Tick value already given to LVGL
+    uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    lv_tick_inc(now_ms - last_ms);
+    last_ms = now_ms;
+}
+
+// LVGL tick at which the next timer is due, no later than the longest sleep of the LVGL task
+static uint32_t next_due_ms(void)
+{
+    uint32_t till_next = lv_timer_get_time_till_next();
+    if (till_next > LVGL_PORT_TASK_MAX_DELAY_MS) {
+        till_next = LVGL_PORT_TASK_MAX_DELAY_MS;
+    }
+    return lv_tick_get() + till_next;
+}
+#else
 static void tick_increment(void *arg)
 {
     /* Tell LVGL how many milliseconds have elapsed */
@@ -482,6 +485,7 @@ static esp_err_t tick_init(void)
     ESP_ERROR_CHECK(esp_timer_create(&lvgl_tick_timer_args, &lvgl_tick_timer)); // Create the timer
     return esp_timer_start_periodic(lvgl_tick_timer, LVGL_PORT_TICK_PERIOD_MS * 1000); // Start the timer
 }
+#endif /* LVGL_PORT_TICKLESS */
 
 static void lvgl_port_task(void *arg)
 {
@@ -490,6 +494,7 @@ static void lvgl_port_task(void *arg)
     uint32_t task_delay_ms = LVGL_PORT_TASK_MAX_DELAY_MS; // Set initial task delay
     while (1) {
         if (lvgl_port_lock(-1)) { // Try to lock the LVGL mutex
+            trigger_run(); // Timers triggered by other tasks or interrupts since the last run
             task_delay_ms = lv_timer_handler(); // Handle LVGL timer events
             lvgl_port_unlock(); // Unlock the mutex
         }
@@ -499,17 +504,28 @@ static void lvgl_port_task(void *arg)
         } else if (task_delay_ms < LVGL_PORT_TASK_MIN_DELAY_MS) {
             task_delay_ms = LVGL_PORT_TASK_MIN_DELAY_MS;
         }
+#if LVGL_PORT_TICKLESS
+        // Sleep until the next LVGL timer is due, or until woken by lvgl_port_wake()
+        ulTaskNotifyTakeIndexed(LVGL_PORT_WAKE_NOTIFY_INDEX, pdTRUE, pdMS_TO_TICKS(task_delay_ms));
+#else
         vTaskDelay(pdMS_TO_TICKS(task_delay_ms)); // Delay the task for the calculated time
+#endif
     }
 }
 
 esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle_t tp_handle)
 {
     lv_init(); // Initialize LVGL
+#if !LVGL_PORT_TICKLESS
     ESP_ERROR_CHECK(tick_init()); // Initialize the tick timer
+#endif
 
     lv_disp_t *disp = display_init(lcd_handle); // Initialize the display
     assert(disp); // Ensure the display initialization was successful
+    lvgl_port_perf_attach(disp); // Collect render pipeline statistics
+#if LVGL_PORT_PARALLEL_RENDER
+    lvgl_port_parallel_start(portNUM_PROCESSORS); // Render the bands of each area on both cores
+#endif
 
     if (tp_handle) {
         lv_indev_t *indev = indev_init(tp_handle); // Initialize the touchpad input device
@@ -526,6 +542,7 @@ esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle
         esp_lcd_touch_set_swap_xy(tp_handle, true); // Swap X and Y coordinates
         esp_lcd_touch_set_mirror_x(tp_handle, true); // Mirror X coordinates
 #endif
+        ESP_ERROR_CHECK(lvgl_port_touch_start(tp_handle, indev->driver->read_timer)); // Read the touchpad in its own task
     }
 
     lvgl_mux = xSemaphoreCreateRecursiveMutex(); // Create a recursive mutex for LVGL
@@ -548,16 +565,58 @@ bool lvgl_port_lock(int timeout_ms)
     assert(lvgl_mux && "lvgl_port_init must be called first"); // Ensure the mutex is initialized
 
     const TickType_t timeout_ticks = (timeout_ms < 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms); // Convert timeout to ticks
-    return xSemaphoreTakeRecursive(lvgl_mux, timeout_ticks) == pdTRUE; // Try to take the mutex
+    int64_t start = esp_timer_get_time(); // Start of the wait, for the statistics
+    if (xSemaphoreTakeRecursive(lvgl_mux, timeout_ticks) != pdTRUE) { // Try to take the mutex
+        return false;
+    }
+    lvgl_port_perf_lock(esp_timer_get_time() - start); // Record the wait, now that the statistics are ours
+#if LVGL_PORT_TICKLESS
+    tick_update(); // There is no tick interrupt, bring the tick up to date
+#endif
+    return true;
 }
 
 void lvgl_port_unlock(void)
 {
     assert(lvgl_mux && "lvgl_port_init must be called first"); // Ensure the mutex is initialized
+#if LVGL_PORT_TICKLESS
+    // Wake the LVGL task only if another task made a timer due before the LVGL task would wake
+    // anyway, e.g. by invalidating an area, which resumes the refresh timer
+    bool wake = false;
+    if (xTaskGetCurrentTaskHandle() == lvgl_task_handle) {
+        lvgl_due_ms = next_due_ms();
+    } else {
+        wake = (int32_t)(next_due_ms() - lvgl_due_ms) < 0;
+    }
+    xSemaphoreGiveRecursive(lvgl_mux); // Release the mutex
+    if (wake) {
+        lvgl_port_wake();
+    }
+#else
     xSemaphoreGiveRecursive(lvgl_mux); // Release the mutex
+#endif
+}
+
+void lvgl_port_wake(void)
+{
+#if LVGL_PORT_TICKLESS
+    if (lvgl_task_handle) {
+        xTaskNotifyGiveIndexed(lvgl_task_handle, LVGL_PORT_WAKE_NOTIFY_INDEX); // Wake the LVGL task
+    }
+#endif
+}
+
+void lvgl_port_trigger_timer(lv_timer_t *timer)
+{
+    bool full;
+    if (trigger_add(timer, &full)) {
+        lvgl_port_wake();
+    } else if (full) {
+        ESP_LOGW(TAG, "More than %d triggered timers", LVGL_PORT_TRIGGER_MAX);
+    }
 }
 
-bool lvgl_port_notify_rgb_vsync(void)
+IRAM_ATTR bool lvgl_port_notify_rgb_vsync(void)
 {
     BaseType_t need_yield = pdFALSE; // Flag to check if a yield is needed
 #if LVGL_PORT_FULL_REFRESH && (LVGL_PORT_LCD_RGB_BUFFER_NUMS == 3) && (EXAMPLE_LVGL_PORT_ROTATION_DEGREE == 0)
@@ -35,6 +35,9 @@ extern "C" {
 #define LVGL_PORT_TASK_PRIORITY     (CONFIG_EXAMPLE_LVGL_PORT_TASK_PRIORITY)        // The priority of the LVGL timer task
 #define LVGL_PORT_TASK_CORE         (CONFIG_EXAMPLE_LVGL_PORT_TASK_CORE)            // The core of the LVGL timer task,
 // `-1` means the don't specify the core
+#define LVGL_PORT_TICKLESS          (CONFIG_EXAMPLE_LVGL_PORT_TICKLESS)             // Set to 1 to sleep until the next LVGL timer or a wakeup
+#define LVGL_PORT_WAKE_NOTIFY_INDEX (1)                                             // Task notification index used for wakeups (0 is the vsync)
+#define LVGL_PORT_TRIGGER_MAX       (8)                                             // Maximum number of timers pending in lvgl_port_trigger_timer()
 /**
  *
  * LVGL buffer related parameters, can be adjusted by users:
@@ -145,9 +148,35 @@ bool lvgl_port_lock(int timeout_ms);
  */
 void lvgl_port_unlock(void);
 
+/**
+ * @brief Wake the LVGL task
+ *
+ * In tickless mode the LVGL task sleeps until its next timer is due. lvgl_port_unlock() already
+ * wakes it when another task made a timer due earlier; call this after making LVGL work pending
+ * by other means.
+ *
+ */
+void lvgl_port_wake(void);
+
+/**
+ * @brief Resume a timer and run it at the next wakeup of the LVGL task, which is woken now
+ *
+ * Can be called from any task without taking the LVGL mutex, e.g. by a producer that queues
+ * data for a timer which pauses itself when there is nothing to do.
+ *
+ * @note The timer must not be deleted while a trigger may be pending.
+ *
+ * @param[in] timer: Timer to run
+ *
+ */
+void lvgl_port_trigger_timer(lv_timer_t *timer);
+
 /**
  * @brief Notifies the LVGL task when the transmission of the RGB frame buffer is completed.
  *
+ * @note Called from the vsync ISR, which stays enabled while the flash is written
+ *       (CONFIG_LCD_RGB_ISR_IRAM_SAFE), so it is placed in IRAM.
+ *
  * @return
  *      - true:  The tasks need to be re-scheduled
  *      - false: The tasks don't need to be re-scheduled
@@ -0,0 +1,218 @@
+#include <string.h>
+#include "lvgl_port_blend.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+#include "sdkconfig.h"
+#else
+#define IRAM_ATTR                                         // Host builds (benchmark, simulator)
+#endif
+
+#if CONFIG_EXAMPLE_LVGL_PORT_BLEND_PIE
+#define BLEND_PIE   1
+#define PIE_BLOCK   8                                     // Pixels per 128-bit PIE register
+
+// PIE kernels of lvgl_port_blend_s3.S. `dest` (and `src`) are 16-byte aligned, `blocks` is in PIE_BLOCK pixels.
+void lvgl_port_blend_fill_s3(uint16_t *dest, const uint16_t *color, uint32_t blocks);
+void lvgl_port_blend_copy_s3(uint16_t *dest, const uint16_t *src, uint32_t blocks);
+#else
+#define BLEND_PIE   0
+#endif
+
+#define PIE_MIN_W   32                                    // Narrower rows don't pay for the alignment head and tail
+
+/*
+ * Channel arithmetic on packed pixels: red and blue share one 32-bit word, red in bits 16..28 and
+ * blue in bits 0..12, so both are weighted with a single multiply. A weighted channel is at most
+ * 63 * 255 + 128 < 2^14, so the halves never carry into each other.
+ */
+#define RB_SPLIT(c)     ((((uint32_t)(c) & 0xF800) << 5) | ((uint32_t)(c) & 0x001F))
+#define G_SPLIT(c)      (((uint32_t)(c) >> 5) & 0x3F)
+#define RB_ROUND        0x00800080u
+
+// x / 255 in both halves, as LV_UDIV255() does per channel: exact for x < 65535
+#define RB_DIV255(x)    ((((x) + 0x00010001u + (((x) >> 8) & 0x00FF00FFu)) >> 8) & 0x001F001Fu)
+#define G_DIV255(x)     (((x) + 1 + ((x) >> 8)) >> 8)
+
+#define RB_G_JOIN(rb, g) ((uint16_t)((((rb) >> 5) & 0xF800) | ((g) << 5) | ((rb) & 0x001F)))
+
+/**
+ * @brief lv_color_mix(): `mix` of `fg` and `255 - mix` of `bg`
+ */
+static inline uint16_t mix_px(uint16_t fg, uint16_t bg, uint32_t mix)
+{
+    uint32_t inv = 255 - mix;
+    uint32_t rb = RB_SPLIT(fg) * mix + RB_SPLIT(bg) * inv + RB_ROUND;
+    uint32_t g = G_SPLIT(fg) * mix + G_SPLIT(bg) * inv + 128;
+    return RB_G_JOIN(RB_DIV255(rb), G_DIV255(g));
+}
+
+/**
+ * @brief The next 4 mask values as one word, if `mask` is word aligned and 4 pixels are left
+ *
+ * Masks are mostly long transparent or opaque runs (rounded corners, text outside the glyphs),
+ * which are then skipped or stored 4 pixels at a time.
+ */
+static inline bool mask_word(const uint8_t *mask, int32_t left, uint32_t *m32)
+{
+    if (left < 4 || ((uintptr_t)mask & 0x3)) {
+        return false;
+    }
+    *m32 = *(const uint32_t *)mask;
+    return *m32 == 0 || *m32 == 0xFFFFFFFF;
+}
+
+/**
+ * @brief Fill `n` pixels with 32-bit stores once `dest` is word aligned
+ */
+static inline void fill_row(uint16_t *dest, int32_t n, uint16_t color)
+{
+    if (n > 0 && ((uintptr_t)dest & 0x2)) {
+        *dest++ = color;
+        n--;
+    }
+    uint32_t c32 = color | ((uint32_t)color << 16);
+    uint32_t *d32 = (uint32_t *)dest;
+    int32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        d32[0] = c32;
+        d32[1] = c32;
+        d32[2] = c32;
+        d32[3] = c32;
+        d32 += 4;
+    }
+    for (; i + 2 <= n; i += 2) {
+        *d32++ = c32;
+    }
+    if (i < n) {
+        *(uint16_t *)d32 = color;
+    }
+}
+
+IRAM_ATTR void lvgl_port_blend_fill(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h, uint16_t color)
+{
+#if BLEND_PIE
+    if (w >= PIE_MIN_W) {
+        for (int32_t y = 0; y < h; y++) {
+            uint16_t *d = dest;
+            int32_t head = (int32_t)((16 - ((uintptr_t)d & 0xF)) & 0xF) / 2;   // RGB565 buffers are 2-byte aligned
+            fill_row(d, head, color);
+            d += head;
+            uint32_t blocks = (uint32_t)(w - head) / PIE_BLOCK;
+            lvgl_port_blend_fill_s3(d, &color, blocks);
+            d += blocks * PIE_BLOCK;
+            fill_row(d, w - head - (int32_t)blocks * PIE_BLOCK, color);
+            dest += dest_stride;
+        }
+        return;
+    }
+#endif
+    for (int32_t y = 0; y < h; y++) {
+        fill_row(dest, w, color);
+        dest += dest_stride;
+    }
+}
+
+IRAM_ATTR void lvgl_port_blend_fill_opa(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h, uint16_t color, uint8_t opa)
+{
+    // The color's share is the same for every pixel; areas are mostly a single background color,
+    // so the last result is reused while the destination doesn't change (as LVGL's loop does)
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    uint32_t inv = 255 - opa;
+    uint32_t rb_fg = RB_SPLIT(color) * opa + RB_ROUND;
+    uint32_t g_fg = G_SPLIT(color) * opa + 128;
+    uint16_t last_dest = dest[0];
+    uint16_t last_res = RB_G_JOIN(RB_DIV255(rb_fg + RB_SPLIT(last_dest) * inv), G_DIV255(g_fg + G_SPLIT(last_dest) * inv));
+
+    for (int32_t y = 0; y < h; y++) {
+        for (int32_t x = 0; x < w; x++) {
+            uint16_t px = dest[x];
+            if (px != last_dest) {
+                uint32_t rb = rb_fg + RB_SPLIT(px) * inv;
+                uint32_t g = g_fg + G_SPLIT(px) * inv;
+                last_dest = px;
+                last_res = RB_G_JOIN(RB_DIV255(rb), G_DIV255(g));
+            }
+            dest[x] = last_res;
+        }
+        dest += dest_stride;
+    }
+}
+
+IRAM_ATTR void lvgl_port_blend_fill_mask(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h, uint16_t color,
+                                         const uint8_t *mask, int32_t mask_stride)
+{
+    for (int32_t y = 0; y < h; y++) {
+        for (int32_t x = 0; x < w;) {
+            uint32_t m32;
+            if (mask_word(mask + x, w - x, &m32)) {
+                if (m32) {
+                    dest[x] = dest[x + 1] = dest[x + 2] = dest[x + 3] = color;
+                }
+                x += 4;
+                continue;
+            }
+            uint8_t m = mask[x];
+            if (m == 0xFF) {
+                dest[x] = color;
+            } else if (m) {
+                dest[x] = mix_px(color, dest[x], m);
+            }
+            x++;
+        }
+        dest += dest_stride;
+        mask += mask_stride;
+    }
+}
+
+IRAM_ATTR void lvgl_port_blend_copy(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h,
+                                    const uint16_t *src, int32_t src_stride)
+{
+    for (int32_t y = 0; y < h; y++) {
+#if BLEND_PIE
+        // Vector copy when source and destination can be 16-byte aligned together
+        if (w >= PIE_MIN_W && (((uintptr_t)dest ^ (uintptr_t)src) & 0xF) == 0) {
+            int32_t head = (int32_t)((16 - ((uintptr_t)dest & 0xF)) & 0xF) / 2;
+            uint32_t blocks = (uint32_t)(w - head) / PIE_BLOCK;
+            int32_t done = head + (int32_t)blocks * PIE_BLOCK;
+            memcpy(dest, src, head * sizeof(uint16_t));
+            lvgl_port_blend_copy_s3(dest + head, src + head, blocks);
+            memcpy(dest + done, src + done, (w - done) * sizeof(uint16_t));
+        } else
+#endif
+        {
+            memcpy(dest, src, w * sizeof(uint16_t));
+        }
+        dest += dest_stride;
+        src += src_stride;
+    }
+}
+
+IRAM_ATTR void lvgl_port_blend_map_mask(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h,
+                                        const uint16_t *src, int32_t src_stride, const uint8_t *mask, int32_t mask_stride)
+{
+    for (int32_t y = 0; y < h; y++) {
+        for (int32_t x = 0; x < w;) {
+            uint32_t m32;
+            if (mask_word(mask + x, w - x, &m32)) {
+                if (m32) {
+                    memcpy(dest + x, src + x, 4 * sizeof(uint16_t));
+                }
+                x += 4;
+                continue;
+            }
+            uint8_t m = mask[x];
+            if (m == 0xFF) {
+                dest[x] = src[x];
+            } else if (m) {
+                dest[x] = mix_px(src[x], dest[x], m);
+            }
+            x++;
+        }
+        dest += dest_stride;
+        src += src_stride;
+        mask += mask_stride;
+    }
+}
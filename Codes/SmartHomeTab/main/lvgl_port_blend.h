@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * RGB565 blend kernels of the LVGL software renderer.
+ *
+ * LVGL includes this header from lv_draw_sw_blend.c (CONFIG_LV_USE_DRAW_SW_BLEND_CUSTOM with
+ * CONFIG_LV_DRAW_SW_BLEND_CUSTOM_INCLUDE="lvgl_port_blend.h") and calls the kernels through the
+ * LV_DRAW_SW_BLEND_RGB565_... hooks at the bottom. The kernels themselves don't depend on LVGL,
+ * so the host benchmark (tools/blend_bench.c) can check them against the reference loops.
+ *
+ * Every kernel gives the same pixels as the built-in loop it replaces, with LVGL's rounding
+ * (LV_COLOR_MIX_ROUND_OFS 128): each channel is `(c1 * mix + c2 * (255 - mix) + 128) / 255`.
+ * Strides are in pixels, masks have one opacity byte per pixel.
+ */
+
+/**
+ * @brief Fill an area with a color
+ */
+void lvgl_port_blend_fill(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h, uint16_t color);
+
+/**
+ * @brief Mix a color into an area with the same opacity for every pixel
+ */
+void lvgl_port_blend_fill_opa(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h, uint16_t color, uint8_t opa);
+
+/**
+ * @brief Mix a color into an area, each pixel as opaque as its mask value
+ */
+void lvgl_port_blend_fill_mask(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h, uint16_t color,
+                               const uint8_t *mask, int32_t mask_stride);
+
+/**
+ * @brief Copy an image area
+ */
+void lvgl_port_blend_copy(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h,
+                          const uint16_t *src, int32_t src_stride);
+
+/**
+ * @brief Mix an image area in, each pixel as opaque as its mask value (antialiased edges, alpha maps)
+ */
+void lvgl_port_blend_map_mask(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h,
+                              const uint16_t *src, int32_t src_stride, const uint8_t *mask, int32_t mask_stride);
+
+#ifdef LV_COLOR_MIX_ROUND_OFS
+#if LV_COLOR_MIX_ROUND_OFS != 128
+#error "lvgl_port_blend.h: the kernels round like LV_COLOR_MIX_ROUND_OFS 128"
+#endif
+
+#define LV_DRAW_SW_BLEND_RGB565_FILL(dest_buf, dest_stride, w, h, color) \
+    (lvgl_port_blend_fill(&(dest_buf)->full, dest_stride, w, h, (color).full), LV_RES_OK)
+
+#define LV_DRAW_SW_BLEND_RGB565_FILL_OPA(dest_buf, dest_stride, w, h, color, opa) \
+    (lvgl_port_blend_fill_opa(&(dest_buf)->full, dest_stride, w, h, (color).full, opa), LV_RES_OK)
+
+#define LV_DRAW_SW_BLEND_RGB565_FILL_MASK(dest_buf, dest_stride, w, h, color, mask, mask_stride) \
+    (lvgl_port_blend_fill_mask(&(dest_buf)->full, dest_stride, w, h, (color).full, mask, mask_stride), LV_RES_OK)
+
+#define LV_DRAW_SW_BLEND_RGB565_COPY(dest_buf, dest_stride, w, h, src_buf, src_stride) \
+    (lvgl_port_blend_copy(&(dest_buf)->full, dest_stride, w, h, &(src_buf)->full, src_stride), LV_RES_OK)
+
+#define LV_DRAW_SW_BLEND_RGB565_MAP_MASK(dest_buf, dest_stride, w, h, src_buf, src_stride, mask, mask_stride) \
+    (lvgl_port_blend_map_mask(&(dest_buf)->full, dest_stride, w, h, &(src_buf)->full, src_stride, mask, mask_stride), LV_RES_OK)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,140 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_async_memcpy.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_idf_version.h"
+#include "esp_log.h"
+#include "esp_memory_utils.h"
+#include "lvgl_port_dma.h"
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0)
+#include "esp_cache.h"
+#define DMA_AVAILABLE   (1)
+#else
+#define DMA_AVAILABLE   (0)                               // No esp_cache_msync() to keep PSRAM coherent
+#endif
+
+#define DMA_BACKLOG     (16)                              // Copies queued in the driver at most
+
+static const char *TAG = "lv_dma";
+
+static async_memcpy_handle_t mcp;                         // NULL until lvgl_port_dma_init() succeeds
+static SemaphoreHandle_t slots;                           // One per free place in the driver's queue
+static SemaphoreHandle_t wait_mux;                        // One waiter at a time: two would share out the slots
+
+static IRAM_ATTR bool copy_done(async_memcpy_handle_t mcp_hdl, async_memcpy_event_t *event, void *cb_args)
+{
+    BaseType_t need_yield = pdFALSE;
+    xSemaphoreGiveFromISR(slots, &need_yield);
+    return need_yield == pdTRUE;
+}
+
+bool lvgl_port_dma_init(void)
+{
+#if DMA_AVAILABLE
+    if (mcp) {
+        return true;
+    }
+    slots = xSemaphoreCreateCounting(DMA_BACKLOG, DMA_BACKLOG);
+    wait_mux = xSemaphoreCreateMutex();
+    if (slots == NULL || wait_mux == NULL) {
+        if (slots) {
+            vSemaphoreDelete(slots);
+        }
+        if (wait_mux) {
+            vSemaphoreDelete(wait_mux);
+        }
+        return false;
+    }
+
+    async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    config.backlog = DMA_BACKLOG;
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 4, 0)
+    config.dma_burst_size = LVGL_PORT_DMA_ALIGN / 2;
+#else
+    config.psram_trans_align = LVGL_PORT_DMA_ALIGN / 2;
+    config.sram_trans_align = 4;
+#endif
+    esp_err_t err = esp_async_memcpy_install(&config, &mcp);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Async memcpy unavailable: %s", esp_err_to_name(err));
+        vSemaphoreDelete(slots);
+        vSemaphoreDelete(wait_mux);
+        mcp = NULL;
+        return false;
+    }
+    return true;
+#else
+    ESP_LOGW(TAG, "Drawing with DMA needs ESP-IDF 5.2 or later");
+    return false;
+#endif
+}
+
+void *lvgl_port_dma_alloc(size_t size)
+{
+    // Internal RAM: not cached, so the CPU's writes are visible to the engine at once
+    return heap_caps_aligned_alloc(LVGL_PORT_DMA_ALIGN, size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+}
+
+void lvgl_port_dma_free(void *buf)
+{
+    heap_caps_free(buf);
+}
+
+bool lvgl_port_dma_copy(void *dst, const void *src, size_t size)
+{
+#if DMA_AVAILABLE
+    if (mcp == NULL || (((uintptr_t)dst | size) & (LVGL_PORT_DMA_ALIGN - 1)) != 0) {
+        return false;
+    }
+
+    bool dst_ext = esp_ptr_external_ram(dst);
+    bool src_ext = esp_ptr_external_ram(src);
+    if (!dst_ext && !esp_ptr_dma_capable(dst)) {
+        return false;
+    }
+    // Images in flash can't be read by the GDMA
+    if (src_ext ? ((uintptr_t)src & (LVGL_PORT_DMA_ALIGN - 1)) != 0 : (!esp_ptr_dma_capable(src) || ((uintptr_t)src & 0x3))) {
+        return false;
+    }
+
+    // The engine works on PSRAM itself: the source must be written back first, and the
+    // destination dropped from the cache so no stale line hides or later overwrites the copy.
+    // Nothing is queued yet if a sync fails, the CPU copies instead
+    esp_err_t err;
+    if (src_ext && (err = esp_cache_msync((void *)src, size, ESP_CACHE_MSYNC_FLAG_DIR_C2M)) != ESP_OK) {
+        ESP_LOGD(TAG, "Source sync failed: %s", esp_err_to_name(err));
+        return false;
+    }
+    if (dst_ext && (err = esp_cache_msync(dst, size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE)) != ESP_OK) {
+        ESP_LOGD(TAG, "Destination sync failed: %s", esp_err_to_name(err));
+        return false;
+    }
+
+    xSemaphoreTake(slots, portMAX_DELAY);
+    if (esp_async_memcpy(mcp, dst, (void *)src, size, copy_done, NULL) != ESP_OK) {
+        xSemaphoreGive(slots);
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void lvgl_port_dma_wait(void)
+{
+    if (mcp == NULL || uxSemaphoreGetCount(slots) == DMA_BACKLOG) {
+        return;
+    }
+    // Every slot comes back once its copy is done
+    xSemaphoreTake(wait_mux, portMAX_DELAY);
+    for (int i = 0; i < DMA_BACKLOG; i++) {
+        xSemaphoreTake(slots, portMAX_DELAY);
+    }
+    for (int i = 0; i < DMA_BACKLOG; i++) {
+        xSemaphoreGive(slots);
+    }
+    xSemaphoreGive(wait_mux);
+}
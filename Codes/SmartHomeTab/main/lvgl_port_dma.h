@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LVGL_PORT_DMA_ALIGN     (64)    // Alignment of the destination and size of every copy, in bytes (PSRAM burst and cache line)
+
+/*
+ * Asynchronous memory copy engine used by the draw context of lvgl_port_draw.c.
+ *
+ * On the ESP32-S3 it is the async memcpy driver (GDMA); the simulator implements the same
+ * functions with a worker thread (sim/sim_dma.c). Copies run in the order they are queued.
+ */
+
+/**
+ * @brief Start the copy engine
+ *
+ * @return true if copies can be queued
+ */
+bool lvgl_port_dma_init(void);
+
+/**
+ * @brief Allocate a buffer the engine can read from, aligned to LVGL_PORT_DMA_ALIGN
+ */
+void *lvgl_port_dma_alloc(size_t size);
+
+/**
+ * @brief Free a buffer of lvgl_port_dma_alloc()
+ */
+void lvgl_port_dma_free(void *buf);
+
+/**
+ * @brief Queue a copy and return before it is done
+ *
+ * Blocks while the queue is full. Neither buffer may be accessed until lvgl_port_dma_wait().
+ *
+ * @param[out] dst: Destination, aligned to LVGL_PORT_DMA_ALIGN
+ * @param[in] src: Source
+ * @param[in] size: Bytes to copy, a multiple of LVGL_PORT_DMA_ALIGN
+ *
+ * @return false if the engine can't reach or align one of the buffers: nothing was queued, copy them with the CPU
+ */
+bool lvgl_port_dma_copy(void *dst, const void *src, size_t size);
+
+/**
+ * @brief Wait until every queued copy is done
+ */
+void lvgl_port_dma_wait(void);
+
+#ifdef __cplusplus
+}
+#endif
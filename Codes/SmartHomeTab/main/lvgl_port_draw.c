@@ -0,0 +1,198 @@
+#include "lvgl_port_draw.h"
+
+#if LVGL_PORT_DMA_DRAW
+
+#include "src/misc/lv_gc.h"
+#include "lvgl_port_dma.h"
+
+#define ALIGN_PX    (LVGL_PORT_DMA_ALIGN / sizeof(lv_color_t))
+
+_Static_assert(sizeof(lv_color_t) == sizeof(uint16_t), "DMA drawing is written for RGB565");
+
+// True if `p` is in one of LVGL's scratch buffers (lv_mem_buf_get()), which are reused
+// (or reallocated) as soon as the blend returns. Every band of a parallel refresh has its own.
+static bool in_scratch_buf(const void *p)
+{
+    const lv_mem_buf_t *bufs = _lv_scratch_get()->mem_buf;
+    for (int i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
+        const lv_mem_buf_t *buf = &bufs[i];
+        if (buf->p && (const uint8_t *)p >= (const uint8_t *)buf->p && (const uint8_t *)p < (const uint8_t *)buf->p + buf->size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// lv_color_fill() writes a pixel even for an empty span
+static inline void fill_span(lv_color_t *dest, lv_color_t color, lv_coord_t n)
+{
+    if (n > 0) {
+        lv_color_fill(dest, color, n);
+    }
+}
+
+/**
+ * @brief Queue the aligned middle of one row
+ *
+ * @return Pixels queued, from `dest + head`
+ */
+static lv_coord_t queue_row(lvgl_port_draw_ctx_t *ctx, lv_color_t *dest, const lv_color_t *src, lv_coord_t head, lv_coord_t w)
+{
+    size_t bytes = ((size_t)(w - head) * sizeof(lv_color_t)) & ~(size_t)(LVGL_PORT_DMA_ALIGN - 1);
+    size_t done = 0;
+
+    if (src) {
+        if (bytes && lvgl_port_dma_copy(dest + head, src + head, bytes)) {
+            done = bytes;
+        }
+    } else {
+        // A fill copies the row of the fill color as many times as needed
+        size_t chunk = (size_t)ctx->fill_row_px * sizeof(lv_color_t);
+        while (done < bytes && lvgl_port_dma_copy(dest + head + done / sizeof(lv_color_t), ctx->fill_row, LV_MIN(bytes - done, chunk))) {
+            done += LV_MIN(bytes - done, chunk);
+        }
+    }
+    ctx->busy |= done > 0;
+    return (lv_coord_t)(done / sizeof(lv_color_t));
+}
+
+/**
+ * @brief Fill (`src` NULL) or copy an area with the engine, the CPU doing the unaligned ends of the rows
+ *
+ * @return false if the engine can't take it: nothing was drawn
+ */
+static bool dma_area(lvgl_port_draw_ctx_t *ctx, lv_color_t *dest, lv_coord_t dest_stride,
+                     const lv_color_t *src, lv_coord_t src_stride, lv_coord_t w, lv_coord_t h, lv_color_t color)
+{
+    if (src == NULL) {
+        if (ctx->fill_row == NULL) {
+            return false;
+        }
+        if (!ctx->fill_row_valid || ctx->fill_color.full != color.full) {
+            if (ctx->busy) {                              // The engine may still be reading the row
+                lvgl_port_dma_wait();
+                ctx->busy = false;
+            }
+            lv_color_fill((lv_color_t *)ctx->fill_row, color, ctx->fill_row_px);
+            ctx->fill_color = color;
+            ctx->fill_row_valid = true;
+        }
+    }
+
+    for (lv_coord_t y = 0; y < h; y++) {
+        lv_coord_t head = (lv_coord_t)((ALIGN_PX - ((uintptr_t)dest / sizeof(lv_color_t)) % ALIGN_PX) % ALIGN_PX);
+        head = LV_MIN(head, w);
+        lv_coord_t queued = queue_row(ctx, dest, src, head, w);
+        if (y == 0 && queued == 0) {
+            return false;                                 // Unreachable or misaligned buffers
+        }
+
+        // The ends of the row (and whatever the engine didn't take)
+        lv_coord_t rest = head + queued;
+        if (src) {
+            lv_memcpy(dest, src, head * sizeof(lv_color_t));
+            lv_memcpy(dest + rest, src + rest, (w - rest) * sizeof(lv_color_t));
+            src += src_stride;
+        } else {
+            fill_span(dest, color, head);
+            fill_span(dest + rest, color, w - rest);
+        }
+        dest += dest_stride;
+    }
+    return true;
+}
+
+static void dma_blend(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    lvgl_port_draw_ctx_t *ctx = (lvgl_port_draw_ctx_t *)draw_ctx;
+    lv_disp_drv_t *drv = _lv_refr_get_disp_refreshing()->driver;
+    lv_area_t area;
+
+    // Only what the engine can do: a plain opaque copy or fill
+    if (dsc->opa < LV_OPA_MAX || dsc->blend_mode != LV_BLEND_MODE_NORMAL ||
+        (dsc->mask_buf && dsc->mask_res != LV_DRAW_MASK_RES_FULL_COVER) ||
+        drv->set_px_cb || drv->screen_transp ||
+        !_lv_area_intersect(&area, dsc->blend_area, draw_ctx->clip_area) ||
+        lv_area_get_width(&area) < 2 * (lv_coord_t)ALIGN_PX ||
+        lv_area_get_size(&area) < LVGL_PORT_DMA_DRAW_MIN_PX) {
+        lv_draw_sw_blend_basic(draw_ctx, dsc);
+        return;
+    }
+
+    lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
+    lv_color_t *dest = draw_ctx->buf;
+    dest += dest_stride * (area.y1 - draw_ctx->buf_area->y1) + (area.x1 - draw_ctx->buf_area->x1);
+
+    const lv_color_t *src = dsc->src_buf;
+    lv_coord_t src_stride = 0;
+    if (src) {
+        src_stride = lv_area_get_width(dsc->blend_area);
+        src += src_stride * (area.y1 - dsc->blend_area->y1) + (area.x1 - dsc->blend_area->x1);
+    }
+
+    if (!dma_area(ctx, dest, dest_stride, src, src_stride, lv_area_get_width(&area), lv_area_get_height(&area), dsc->color)) {
+        lv_draw_sw_blend_basic(draw_ctx, dsc);
+        return;
+    }
+
+    // Scratch buffers (image chunks, transformed images) are rewritten right away
+    if (src && ctx->busy && in_scratch_buf(dsc->src_buf)) {
+        lvgl_port_dma_wait();
+        ctx->busy = false;
+    }
+}
+
+static void dma_wait_for_finish(lv_draw_ctx_t *draw_ctx)
+{
+    lvgl_port_draw_ctx_t *ctx = (lvgl_port_draw_ctx_t *)draw_ctx;
+    if (ctx->busy) {
+        lvgl_port_dma_wait();
+        ctx->busy = false;
+    }
+    lv_draw_sw_wait_for_finish(draw_ctx);
+}
+
+// Called before an image is opened: opening one may evict (free) the decoded image being copied
+static lv_res_t dma_draw_img(lv_draw_ctx_t *draw_ctx, const lv_draw_img_dsc_t *draw_dsc, const lv_area_t *coords, const void *src)
+{
+    LV_UNUSED(draw_dsc);
+    LV_UNUSED(coords);
+    LV_UNUSED(src);
+    dma_wait_for_finish(draw_ctx);
+    return LV_RES_INV;                                    // Let LVGL decode and draw it
+}
+
+static void draw_ctx_init(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
+{
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+
+    lvgl_port_draw_ctx_t *ctx = (lvgl_port_draw_ctx_t *)draw_ctx;
+    ctx->fill_row_px = (lv_coord_t)LV_MAX(ALIGN_PX, (drv->hor_res + ALIGN_PX - 1) / ALIGN_PX * ALIGN_PX);
+    ctx->fill_row = lvgl_port_dma_alloc(ctx->fill_row_px * sizeof(lv_color_t));
+    ctx->fill_row_valid = false;
+    ctx->busy = false;
+
+    ctx->base_sw.blend = dma_blend;
+    ctx->base_sw.base_draw.draw_img = dma_draw_img;
+    ctx->base_sw.base_draw.wait_for_finish = dma_wait_for_finish;
+}
+
+static void draw_ctx_deinit(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
+{
+    lvgl_port_draw_ctx_t *ctx = (lvgl_port_draw_ctx_t *)draw_ctx;
+    dma_wait_for_finish(draw_ctx);
+    lvgl_port_dma_free(ctx->fill_row);
+    lv_draw_sw_deinit_ctx(drv, draw_ctx);
+}
+
+void lvgl_port_draw_attach(lv_disp_drv_t *drv)
+{
+    if (!lvgl_port_dma_init()) {
+        return;
+    }
+    drv->draw_ctx_init = draw_ctx_init;
+    drv->draw_ctx_deinit = draw_ctx_deinit;
+    drv->draw_ctx_size = sizeof(lvgl_port_draw_ctx_t);
+}
+
+#endif /* LVGL_PORT_DMA_DRAW */
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lvgl.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LVGL_PORT_DMA_DRAW          (CONFIG_EXAMPLE_LVGL_PORT_DMA_DRAW)         // Set to 1 to draw large fills and copies with the DMA
+#define LVGL_PORT_DMA_DRAW_MIN_PX   (CONFIG_EXAMPLE_LVGL_PORT_DMA_DRAW_MIN_PX)  // Smaller areas are drawn by the CPU
+
+#if LVGL_PORT_DMA_DRAW
+
+/**
+ * Software draw context whose opaque fills and copies go to the copy engine of lvgl_port_dma.h
+ *
+ */
+typedef struct {
+    lv_draw_sw_ctx_t base_sw;
+    uint16_t *fill_row;                         // Pixels of the fill color, source of the DMA fills
+    lv_coord_t fill_row_px;                     // Size of `fill_row`
+    lv_color_t fill_color;                      // Color in `fill_row`
+    bool fill_row_valid;
+    bool busy;                                  // Copies are queued since the last wait
+} lvgl_port_draw_ctx_t;
+
+/**
+ * @brief Draw with lvgl_port_draw_ctx_t on a display
+ *
+ * Sets the draw context callbacks of the driver, so it must be called before lv_disp_drv_register().
+ * Starts the copy engine; if it can't be started the display keeps LVGL's software context.
+ *
+ * A fill or copy is handed to the engine when it is opaque, unmasked and at least
+ * LVGL_PORT_DMA_DRAW_MIN_PX pixels. The CPU draws the unaligned ends of each row, and goes on with
+ * the next objects (text, masks, images) while the engine runs. The context's `wait_for_finish`
+ * waits for the engine: LVGL calls it before every CPU blend and before flushing.
+ *
+ */
+void lvgl_port_draw_attach(lv_disp_drv_t *drv);
+
+#endif /* LVGL_PORT_DMA_DRAW */
+
+#ifdef __cplusplus
+}
+#endif
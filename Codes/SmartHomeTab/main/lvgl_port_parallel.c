@@ -0,0 +1,122 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "lvgl_port.h"
+#include "lvgl_port_parallel.h"
+
+#if LVGL_PORT_PARALLEL_RENDER
+
+static const char *TAG = "lv_parallel";
+
+static TaskHandle_t helpers[LV_REFR_PARALLEL_MAX];       // helpers[i] runs worker i, helpers[0] is unused
+static uint32_t worker_cnt;
+static SemaphoreHandle_t done_sem;                        // Given by a helper when its job returned
+static SemaphoreHandle_t shared_mux;                      // LVGL's shared state, see lv_refr_lock_shared()
+static lv_refr_job_cb_t job_cb;
+static void *job_ctx;
+
+static void helper_task(void *arg)
+{
+    uint32_t worker = (uint32_t)(uintptr_t)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        job_cb(job_ctx, worker);
+        xSemaphoreGive(done_sem);
+    }
+}
+
+static void run(lv_refr_job_cb_t job, void *ctx)
+{
+    job_cb = job;
+    job_ctx = ctx;
+    for (uint32_t i = 1; i < worker_cnt; i++) {
+        xTaskNotifyGive(helpers[i]);
+    }
+    job(ctx, 0);
+    for (uint32_t i = 1; i < worker_cnt; i++) {
+        xSemaphoreTake(done_sem, portMAX_DELAY);
+    }
+}
+
+static uint32_t worker_id(void)
+{
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (uint32_t i = 1; i < worker_cnt; i++) {
+        if (helpers[i] == self) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+static void lock(void)
+{
+    xSemaphoreTakeRecursive(shared_mux, portMAX_DELAY);
+}
+
+static void unlock(void)
+{
+    xSemaphoreGiveRecursive(shared_mux);
+}
+
+bool lvgl_port_parallel_start(uint32_t workers)
+{
+    if (worker_cnt) {
+        return true;
+    }
+    workers = LV_MIN(workers, LV_MIN(portNUM_PROCESSORS, LV_REFR_PARALLEL_MAX));
+    if (workers < 2) {
+        return false;
+    }
+
+    done_sem = xSemaphoreCreateCounting(workers - 1, 0);
+    shared_mux = xSemaphoreCreateRecursiveMutex();
+    if (done_sem == NULL || shared_mux == NULL) {
+        ESP_LOGE(TAG, "No memory for the semaphores");
+        goto err;
+    }
+    for (uint32_t i = 1; i < workers; i++) {
+        char name[configMAX_TASK_NAME_LEN];
+        snprintf(name, sizeof(name), "lvgl_band%" PRIu32, i);
+        // The LVGL task floats, the helpers take the other cores
+        if (xTaskCreatePinnedToCore(helper_task, name, LVGL_PORT_TASK_STACK_SIZE, (void *)(uintptr_t)i,
+                                    LVGL_PORT_TASK_PRIORITY, &helpers[i], i % portNUM_PROCESSORS) != pdPASS) {
+            ESP_LOGE(TAG, "Failed to create the band task %" PRIu32, i);
+            goto err;
+        }
+    }
+
+    worker_cnt = workers;
+    lv_refr_parallel_t par = {
+        .run = run,
+        .worker_id = worker_id,
+        .lock = lock,
+        .unlock = unlock,
+        .worker_cnt = workers,
+    };
+    lv_refr_set_parallel(&par);
+    ESP_LOGI(TAG, "Rendering in %" PRIu32 " bands", workers);
+    return true;
+
+err:
+    for (uint32_t i = 1; i < workers; i++) {
+        if (helpers[i]) {
+            vTaskDelete(helpers[i]);
+            helpers[i] = NULL;
+        }
+    }
+    if (done_sem) {
+        vSemaphoreDelete(done_sem);
+        done_sem = NULL;
+    }
+    if (shared_mux) {
+        vSemaphoreDelete(shared_mux);
+        shared_mux = NULL;
+    }
+    return false;
+}
+
+#endif /* LVGL_PORT_PARALLEL_RENDER */
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LVGL_PORT_PARALLEL_RENDER   (CONFIG_EXAMPLE_LVGL_PORT_PARALLEL_RENDER)  // Set to 1 to render on both cores
+
+#if LVGL_PORT_PARALLEL_RENDER
+
+/**
+ * @brief Render the refreshed areas in bands on several threads (lv_refr_set_parallel())
+ *
+ * The task refreshing the display renders the first band and `workers - 1` helper threads the others. On the
+ * ESP32-S3 the helpers are tasks with the stack and priority of the LVGL task, pinned to the other
+ * core, and `workers` is capped to the number of cores; the simulator starts pthreads
+ * (sim/sim_parallel.c). `workers` is capped to LV_REFR_PARALLEL_MAX.
+ *
+ * Must be called with LVGL locked, after the display is registered.
+ *
+ * @return true if the refreshes are parallel, false if LVGL keeps rendering on the calling task
+ */
+bool lvgl_port_parallel_start(uint32_t workers);
+
+#endif /* LVGL_PORT_PARALLEL_RENDER */
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,111 @@
+#include "esp_timer.h"
+#include "lvgl_port_perf.h"
+
+#if LVGL_PORT_PERF_ENABLE
+
+static lvgl_port_perf_t perf;                             // Statistics of the current period
+
+// State of the frame being refreshed, all in the LVGL task
+static int64_t frame_flush_us;                            // Time spent in the flush callback, vsync excluded
+static int64_t frame_vsync_us;                            // Time spent waiting for vsync
+static uint32_t frame_areas;                              // Flush callback calls
+static uint32_t frame_px;                                 // Pixels reported by the monitor callback
+
+static lv_timer_cb_t refr_timer_cb;                       // LVGL's own refresh timer callback
+static void (*flush_cb)(struct _lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p); // The port's flush callback
+
+static void hist_add(lvgl_port_perf_hist_t *hist, uint32_t us)
+{
+    uint32_t v = us >> 7;                                 // Bucket 0 is below 128 us
+    int bucket = 0;
+    while (v && bucket < LVGL_PORT_PERF_BUCKETS - 1) {
+        v >>= 1;
+        bucket++;
+    }
+
+    hist->count++;
+    hist->sum_us += us;
+    if (us > hist->max_us) {
+        hist->max_us = us;
+    }
+    hist->buckets[bucket]++;
+}
+
+static void perf_monitor_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    frame_px = px;
+}
+
+static void perf_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    int64_t start = esp_timer_get_time();
+    int64_t vsync = frame_vsync_us;
+
+    flush_cb(drv, area, color_map);
+
+    frame_flush_us += (esp_timer_get_time() - start) - (frame_vsync_us - vsync);
+    frame_areas++;
+}
+
+static void perf_refr_timer_cb(lv_timer_t *timer)
+{
+    frame_flush_us = 0;
+    frame_vsync_us = 0;
+    frame_areas = 0;
+    frame_px = 0;
+
+    int64_t start = esp_timer_get_time();
+    refr_timer_cb(timer);
+    uint32_t frame_us = esp_timer_get_time() - start;
+
+    if (frame_areas == 0) {
+        return; // Nothing was invalidated
+    }
+
+    hist_add(&perf.frame, frame_us);
+    hist_add(&perf.flush, frame_flush_us);
+    hist_add(&perf.vsync, frame_vsync_us);
+    hist_add(&perf.render, frame_us - frame_flush_us - frame_vsync_us);
+
+    perf.px_sum += frame_px;
+    if (frame_px > perf.px_max) {
+        perf.px_max = frame_px;
+    }
+    perf.areas_sum += frame_areas;
+    if (frame_areas > perf.areas_max) {
+        perf.areas_max = frame_areas;
+    }
+}
+
+void lvgl_port_perf_attach(lv_disp_t *disp)
+{
+    refr_timer_cb = disp->refr_timer->timer_cb;
+    lv_timer_set_cb(disp->refr_timer, perf_refr_timer_cb);
+
+    flush_cb = disp->driver->flush_cb;
+    disp->driver->flush_cb = perf_flush_cb;
+
+    if (disp->driver->monitor_cb == NULL) {
+        disp->driver->monitor_cb = perf_monitor_cb;
+    }
+}
+
+void lvgl_port_perf_vsync(uint32_t us)
+{
+    frame_vsync_us += us;
+}
+
+void lvgl_port_perf_lock(uint32_t us)
+{
+    hist_add(&perf.lock, us);
+}
+
+void lvgl_port_perf_get(lvgl_port_perf_t *out, bool reset)
+{
+    *out = perf;
+    if (reset) {
+        lv_memset_00(&perf, sizeof(perf));
+    }
+}
+
+#endif /* LVGL_PORT_PERF_ENABLE */
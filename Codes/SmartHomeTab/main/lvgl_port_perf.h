@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LVGL_PORT_PERF_ENABLE       (CONFIG_EXAMPLE_LVGL_PORT_PERF_STATS)  // Set to 1 to collect render pipeline statistics
+#define LVGL_PORT_PERF_BUCKETS      (16)        // Number of buckets of each histogram
+
+/**
+ * Histogram of durations, in microseconds. Buckets are powers of two:
+ * bucket 0 counts durations below 128 us, bucket i (i >= 1) counts [64 << i, 128 << i) us,
+ * and the last bucket also counts everything above.
+ *
+ */
+typedef struct {
+    uint32_t count;                             // Number of samples
+    uint32_t max_us;                            // Longest sample
+    uint64_t sum_us;                            // Sum of all samples
+    uint32_t buckets[LVGL_PORT_PERF_BUCKETS];
+} lvgl_port_perf_hist_t;
+
+/**
+ * Render pipeline statistics, per frame unless noted otherwise
+ *
+ */
+typedef struct {
+    lvgl_port_perf_hist_t frame;                // Whole refresh: render + flush + vsync wait
+    lvgl_port_perf_hist_t render;               // Drawing into LVGL's buffer
+    lvgl_port_perf_hist_t flush;                // Time in the flush callback (copies, draw_bitmap)
+    lvgl_port_perf_hist_t vsync;                // Waiting for the RGB panel to take the new frame buffer
+    lvgl_port_perf_hist_t lock;                 // Waiting in lvgl_port_lock(), per call
+    uint64_t px_sum;                            // Invalidated pixels, summed over the frames
+    uint32_t px_max;                            // Invalidated pixels of the largest frame
+    uint32_t areas_sum;                         // Refreshed (flushed) areas, summed over the frames
+    uint32_t areas_max;                         // Refreshed areas of the busiest frame
+} lvgl_port_perf_t;
+
+#if LVGL_PORT_PERF_ENABLE
+
+/**
+ * @brief Start collecting statistics for a display
+ *
+ * Wraps the display's refresh timer and flush callback, so it must be called after
+ * lv_disp_drv_register(). Uses the monitor callback if the driver does not set one.
+ *
+ */
+void lvgl_port_perf_attach(lv_disp_t *disp);
+
+/**
+ * @brief Record one wait for vsync, called from the flush callback
+ *
+ */
+void lvgl_port_perf_vsync(uint32_t us);
+
+/**
+ * @brief Record one wait for the LVGL mutex, called with the mutex held
+ *
+ */
+void lvgl_port_perf_lock(uint32_t us);
+
+/**
+ * @brief Copy the statistics collected so far
+ *
+ * @note Call with the LVGL mutex held.
+ *
+ * @param[out] perf: Statistics
+ * @param[in] reset: Start a new collection period
+ *
+ */
+void lvgl_port_perf_get(lvgl_port_perf_t *perf, bool reset);
+
+#else
+
+static inline void lvgl_port_perf_attach(lv_disp_t *disp) { (void) disp; }
+static inline void lvgl_port_perf_vsync(uint32_t us) { (void) us; }
+static inline void lvgl_port_perf_lock(uint32_t us) { (void) us; }
+static inline void lvgl_port_perf_get(lvgl_port_perf_t *perf, bool reset) { (void) reset; lv_memset_00(perf, sizeof(*perf)); }
+
+#endif /* LVGL_PORT_PERF_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,91 @@
+#include <stdbool.h>
+#include <string.h>
+#include "lvgl_port_rotate.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+#else
+#define IRAM_ATTR                                         // Host builds (benchmark, simulator)
+#endif
+
+#define TILE    LVGL_PORT_ROTATE_TILE
+
+_Static_assert((TILE % 2) == 0, "LVGL_PORT_ROTATE_TILE must be even for paired-pixel stores");
+
+// Scratch tile, one row per destination row. Static data is placed in internal RAM,
+// so the strided accesses of the transpose stay out of the PSRAM cache.
+static uint32_t tile[TILE][TILE / 2];
+
+/**
+ * @brief Transpose one tile of at most TILE x TILE pixels through the scratch tile
+ *
+ * Row `i` of the scratch tile receives source column `x + i`. For 90 degrees it is stored
+ * top to bottom, for 270 degrees bottom to top, so every scratch row is already in
+ * destination order and can be written out with a single copy.
+ *
+ */
+IRAM_ATTR static void rotate_tile(const uint16_t *from, uint16_t *to, int x, int y, int tw, int th, int w, int h, bool cw)
+{
+    const uint16_t *src = from + y * w + x;               // Top-left pixel of the tile in the source
+    int k = 0;
+
+    // Two source rows at a time: each pair of pixels of a column is one 32-bit store
+    for (; k + 1 < th; k += 2) {
+        const uint16_t *r0 = cw ? src + k * w : src + (th - 1 - k) * w;  // Row going to scratch column k
+        const uint16_t *r1 = cw ? r0 + w : r0 - w;                        // Row going to scratch column k + 1
+        for (int i = 0; i < tw; i++) {
+            tile[i][k / 2] = (uint32_t)r0[i] | ((uint32_t)r1[i] << 16);
+        }
+    }
+    if (k < th) {                                         // Odd height: last column on its own
+        const uint16_t *r0 = cw ? src + k * w : src;
+        for (int i = 0; i < tw; i++) {
+            ((uint16_t *)tile[i])[k] = r0[i];
+        }
+    }
+
+    // Write the scratch rows: each one is `th` consecutive pixels of the destination
+    for (int i = 0; i < tw; i++) {
+        int to_index;
+        if (cw) {
+            to_index = (w - x - i - 1) * h + y;           // Same mapping as the 90-degree scalar loop
+        } else {
+            to_index = (x + i) * h + (h - y - th);        // Same mapping as the 270-degree scalar loop
+        }
+        if (th == TILE) {
+            memcpy(to + to_index, tile[i], TILE * sizeof(uint16_t));  // Constant size: inlined as 32-bit stores
+        } else {
+            memcpy(to + to_index, tile[i], th * sizeof(uint16_t));
+        }
+    }
+}
+
+IRAM_ATTR void lvgl_port_rotate_copy(const uint16_t *from, uint16_t *to, uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end, uint16_t w, uint16_t h, uint16_t rotation)
+{
+    switch (rotation) {
+    case 90:
+    case 270:
+        for (int y = y_start; y <= y_end; y += TILE) {
+            int th = (y_end - y + 1 < TILE) ? (y_end - y + 1) : TILE;   // Height of this tile row
+            for (int x = x_start; x <= x_end; x += TILE) {
+                int tw = (x_end - x + 1 < TILE) ? (x_end - x + 1) : TILE;
+                rotate_tile(from, to, x, y, tw, th, w, h, rotation == 90);
+            }
+        }
+        break;
+    case 180: {
+        // Both sides are already sequential: reverse each row
+        int to_index_const = h * w - x_start - 1;        // Calculate constant index for 180-degree rotation
+        for (int from_y = y_start; from_y < y_end + 1; from_y++) {
+            const uint16_t *src = from + from_y * w + x_start;
+            uint16_t *dst = to + to_index_const - from_y * w;
+            for (int n = x_end - x_start + 1; n > 0; n--) {
+                *dst-- = *src++;
+            }
+        }
+        break;
+    }
+    default:
+        break;                                             // Do nothing for unsupported rotation angles
+    }
+}
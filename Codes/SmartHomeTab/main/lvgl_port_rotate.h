@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LVGL_PORT_ROTATE_TILE   (16)    // Side of the square tiles used by the 90/270 degree paths, in pixels
+
+/**
+ * @brief Rotate and copy an area of an RGB565 buffer into a frame buffer
+ *
+ * The 90 and 270 degree rotations are a transpose: the destination is written with a stride of `h`
+ * pixels for each source pixel. To keep the frame buffer (PSRAM) accesses sequential, the area is
+ * processed in LVGL_PORT_ROTATE_TILE square tiles, transposed in an internal RAM scratch tile with
+ * 32-bit paired-pixel stores and then written to the destination one contiguous row at a time.
+ *
+ * @note Not reentrant: the scratch tile is shared, call it from one task only (the LVGL task).
+ *
+ * @param[in] from: Source buffer of `w` x `h` pixels (LVGL coordinates)
+ * @param[out] to: Destination frame buffer, in panel coordinates
+ * @param[in] x_start, y_start, x_end, y_end: Area to copy, inclusive, in LVGL coordinates
+ * @param[in] w, h: Size of the source buffer
+ * @param[in] rotation: 90, 180 or 270; other values copy nothing
+ *
+ */
+void lvgl_port_rotate_copy(const uint16_t *from, uint16_t *to, uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end, uint16_t w, uint16_t h, uint16_t rotation);
+
+#ifdef __cplusplus
+}
+#endif
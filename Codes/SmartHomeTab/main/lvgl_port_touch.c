@@ -0,0 +1,160 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "i2c_bus.h"
+#include "lvgl_port.h"
+#include "lvgl_port_touch.h"
+
+_Static_assert((LVGL_PORT_TOUCH_QUEUE_LEN & (LVGL_PORT_TOUCH_QUEUE_LEN - 1)) == 0,
+               "LVGL_PORT_TOUCH_QUEUE_LEN must be a power of two");
+
+static const char *TAG = "lv_port_touch";                 // Tag for logging
+
+static esp_lcd_touch_handle_t touch_handle = NULL;      // Touch controller
+static TaskHandle_t touch_task_handle = NULL;           // Handle of the reader task
+static lv_timer_t *touch_read_timer = NULL;             // Read timer of the LVGL input device
+static bool touch_has_int = false;                      // Whether the controller interrupt is used
+
+static portMUX_TYPE samples_lock = portMUX_INITIALIZER_UNLOCKED; // Protects the sample queue
+static lvgl_port_touch_sample_t samples[LVGL_PORT_TOUCH_QUEUE_LEN];
+static uint32_t samples_cnt = 0;                        // Number of samples ever queued
+
+static void IRAM_ATTR touch_isr(esp_lcd_touch_handle_t tp)
+{
+    BaseType_t need_yield = pdFALSE;
+    vTaskNotifyGiveFromISR(touch_task_handle, &need_yield); // Read the new report in the task
+    if (need_yield == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void sample_push(const lvgl_port_touch_sample_t *sample)
+{
+    taskENTER_CRITICAL(&samples_lock);
+    samples[samples_cnt & (LVGL_PORT_TOUCH_QUEUE_LEN - 1)] = *sample;
+    samples_cnt++;
+    taskEXIT_CRITICAL(&samples_lock);
+}
+
+// Bus job: fetch the touch report into the driver
+static esp_err_t touch_read_job(void *arg)
+{
+    return esp_lcd_touch_read_data((esp_lcd_touch_handle_t)arg);
+}
+
+static void touch_task(void *arg)
+{
+    lvgl_port_touch_sample_t last = { 0 };
+
+    ESP_LOGI(TAG, "Starting touch task, %s", touch_has_int ? "interrupt driven" : "polling");
+    while (1) {
+        // While touched, also read on a timeout in case the release interrupt was missed
+        TickType_t wait = pdMS_TO_TICKS(LVGL_PORT_TOUCH_PRESSED_POLL_MS);
+        if (!last.pressed) {
+            wait = touch_has_int ? portMAX_DELAY : pdMS_TO_TICKS(LVGL_PORT_TOUCH_IDLE_POLL_MS);
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        // Read data from touch controller, ahead of other I2C traffic
+        if (i2c_bus_run(I2C_BUS_PRIO_TOUCH, touch_read_job, touch_handle) != ESP_OK) {
+            continue;
+        }
+
+        lvgl_port_touch_sample_t sample = { .time_us = esp_timer_get_time(), .x = last.x, .y = last.y };
+        uint16_t x;
+        uint16_t y;
+        uint8_t cnt = 0;
+        sample.pressed = esp_lcd_touch_get_coordinates(touch_handle, &x, &y, NULL, &cnt, 1) && cnt > 0;
+        if (sample.pressed) {
+            sample.x = x;
+            sample.y = y;
+        }
+
+        // Only changes are queued, so the velocity window is made of moves
+        if (sample.pressed == last.pressed && sample.x == last.x && sample.y == last.y) {
+            continue;
+        }
+        sample_push(&sample);
+        last = sample;
+        lvgl_port_trigger_timer(touch_read_timer); // Let LVGL read the new sample now
+    }
+}
+
+esp_err_t lvgl_port_touch_start(esp_lcd_touch_handle_t tp, lv_timer_t *read_timer)
+{
+    touch_handle = tp;
+    touch_read_timer = read_timer;
+
+    BaseType_t core_id = (LVGL_PORT_TASK_CORE < 0) ? tskNO_AFFINITY : LVGL_PORT_TASK_CORE; // Next to the LVGL task
+    BaseType_t ret = xTaskCreatePinnedToCore(touch_task, "touch", LVGL_PORT_TOUCH_TASK_STACK_SIZE, NULL,
+                                             LVGL_PORT_TOUCH_TASK_PRIORITY, &touch_task_handle, core_id);
+    if (ret != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create touch task");
+        return ESP_FAIL;
+    }
+
+    // Without an interrupt pin the task keeps polling
+    touch_has_int = esp_lcd_touch_register_interrupt_callback(tp, touch_isr) == ESP_OK;
+    xTaskNotifyGive(touch_task_handle); // Pick up the mode and read the initial state
+    return ESP_OK;
+}
+
+bool lvgl_port_touch_get(lvgl_port_touch_sample_t *sample)
+{
+    taskENTER_CRITICAL(&samples_lock);
+    if (samples_cnt > 0) {
+        *sample = samples[(samples_cnt - 1) & (LVGL_PORT_TOUCH_QUEUE_LEN - 1)];
+    } else {
+        *sample = (lvgl_port_touch_sample_t) { 0 };
+    }
+    taskEXIT_CRITICAL(&samples_lock);
+    return sample->pressed;
+}
+
+void lvgl_port_touch_get_velocity(int32_t *vx, int32_t *vy)
+{
+    lvgl_port_touch_sample_t queue[LVGL_PORT_TOUCH_QUEUE_LEN];
+    uint32_t cnt;
+
+    taskENTER_CRITICAL(&samples_lock);
+    cnt = samples_cnt;
+    memcpy(queue, samples, sizeof(queue));
+    taskEXIT_CRITICAL(&samples_lock);
+
+    *vx = 0;
+    *vy = 0;
+
+    // Skip the release sample: it repeats the last position
+    uint32_t n = cnt;
+    while (n > 0 && cnt - n < LVGL_PORT_TOUCH_QUEUE_LEN &&
+            !queue[(n - 1) & (LVGL_PORT_TOUCH_QUEUE_LEN - 1)].pressed) {
+        n--;
+    }
+    if (n == 0 || cnt - n >= LVGL_PORT_TOUCH_QUEUE_LEN) {
+        return;
+    }
+
+    const lvgl_port_touch_sample_t *newest = &queue[(n - 1) & (LVGL_PORT_TOUCH_QUEUE_LEN - 1)];
+    const lvgl_port_touch_sample_t *oldest = newest;
+    // End of the window: now while touched, else the release. A finger at rest has no velocity.
+    int64_t end_us = (cnt == n) ? esp_timer_get_time() : queue[n & (LVGL_PORT_TOUCH_QUEUE_LEN - 1)].time_us;
+
+    // Oldest sample of the same touch within the window
+    for (uint32_t i = n - 1; i > 0 && cnt - i < LVGL_PORT_TOUCH_QUEUE_LEN; i--) {
+        const lvgl_port_touch_sample_t *prev = &queue[(i - 1) & (LVGL_PORT_TOUCH_QUEUE_LEN - 1)];
+        if (!prev->pressed || end_us - prev->time_us > LVGL_PORT_TOUCH_VELOCITY_MS * 1000) {
+            break;
+        }
+        oldest = prev;
+    }
+
+    int64_t dt_us = end_us - oldest->time_us;
+    if (oldest == newest || dt_us <= 0) {
+        return;
+    }
+    *vx = (int32_t)(((int64_t)newest->x - oldest->x) * 1000000 / dt_us);
+    *vy = (int32_t)(((int64_t)newest->y - oldest->y) * 1000000 / dt_us);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_lcd_touch.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LVGL_PORT_TOUCH_QUEUE_LEN       (8)     // Samples kept for the velocity estimate, must be a power of two
+#define LVGL_PORT_TOUCH_PRESSED_POLL_MS (10)    // Read period while touched, the GT911 report period
+#define LVGL_PORT_TOUCH_IDLE_POLL_MS    (CONFIG_EXAMPLE_LVGL_PORT_TOUCH_IDLE_POLL_MS) // Read period while untouched, without interrupt pin
+#define LVGL_PORT_TOUCH_VELOCITY_MS     (100)   // Window of the velocity estimate
+#define LVGL_PORT_TOUCH_TASK_STACK_SIZE (3 * 1024)
+#define LVGL_PORT_TOUCH_TASK_PRIORITY   (CONFIG_EXAMPLE_LVGL_PORT_TASK_PRIORITY + 1) // Above the LVGL task, so samples are fresh
+
+/**
+ * One touch sample, in display coordinates
+ *
+ */
+typedef struct {
+    int64_t time_us;                            // esp_timer time of the read
+    uint16_t x;
+    uint16_t y;                                 // Last pressed position if released
+    bool pressed;
+} lvgl_port_touch_sample_t;
+
+/**
+ * @brief Start the touch reader task
+ *
+ * The task reads the controller on its interrupt, or polls it when no interrupt pin is configured
+ * (every LVGL_PORT_TOUCH_PRESSED_POLL_MS while touched, LVGL_PORT_TOUCH_IDLE_POLL_MS otherwise).
+ * New samples are queued and `read_timer` is triggered, so the indev read timer may stay paused
+ * while the screen is not touched. Reads run as touch priority jobs of the I2C bus task.
+ *
+ * @param[in] tp: Touch controller, with its orientation already set
+ * @param[in] read_timer: Read timer of the LVGL input device
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_FAIL: The task could not be created
+ */
+esp_err_t lvgl_port_touch_start(esp_lcd_touch_handle_t tp, lv_timer_t *read_timer);
+
+/**
+ * @brief Get the latest touch sample
+ *
+ * @param[out] sample: Latest sample, released at (0, 0) before the first touch
+ *
+ * @return
+ *      - true: The screen is touched
+ *      - false: The screen is not touched
+ */
+bool lvgl_port_touch_get(lvgl_port_touch_sample_t *sample);
+
+/**
+ * @brief Get the velocity of the current or last touch, in pixels per second
+ *
+ * Estimated over the samples of the last LVGL_PORT_TOUCH_VELOCITY_MS of the touch. On release, this is
+ * the velocity the finger left the screen with, which the port gives LVGL as the scroll throw.
+ * Can be called from any task.
+ *
+ * @param[out] vx: Horizontal velocity
+ * @param[out] vy: Vertical velocity
+ */
+void lvgl_port_touch_get_velocity(int32_t *vx, int32_t *vy);
+
+#ifdef __cplusplus
+}
+#endif
@@ -10,29 +10,30 @@
 //============================================================================//
 
 #include "waveshare_rgb_lcd_port.h"
+#include "boot.h"
 #include "ui.h"
 #include "driver/gpio.h"
-#include "driver/i2c.h"
+#include "i2c_bus.h"
 #include <stdio.h>
 #include <time.h>
 #include <string.h>
 #include "wifi_manager.h"
 #include "mqtt_manager.h"
 #include "ui_mqtt_bridge.h"
+#include "ui_clock.h"
+#include "ui_history_chart.h"
+#include "ui_img_rle.h"
+#include "ui_screens.h"
+#include "sensor_history.h"
+#include "state_store.h"
+#include "perf_report.h"
 #include "esp_sntp.h"
 #include "esp_timer.h"
+#include <sys/time.h>
 
 // ---------------------------------------------------------------------
-// I2C Config
+// I2C devices (bus pins and clock in i2c_bus.h)
 // ---------------------------------------------------------------------
-#define I2C_MASTER_SDA_IO          15
-#define I2C_MASTER_SCL_IO          16
-#define I2C_MASTER_TX_BUF_DISABLE  0
-#define I2C_MASTER_RX_BUF_DISABLE  0
-#define I2C_MASTER_NUM             I2C_NUM_0
-#define I2C_MASTER_FREQ_HZ         100000
-
-// Device addresses
 #define DEVICE_ADDR_BACKLIGHT  0x30
 #define DEVICE_ADDR_TOUCH      0x5D
 #define DEVICE_ADDR_RTC        0x51
@@ -54,77 +55,17 @@
 static uint8_t dec2bcd(uint8_t dec) { return ((dec / 10) << 4) | (dec % 10); }
 static uint8_t bcd2dec(uint8_t bcd) { return ((bcd >> 4) * 10) + (bcd & 0x0F); }
 
-// ---------------------------------------------------------------------
-// I2C INIT
-// ---------------------------------------------------------------------
-void i2c_master_init()
-{
-    i2c_config_t conf = {
-        .mode = I2C_MODE_MASTER,
-        .sda_io_num = I2C_MASTER_SDA_IO,
-        .scl_io_num = I2C_MASTER_SCL_IO,
-        .sda_pullup_en = GPIO_PULLUP_ENABLE,
-        .scl_pullup_en = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = I2C_MASTER_FREQ_HZ
-    };
-    ESP_ERROR_CHECK(i2c_param_config(I2C_MASTER_NUM, &conf));
-    ESP_ERROR_CHECK(i2c_driver_install(I2C_MASTER_NUM, conf.mode,
-                                       I2C_MASTER_RX_BUF_DISABLE,
-                                       I2C_MASTER_TX_BUF_DISABLE, 0));
-}
-
-bool i2c_scan_address(uint8_t address)
-{
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_stop(cmd);
-    esp_err_t r = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, 50 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
-    return r == ESP_OK;
-}
-
-esp_err_t i2c_write_byte(uint8_t dev, uint8_t data)
-{
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (dev << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd, data, true);
-    i2c_master_stop(cmd);
-    esp_err_t r = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, 50 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
-    return r;
-}
-
 // ---------------------------------------------------------------------
 // RTC FUNCTIONS
 // ---------------------------------------------------------------------
 static esp_err_t rtc_write_reg(uint8_t reg, uint8_t data)
 {
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (DEVICE_ADDR_RTC << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd, reg, true);
-    i2c_master_write_byte(cmd, data, true);
-    i2c_master_stop(cmd);
-    esp_err_t r = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, 200 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
-    return r;
+    return i2c_bus_write_reg(DEVICE_ADDR_RTC, reg, &data, 1);
 }
 
 static esp_err_t rtc_read_regs(uint8_t reg, uint8_t *data, size_t len)
 {
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (DEVICE_ADDR_RTC << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd, reg, true);
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (DEVICE_ADDR_RTC << 1) | I2C_MASTER_READ, true);
-    i2c_master_read(cmd, data, len, I2C_MASTER_LAST_NACK);
-    i2c_master_stop(cmd);
-    esp_err_t r = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, 200 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
-    return r;
+    return i2c_bus_read_reg(DEVICE_ADDR_RTC, reg, data, len);
 }
 
 static esp_err_t rtc_init(void)
@@ -144,16 +85,7 @@ static esp_err_t rtc_set_time(const struct tm *t)
     d[5] = dec2bcd(t->tm_mon + 1) & 0x1F;
     d[6] = dec2bcd(t->tm_year % 100);
 
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (DEVICE_ADDR_RTC << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd, PCF8563_REG_SEC, true);
-    i2c_master_write(cmd, d, 7, true);
-    i2c_master_stop(cmd);
-
-    esp_err_t r = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, 200 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
-    return r;
+    return i2c_bus_write_reg(DEVICE_ADDR_RTC, PCF8563_REG_SEC, d, 7);
 }
 
 static esp_err_t rtc_get_time(struct tm *t)
@@ -171,6 +103,20 @@ static esp_err_t rtc_get_time(struct tm *t)
     return ESP_OK;
 }
 
+// The RTC keeps the local time (IST). Set the system time from it until
+// SNTP answers, so the saved state knows how long the tablet was off.
+static void rtc_to_system_time(void)
+{
+    struct tm t;
+    if (rtc_get_time(&t) != ESP_OK || t.tm_year < (2020 - 1900)) return;
+
+    setenv("TZ", "IST-5:30", 1);
+    tzset();
+    t.tm_isdst = 0;
+    struct timeval tv = { .tv_sec = mktime(&t) };
+    settimeofday(&tv, NULL);
+}
+
 // ---------------------------------------------------------------------
 // SNTP SYNC (silent, timeout 30s, update RTC once) - TZ fixed (IST)
 // ---------------------------------------------------------------------
@@ -190,13 +136,13 @@ static bool sntp_sync_rtc_once(void)
 
     while ((esp_timer_get_time() / 1000 - start) < timeout_ms)
     {
-        time_t now = 0;
-        struct tm timeinfo = {0};
-        time(&now);
-        localtime_r(&now, &timeinfo);
+        // The system time may already come from the RTC; wait for the server
+        if (esp_sntp_get_sync_status() == SNTP_SYNC_STATUS_COMPLETED) {
+            time_t now = 0;
+            struct tm timeinfo = {0};
+            time(&now);
+            localtime_r(&now, &timeinfo);
 
-        // If year looks valid ( > 1970 ), break and use it
-        if (timeinfo.tm_year > (1970 - 1900)) {
             // write the local time (IST) to RTC once
             rtc_set_time(&timeinfo);
             // Stop SNTP quietly
@@ -218,11 +164,6 @@ static bool sntp_sync_rtc_once(void)
 // ---------------------------------------------------------------------
 void rtc_display_task(void *arg)
 {
-    const char *days[] = {
-        "Sunday","Monday","Tuesday","Wednesday",
-        "Thursday","Friday","Saturday"
-    };
-
     struct tm tm_now;
 
     while (1)
@@ -231,20 +172,7 @@ void rtc_display_task(void *arg)
         {
             if (lvgl_port_lock(-1))
             {
-                char buf1[16], buf2[16], buf3[32];
-
-                sprintf(buf1, "%02d:%02d:%02d",
-                        tm_now.tm_hour, tm_now.tm_min, tm_now.tm_sec);
-                sprintf(buf2, "%s", days[tm_now.tm_wday]);
-                sprintf(buf3, "%04d-%02d-%02d",
-                        tm_now.tm_year + 1900,
-                        tm_now.tm_mon + 1,
-                        tm_now.tm_mday);
-
-                lv_label_set_text(uic_time, buf1);
-                lv_label_set_text(uic_day, buf2);
-                lv_label_set_text(uic_date, buf3);
-
+                ui_clock_set(&tm_now);
                 lvgl_port_unlock();
             }
         }
@@ -253,56 +181,146 @@ void rtc_display_task(void *arg)
 }
 
 // ---------------------------------------------------------------------
-// WiFi callback
+// BOOT STAGES
+// The display chain (I2C, LCD, UI) and the Wi-Fi association run side by
+// side; once there is an IP, MQTT connects while SNTP waits for the time.
+// See boot.h for the log of the stage times.
 // ---------------------------------------------------------------------
-static void on_wifi_got_ip(void)
+enum {
+    STAGE_I2C,
+    STAGE_LCD,
+    STAGE_UI,
+    STAGE_FIRST_FRAME,          // event: the UI was drawn
+    STAGE_WIFI,
+    STAGE_GOT_IP,               // event: on_wifi_got_ip()
+    STAGE_MQTT,
+    STAGE_SNTP,
+    STAGE_FIRST_DATA,           // event: the first message reached the UI
+    STAGE_CNT,
+};
+
+static void stage_i2c(void)
 {
-    // First SNTP sync → update RTC once
-    sntp_sync_rtc_once();
+    ESP_ERROR_CHECK(i2c_bus_init());
+    vTaskDelay(pdMS_TO_TICKS(50));
 
-    // MQTT
-    mqtt_manager_start("mqtt://192.168.0.154:1883",
-                       "mqttuser", "mqttpassword");
+    i2c_bus_write(DEVICE_ADDR_BACKLIGHT, (const uint8_t[]){ 0x18 }, 1);
+    i2c_bus_write(DEVICE_ADDR_BACKLIGHT, (const uint8_t[]){ 0x10 }, 1);
 
-    ui_mqtt_bridge_init();
+    if (rtc_init() == ESP_OK)
+        ESP_LOGI("MAIN", "RTC OK");
+    rtc_to_system_time();
 }
 
-
-// ---------------------------------------------------------------------
-// MAIN — minimal changes
-// ---------------------------------------------------------------------
-void app_main()
+static void stage_lcd(void)
 {
-    ESP_LOGI("MAIN", "Starting System...");
+    waveshare_esp32_s3_rgb_lcd_init();
+}
 
-    i2c_master_init();
-    vTaskDelay(pdMS_TO_TICKS(50));
+static void (*port_monitor_cb)(lv_disp_drv_t *drv, uint32_t time, uint32_t px);
 
-    i2c_write_byte(DEVICE_ADDR_BACKLIGHT, 0x18);
-    i2c_write_byte(DEVICE_ADDR_BACKLIGHT, 0x10);
+static void first_frame_unhook(void *drv)
+{
+    ((lv_disp_drv_t *) drv)->monitor_cb = port_monitor_cb;
+}
 
-    if (rtc_init() == ESP_OK)
-        ESP_LOGI("MAIN", "RTC OK");
+// LVGL calls it in its own task once the areas of a frame are flushed
+static void first_frame_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    if (port_monitor_cb) port_monitor_cb(drv, time, px);
 
+    if (!boot_is_done(STAGE_FIRST_FRAME)) {
+        boot_done(STAGE_FIRST_FRAME);
+        lv_async_call(first_frame_unhook, drv);
+    }
+}
 
-    waveshare_esp32_s3_rgb_lcd_init();
+// Runs in the LVGL task
+static void on_first_data(void)
+{
+    boot_done(STAGE_FIRST_DATA);
+}
 
+static void stage_ui(void)
+{
     if (lvgl_port_lock(-1))
     {
-        ui_init();
+        // Before any image is set: the images are compressed at build time
+        ui_img_rle_init();
+        ui_screens_init();
+
+        // Bindings first: the saved state is shown through them
+        ui_mqtt_bridge_init();
+        ui_mqtt_bridge_on_first_data(on_first_data);
 
-        wifi_manager_init("xxxx", "xxxx", on_wifi_got_ip);
+        ui_clock_init();
 
-        lv_label_set_text(uic_time, "00:00:00");
-        lv_label_set_text(uic_day,  "Loading...");
-        lv_label_set_text(uic_date, "0000-00-00");
+        sensor_history_init();
+        ui_history_chart_init();
 
+        // The last state before the restart, in the first frame
+        state_store_init();
+
+        lv_disp_drv_t *drv = lv_disp_get_default()->driver;
+        port_monitor_cb = drv->monitor_cb;
+        drv->monitor_cb = first_frame_cb;
         lvgl_port_unlock();
     }
 
     xTaskCreate(rtc_display_task, "rtc_display_task", 4096, NULL, 5, NULL);
+}
+
+// Runs in the event task on every (re)connection
+static void on_wifi_got_ip(void)
+{
+    boot_done(STAGE_GOT_IP);
+}
+
+static void stage_wifi(void)
+{
+    wifi_manager_init("xxxx", "xxxx", on_wifi_got_ip);
+}
+
+static void stage_mqtt(void)
+{
+    // The client reconnects by itself after a Wi-Fi drop
+    mqtt_manager_start("mqtt://192.168.0.154:1883",
+                       "mqttuser", "mqttpassword");
+
+    perf_report_start();
+}
+
+static void stage_sntp(void)
+{
+    // First SNTP sync → update RTC once
+    sntp_sync_rtc_once();
+}
+
+#define AFTER(stage)    BOOT_DEP(STAGE_##stage)
+
+static const boot_stage_t boot_stages[STAGE_CNT] = {
+    //                      name           run         deps                        stack core
+    [STAGE_I2C]         = { "i2c",         stage_i2c,  0,                          4096, BOOT_ANY_CORE },
+    // On the core of app_main, which the panel interrupts were allocated on so far
+    [STAGE_LCD]         = { "lcd",         stage_lcd,  AFTER(I2C),                 4096, 0 },
+    [STAGE_UI]          = { "ui",          stage_ui,   AFTER(LCD),                 6144, BOOT_ANY_CORE },
+    [STAGE_FIRST_FRAME] = { "first_frame", NULL,       AFTER(UI),                  0,    BOOT_ANY_CORE },
+    [STAGE_WIFI]        = { "wifi",        stage_wifi, 0,                          4096, BOOT_ANY_CORE },
+    [STAGE_GOT_IP]      = { "got_ip",      NULL,       AFTER(WIFI),                0,    BOOT_ANY_CORE },
+    [STAGE_MQTT]        = { "mqtt",        stage_mqtt, AFTER(GOT_IP) | AFTER(UI),  4096, BOOT_ANY_CORE },
+    [STAGE_SNTP]        = { "sntp",        stage_sntp, AFTER(GOT_IP) | AFTER(I2C), 4096, BOOT_ANY_CORE },
+    [STAGE_FIRST_DATA]  = { "first_data",  NULL,       AFTER(MQTT),                0,    BOOT_ANY_CORE },
+};
+
+
+// ---------------------------------------------------------------------
+// MAIN
+// ---------------------------------------------------------------------
+void app_main()
+{
+    ESP_LOGI("MAIN", "Starting System...");
 
-    ESP_LOGI("MAIN", "System ready!");
+    boot_start(boot_stages, STAGE_CNT);
 }
 
 //============================================== hackster.io/maheshyadav216 ==============================================//
\ No newline at end of file
@@ -2,19 +2,137 @@
 #include "esp_log.h"
 #include "mqtt_client.h"
 #include "lvgl.h"
+#include "lvgl_port.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stdatomic.h>
 
-extern void ui_handle_mqtt_message_async(void *arg);
+extern void ui_handle_mqtt_message(const char *topic, const char *payload);
 
 static const char *TAG = "MQTT_MGR";
 static esp_mqtt_client_handle_t client = NULL;
 
-// temporary async storage
-static void *g_async_pkg = NULL;
+// ------------------------------------------------------------
+// MQTT -> UI QUEUE
+// Single producer (MQTT task) / single consumer (LVGL timer).
+// Slots are preallocated; head and tail are free-running counters.
+// When full, the oldest message makes room: for state topics the
+// latest payload is the one that must reach the UI. Both sides copy
+// a message in or out under the lock, never hand out a slot.
+// ------------------------------------------------------------
+#define MQTT_QUEUE_LEN      CONFIG_SMARTHOME_MQTT_QUEUE_LEN
+#define MQTT_TOPIC_MAX      CONFIG_SMARTHOME_MQTT_TOPIC_MAX_LEN
+#define MQTT_PAYLOAD_MAX    CONFIG_SMARTHOME_MQTT_PAYLOAD_MAX_LEN
+
+_Static_assert((MQTT_QUEUE_LEN & (MQTT_QUEUE_LEN - 1)) == 0,
+               "CONFIG_SMARTHOME_MQTT_QUEUE_LEN must be a power of two");
+
+typedef struct {
+    char topic[MQTT_TOPIC_MAX];
+    char payload[MQTT_PAYLOAD_MAX];
+} mqtt_msg_slot_t;
+
+static mqtt_msg_slot_t q_slots[MQTT_QUEUE_LEN];
+static unsigned q_head;
+static unsigned q_tail;
+static portMUX_TYPE q_lock = portMUX_INITIALIZER_UNLOCKED;    // Protects the slots, head and tail
+
+static atomic_uint st_received;
+static atomic_uint st_dropped;
+static atomic_uint st_truncated;
+static atomic_uint st_oversized;
+static atomic_uint st_delivered;
+static atomic_uint st_high_water;
+
+static lv_timer_t *drain_timer = NULL;
+
+// ------------------------------------------------------------
+// SUBSCRIPTIONS
+// Filters are collected here and (re)subscribed on every connect.
+// Entries are only appended; the count is published after the entry.
+// ------------------------------------------------------------
+#define MQTT_MAX_SUBSCRIPTIONS  CONFIG_SMARTHOME_MQTT_MAX_SUBSCRIPTIONS
+
+static char subs[MQTT_MAX_SUBSCRIPTIONS][MQTT_TOPIC_MAX];
+static atomic_uint sub_cnt;
+static atomic_bool connected;
+
+// Copy one inbound message into the next slot (MQTT task)
+static void queue_push(const char *topic, int topic_len,
+                       const char *data, int data_len, int total_len)
+{
+    if (topic_len >= MQTT_TOPIC_MAX) {
+        atomic_fetch_add_explicit(&st_oversized, 1, memory_order_relaxed);
+        return;
+    }
+
+    if (data_len >= MQTT_PAYLOAD_MAX || total_len > data_len) {
+        atomic_fetch_add_explicit(&st_truncated, 1, memory_order_relaxed);
+        if (data_len >= MQTT_PAYLOAD_MAX) data_len = MQTT_PAYLOAD_MAX - 1;
+    }
+
+    bool dropped = false;
+    taskENTER_CRITICAL(&q_lock);
+    if (q_head - q_tail >= MQTT_QUEUE_LEN) {
+        q_tail++;
+        dropped = true;
+    }
+    mqtt_msg_slot_t *slot = &q_slots[q_head & (MQTT_QUEUE_LEN - 1)];
+    memcpy(slot->topic, topic, topic_len);
+    slot->topic[topic_len] = '\0';
+    memcpy(slot->payload, data, data_len);
+    slot->payload[data_len] = '\0';
+    q_head++;
+    unsigned depth = q_head - q_tail;
+    taskEXIT_CRITICAL(&q_lock);
 
-// forward declaration
-static void ui_async_timer_cb(lv_timer_t *timer);
+    if (dropped && atomic_fetch_add_explicit(&st_dropped, 1, memory_order_relaxed) == 0) {
+        ESP_LOGW(TAG, "UI queue full, dropping the oldest messages");
+    }
+    atomic_fetch_add_explicit(&st_received, 1, memory_order_relaxed);
+
+    // The drain timer pauses itself when the queue is empty
+    lvgl_port_trigger_timer(drain_timer);
+
+    if (depth > atomic_load_explicit(&st_high_water, memory_order_relaxed)) {
+        atomic_store_explicit(&st_high_water, depth, memory_order_relaxed);
+    }
+}
+
+// Copy the oldest message out of the queue. False if it is empty (LVGL task)
+static bool queue_pop(mqtt_msg_slot_t *msg)
+{
+    bool ok = false;
+    taskENTER_CRITICAL(&q_lock);
+    if (q_tail != q_head) {
+        *msg = q_slots[q_tail & (MQTT_QUEUE_LEN - 1)];
+        q_tail++;
+        ok = true;
+    }
+    taskEXIT_CRITICAL(&q_lock);
+    return ok;
+}
+
+// ------------------------------------------------------------
+// Timer callback → runs in LVGL thread (safe)
+// ------------------------------------------------------------
+static void queue_drain_cb(lv_timer_t *timer)
+{
+    static mqtt_msg_slot_t msg;
+    int budget = CONFIG_SMARTHOME_MQTT_DRAIN_BATCH;
+
+    while (budget-- > 0) {
+        if (!queue_pop(&msg)) {
+            // Nothing left: sleep until queue_push() triggers the timer again
+            lv_timer_pause(timer);
+            return;
+        }
+        ui_handle_mqtt_message(msg.topic, msg.payload);
+        atomic_fetch_add_explicit(&st_delivered, 1, memory_order_relaxed);
+    }
+}
 
 // ------------------------------------------------------------
 // MQTT EVENT HANDLER (compatible with ESP-IDF v5.5)
@@ -31,61 +149,29 @@ static void mqtt_event_handler(void *handler_args,
     case MQTT_EVENT_CONNECTED:
         ESP_LOGI(TAG, "MQTT connected");
 
-        // Subscribe to sensor topics
-        esp_mqtt_client_subscribe(client, "home/roomhub/sensor/temperature", 1);
-        esp_mqtt_client_subscribe(client, "home/roomhub/sensor/humidity", 1);
-        esp_mqtt_client_subscribe(client, "home/roomhub/sensor/light", 1);
-
-        // Subscribe to relay state topics
-        esp_mqtt_client_subscribe(client, "home/roomhub/relay/ac/state", 1);
-        esp_mqtt_client_subscribe(client, "home/roomhub/relay/fan/state", 1);
-        esp_mqtt_client_subscribe(client, "home/roomhub/relay/tv/state", 1);
-        esp_mqtt_client_subscribe(client, "home/roomhub/relay/bulb/state", 1);
-        // Subscribe to Automation state topic
-        esp_mqtt_client_subscribe(client, "home/roomhub/auto/all/state", 1);
+        atomic_store(&connected, true);
+        for (unsigned i = 0; i < atomic_load(&sub_cnt); i++) {
+            esp_mqtt_client_subscribe(client, subs[i], 1);
+        }
         break;
 
+    case MQTT_EVENT_DISCONNECTED:
+        atomic_store(&connected, false);
+        break;
 
-    case MQTT_EVENT_DATA: {
-    char *topic = strndup(event->topic, event->topic_len);
-    char *payload = strndup(event->data, event->data_len);
-
-    typedef struct {
-        char *topic;
-        char *payload;
-    } mqtt_async_t;
-
-    mqtt_async_t *pkg = malloc(sizeof(mqtt_async_t));
-    pkg->topic = topic;
-    pkg->payload = payload;
-
-    g_async_pkg = pkg;
-
-    // Create a one-shot timer (NO user_data, LVGL-safe)
-    lv_timer_t *t = lv_timer_create(ui_async_timer_cb, 1, NULL);
-    lv_timer_set_repeat_count(t, 1);
-    break;
-}
-
+    case MQTT_EVENT_DATA:
+        // Large payloads arrive in several events; only the first one carries the topic
+        if (event->current_data_offset == 0) {
+            queue_push(event->topic, event->topic_len,
+                       event->data, event->data_len, event->total_data_len);
+        }
+        break;
 
     default:
         break;
     }
 }
 
-// ------------------------------------------------------------
-// Timer callback → runs in LVGL thread (safe)
-// ------------------------------------------------------------
-static void ui_async_timer_cb(lv_timer_t *timer)
-{
-    (void) timer;
-
-    if (g_async_pkg) {
-        ui_handle_mqtt_message_async(g_async_pkg);
-        g_async_pkg = NULL;
-    }
-}
-
 
 // ------------------------------------------------------------
 // START MQTT CLIENT — (ESP-IDF v5.5 API)
@@ -94,6 +180,12 @@ void mqtt_manager_start(const char *broker_uri,
                         const char *user,
                         const char *pass)
 {
+    // One persistent drain timer, created before any message can arrive
+    if (drain_timer == NULL && lvgl_port_lock(-1)) {
+        drain_timer = lv_timer_create(queue_drain_cb, CONFIG_SMARTHOME_MQTT_DRAIN_PERIOD_MS, NULL);
+        lvgl_port_unlock();
+    }
+
     esp_mqtt_client_config_t cfg = {
         .broker.address.uri = broker_uri,
         .credentials.username = user,
@@ -123,3 +215,43 @@ void mqtt_manager_publish(const char *topic, const char *payload)
     if (!client) return;
     esp_mqtt_client_publish(client, topic, payload, 0, 1, false);
 }
+
+
+// ------------------------------------------------------------
+// SUBSCRIBE
+// ------------------------------------------------------------
+esp_err_t mqtt_manager_subscribe(const char *filter)
+{
+    unsigned n = atomic_load(&sub_cnt);
+    for (unsigned i = 0; i < n; i++) {
+        if (strcmp(subs[i], filter) == 0) return ESP_OK;
+    }
+    if (n >= MQTT_MAX_SUBSCRIPTIONS || strlen(filter) >= MQTT_TOPIC_MAX) {
+        ESP_LOGE(TAG, "Cannot subscribe to %s", filter);
+        return ESP_ERR_NO_MEM;
+    }
+
+    strcpy(subs[n], filter);
+    atomic_store(&sub_cnt, n + 1);
+
+    // Already connected: the CONNECTED handler may have missed this entry
+    if (atomic_load(&connected)) {
+        esp_mqtt_client_subscribe(client, filter, 1);
+    }
+    return ESP_OK;
+}
+
+
+// ------------------------------------------------------------
+// QUEUE STATISTICS
+// ------------------------------------------------------------
+void mqtt_manager_get_queue_stats(mqtt_queue_stats_t *stats)
+{
+    if (!stats) return;
+    stats->received   = atomic_load_explicit(&st_received, memory_order_relaxed);
+    stats->dropped    = atomic_load_explicit(&st_dropped, memory_order_relaxed);
+    stats->truncated  = atomic_load_explicit(&st_truncated, memory_order_relaxed);
+    stats->oversized  = atomic_load_explicit(&st_oversized, memory_order_relaxed);
+    stats->delivered  = atomic_load_explicit(&st_delivered, memory_order_relaxed);
+    stats->high_water = atomic_load_explicit(&st_high_water, memory_order_relaxed);
+}
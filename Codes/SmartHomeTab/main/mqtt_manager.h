@@ -1,5 +1,19 @@
 #pragma once
+#include <stdint.h>
 #include "esp_err.h"
 
+// Counters of the MQTT -> UI message queue
+typedef struct {
+    uint32_t received;      // messages accepted into the queue
+    uint32_t dropped;       // oldest messages pushed out of the full queue
+    uint32_t truncated;     // payloads cut to CONFIG_SMARTHOME_MQTT_PAYLOAD_MAX_LEN
+    uint32_t oversized;     // messages rejected because the topic did not fit
+    uint32_t delivered;     // messages handed to the UI
+    uint32_t high_water;    // maximum queue depth observed
+} mqtt_queue_stats_t;
+
 void mqtt_manager_start(const char *broker_uri, const char *user, const char *pass);
 void mqtt_manager_publish(const char *topic, const char *payload);
+// Add a topic filter to the subscription list; it is re-subscribed on every connect
+esp_err_t mqtt_manager_subscribe(const char *filter);
+void mqtt_manager_get_queue_stats(mqtt_queue_stats_t *stats);
@@ -0,0 +1,99 @@
+#include "perf_report.h"
+#include "lvgl_port.h"
+#include "lvgl_port_perf.h"
+#include "mqtt_manager.h"
+#include "ui_mqtt_bridge.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <stdarg.h>
+
+static const char *TAG = "PERF";
+
+#if LVGL_PORT_PERF_ENABLE && CONFIG_SMARTHOME_PERF_PERIOD_S > 0
+
+#define PERF_JSON_MAX   1024
+
+static char json[PERF_JSON_MAX];
+static int json_len;
+
+static void json_append(const char *fmt, ...)
+{
+    if (json_len >= PERF_JSON_MAX) return;
+
+    va_list args;
+    va_start(args, fmt);
+    json_len += vsnprintf(json + json_len, PERF_JSON_MAX - json_len, fmt, args);
+    va_end(args);
+}
+
+// "name":{"n":count,"avg":us,"max":us,"h":[buckets]}
+static void json_hist(const char *name, const lvgl_port_perf_hist_t *hist)
+{
+    json_append("\"%s\":{\"n\":%u,\"avg\":%u,\"max\":%u,\"h\":[", name, (unsigned) hist->count,
+                (unsigned)(hist->count ? hist->sum_us / hist->count : 0), (unsigned) hist->max_us);
+    for (int i = 0; i < LVGL_PORT_PERF_BUCKETS; i++) {
+        json_append(i ? ",%u" : "%u", (unsigned) hist->buckets[i]);
+    }
+    json_append("]},");
+}
+
+// ------------------------------------------------------------
+// Timer callback → runs in LVGL thread, with the LVGL lock held
+// ------------------------------------------------------------
+static void perf_report_cb(lv_timer_t *timer)
+{
+    lvgl_port_perf_t perf;
+    mqtt_queue_stats_t queue;
+    ui_mqtt_bridge_stats_t bridge;
+
+    lvgl_port_perf_get(&perf, true);
+    mqtt_manager_get_queue_stats(&queue);
+    ui_mqtt_bridge_get_stats(&bridge);
+
+    uint32_t frames = perf.frame.count;
+    json_len = 0;
+    json_append("{\"uptime_s\":%u,\"period_s\":%u,\"frames\":%u,", (unsigned)(esp_timer_get_time() / 1000000),
+                (unsigned) CONFIG_SMARTHOME_PERF_PERIOD_S, (unsigned) frames);
+    json_append("\"px_avg\":%u,\"px_max\":%u,\"areas_avg\":%u,\"areas_max\":%u,",
+                (unsigned)(frames ? perf.px_sum / frames : 0), (unsigned) perf.px_max,
+                (unsigned)(frames ? perf.areas_sum / frames : 0), (unsigned) perf.areas_max);
+    json_hist("frame_us", &perf.frame);
+    json_hist("render_us", &perf.render);
+    json_hist("flush_us", &perf.flush);
+    json_hist("vsync_us", &perf.vsync);
+    json_hist("lock_us", &perf.lock);
+    json_append("\"mqtt\":{\"received\":%u,\"dropped\":%u,\"high_water\":%u,\"coalesced\":%u,\"suppressed\":%u}}",
+                (unsigned) queue.received, (unsigned) queue.dropped, (unsigned) queue.high_water,
+                (unsigned) bridge.coalesced, (unsigned) bridge.suppressed);
+
+    if (json_len >= PERF_JSON_MAX) {
+        ESP_LOGW(TAG, "Report truncated");
+        return;
+    }
+    mqtt_manager_publish(CONFIG_SMARTHOME_PERF_TOPIC, json);
+}
+
+void perf_report_start(void)
+{
+    static lv_timer_t *timer = NULL;
+
+    if (timer == NULL && lvgl_port_lock(-1)) {
+        // Start the first period now, not at boot
+        lvgl_port_perf_t discard;
+        lvgl_port_perf_get(&discard, true);
+
+        timer = lv_timer_create(perf_report_cb, CONFIG_SMARTHOME_PERF_PERIOD_S * 1000, NULL);
+        lvgl_port_unlock();
+    }
+    ESP_LOGI(TAG, "Publishing statistics on %s every %d s", CONFIG_SMARTHOME_PERF_TOPIC, CONFIG_SMARTHOME_PERF_PERIOD_S);
+}
+
+#else
+
+void perf_report_start(void)
+{
+    ESP_LOGI(TAG, "Performance report disabled");
+}
+
+#endif
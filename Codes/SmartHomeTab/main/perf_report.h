@@ -0,0 +1,6 @@
+#pragma once
+
+// Publish the render pipeline statistics (lvgl_port_perf.h) together with the MQTT queue
+// and bridge counters as JSON on CONFIG_SMARTHOME_PERF_TOPIC, every CONFIG_SMARTHOME_PERF_PERIOD_S.
+// Call after mqtt_manager_start().
+void perf_report_start(void);
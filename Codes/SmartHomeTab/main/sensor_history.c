@@ -0,0 +1,294 @@
+#include "sensor_history.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "SENSOR_HISTORY";
+
+// ------------------------------------------------------------
+// LEVELS
+// Every level is a ring of periods indexed by (t / period) % len,
+// so any second is found without a search. `head` is the newest
+// period written; the slots the head skips over are emptied as it
+// moves, which leaves gaps in the data as gaps in the history.
+// `first` keeps a level from claiming the periods before it was
+// written, e.g. seconds before a restart whose minutes were restored.
+// ------------------------------------------------------------
+#define SCALE           100                 // fixed point: hundredths
+#define RAW_NONE        INT16_MIN           // raw slot without a sample
+#define RAW_LEN         ((uint32_t) CONFIG_SMARTHOME_HISTORY_RAW_HOURS * 3600)
+#define ROLLUP_CNT      3
+#define LEVEL_CNT       (1 + ROLLUP_CNT)
+
+typedef sensor_history_rollup_t rollup_t;
+
+typedef struct {
+    uint32_t period;                        // seconds per slot
+    uint32_t len;                           // slots
+    int64_t head;                           // newest period (t / period), -1 before the first sample
+    int64_t first;                          // oldest period written
+    void *slots;                            // int16_t on the raw level, rollup_t on the others
+} level_t;
+
+typedef struct {
+    level_t levels[LEVEL_CNT];              // raw, then the rollups by increasing period
+    int64_t newest;                         // newest second with data, -1 before the first sample
+} history_t;
+
+static const uint32_t rollup_periods[ROLLUP_CNT] = { 60, 900, 3600 };
+
+static history_t histories[SENSOR_HISTORY_COUNT];
+static int64_t time_base;                   // sensor_history_now() at boot
+
+static void level_clear(level_t *l, uint32_t from, uint32_t cnt)
+{
+    if (l->period == 1) {
+        int16_t *raw = l->slots;
+        for (uint32_t i = 0; i < cnt; i++) raw[(from + i) % l->len] = RAW_NONE;
+    } else {
+        rollup_t *r = l->slots;
+        for (uint32_t i = 0; i < cnt; i++) r[(from + i) % l->len].cnt = 0;
+    }
+}
+
+// Make `p` the newest period of the level
+static void level_advance(level_t *l, int64_t p)
+{
+    if (l->head >= 0 && p > l->head) {
+        int64_t skipped = p - l->head;
+        if (skipped >= l->len) {
+            level_clear(l, 0, l->len);
+        } else {
+            level_clear(l, (uint32_t)((l->head + 1) % l->len), (uint32_t) skipped);
+        }
+    }
+    if (l->head < 0) l->first = p;
+    if (p > l->head) l->head = p;
+}
+
+// Whether period `p` is still held by the level
+static inline bool level_holds(const level_t *l, int64_t p)
+{
+    return l->head >= 0 && p <= l->head && p > l->head - l->len && p >= l->first;
+}
+
+static void rollup_merge(rollup_t *r, const rollup_t *add)
+{
+    if (r->cnt == 0) {
+        *r = *add;
+        return;
+    }
+    if (add->min < r->min) r->min = add->min;
+    if (add->max > r->max) r->max = add->max;
+    // 65535 x 32767 still fits the sum
+    uint32_t cnt = (uint32_t) r->cnt + add->cnt;
+    if (cnt <= UINT16_MAX) {
+        r->sum += add->sum;
+        r->cnt = (uint16_t) cnt;
+    }
+}
+
+static int16_t to_fixed(float value)
+{
+    float v = roundf(value * SCALE);
+    if (v > INT16_MAX) return INT16_MAX;
+    if (v < -INT16_MAX) return -INT16_MAX;      // INT16_MIN is RAW_NONE
+    return (int16_t) v;
+}
+
+// ------------------------------------------------------------
+// RECORDING
+// ------------------------------------------------------------
+void sensor_history_init(void)
+{
+    size_t total = 0;
+
+    for (int id = 0; id < SENSOR_HISTORY_COUNT; id++) {
+        history_t *h = &histories[id];
+        if (h->levels[0].slots) continue;
+
+        bool ok = true;
+        for (int i = 0; i < LEVEL_CNT; i++) {
+            level_t *l = &h->levels[i];
+            l->period = i == 0 ? 1 : rollup_periods[i - 1];
+            l->len = i == 0 ? RAW_LEN : (uint32_t) CONFIG_SMARTHOME_HISTORY_DAYS * 86400 / l->period;
+            l->head = -1;
+            l->first = 0;
+            size_t size = (size_t) l->len * (i == 0 ? sizeof(int16_t) : sizeof(rollup_t));
+            l->slots = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+            if (l->slots == NULL) {
+                ok = false;
+                continue;
+            }
+            level_clear(l, 0, l->len);
+            total += size;
+        }
+        h->newest = -1;
+
+        if (!ok) {
+            ESP_LOGE(TAG, "No memory for the history of sensor %d", id);
+            for (int i = 0; i < LEVEL_CNT; i++) {
+                free(h->levels[i].slots);
+                h->levels[i].slots = NULL;
+            }
+        }
+    }
+    ESP_LOGI(TAG, "%u KB for %d h of samples and %d days of rollups", (unsigned)(total / 1024),
+             CONFIG_SMARTHOME_HISTORY_RAW_HOURS, CONFIG_SMARTHOME_HISTORY_DAYS);
+}
+
+int64_t sensor_history_now(void)
+{
+    return time_base + esp_timer_get_time() / 1000000;
+}
+
+void sensor_history_set_now(int64_t t_s)
+{
+    time_base = t_s - esp_timer_get_time() / 1000000;
+}
+
+void sensor_history_add(sensor_history_id_t id, float value)
+{
+    sensor_history_add_at(id, sensor_history_now(), value);
+}
+
+void sensor_history_add_at(sensor_history_id_t id, int64_t t_s, float value)
+{
+    if ((unsigned) id >= SENSOR_HISTORY_COUNT || isnan(value)) return;
+    history_t *h = &histories[id];
+    if (h->levels[0].slots == NULL) return;
+
+    if (t_s < h->newest) t_s = h->newest;
+    if (t_s < 0) t_s = 0;
+    int16_t v = to_fixed(value);
+
+    level_t *raw = &h->levels[0];
+    level_advance(raw, t_s);
+    ((int16_t *) raw->slots)[t_s % raw->len] = v;
+    h->newest = t_s;
+
+    const rollup_t sample = { .sum = v, .min = v, .max = v, .cnt = 1 };
+    for (int i = 1; i < LEVEL_CNT; i++) {
+        level_t *l = &h->levels[i];
+        int64_t p = t_s / l->period;
+        level_advance(l, p);
+        rollup_merge(&((rollup_t *) l->slots)[p % l->len], &sample);
+    }
+}
+
+// ------------------------------------------------------------
+// MINUTES
+// The per-minute rollups hold everything the coarser levels are made
+// of, so saving them is enough to rebuild the history.
+// ------------------------------------------------------------
+bool sensor_history_get_minute(sensor_history_id_t id, int64_t minute, sensor_history_rollup_t *out)
+{
+    if ((unsigned) id >= SENSOR_HISTORY_COUNT || out == NULL) return false;
+    const level_t *l = &histories[id].levels[1];
+    if (l->slots == NULL || !level_holds(l, minute)) return false;
+
+    *out = ((const rollup_t *) l->slots)[minute % l->len];
+    return out->cnt != 0;
+}
+
+void sensor_history_add_minute(sensor_history_id_t id, int64_t minute, const sensor_history_rollup_t *r)
+{
+    if ((unsigned) id >= SENSOR_HISTORY_COUNT || r == NULL || r->cnt == 0 || minute < 0) return;
+    history_t *h = &histories[id];
+    if (h->levels[0].slots == NULL) return;
+
+    for (int i = 1; i < LEVEL_CNT; i++) {
+        level_t *l = &h->levels[i];
+        int64_t p = minute * 60 / l->period;
+        level_advance(l, p);
+        if (level_holds(l, p)) rollup_merge(&((rollup_t *) l->slots)[p % l->len], r);
+    }
+    if (minute * 60 + 59 > h->newest) h->newest = minute * 60 + 59;
+}
+
+// ------------------------------------------------------------
+// DECIMATION
+// A column is covered by the longest periods that fit in it: seconds
+// up to the first whole minute, minutes up to the first quarter hour,
+// and so on, then down again towards its end. That reads fewer than
+// 2 x (59 + 14 + 3) periods plus one per hour, and is exact as long
+// as the seconds are kept.
+// ------------------------------------------------------------
+typedef struct {
+    int32_t min;
+    int32_t max;
+    int64_t sum;
+    uint32_t cnt;
+} acc_t;
+
+static void level_read(const level_t *l, int64_t p, acc_t *acc)
+{
+    if (!level_holds(l, p)) return;
+
+    if (l->period == 1) {
+        int16_t v = ((const int16_t *) l->slots)[p % l->len];
+        if (v == RAW_NONE) return;
+        if (v < acc->min) acc->min = v;
+        if (v > acc->max) acc->max = v;
+        acc->sum += v;
+        acc->cnt++;
+    } else {
+        const rollup_t *r = &((const rollup_t *) l->slots)[p % l->len];
+        if (r->cnt == 0) return;
+        if (r->min < acc->min) acc->min = r->min;
+        if (r->max > acc->max) acc->max = r->max;
+        acc->sum += r->sum;
+        acc->cnt += r->cnt;
+    }
+}
+
+static void history_read(const history_t *h, int64_t t, int64_t end, acc_t *acc)
+{
+    while (t < end) {
+        // The longest period that starts at t and ends in the range
+        int i = LEVEL_CNT - 1;
+        while (i > 0 && (t % h->levels[i].period != 0 || t + h->levels[i].period > end)) i--;
+        // Once the finer levels dropped t, read the period around it from a coarser level
+        while (i < LEVEL_CNT - 1 && !level_holds(&h->levels[i], t / h->levels[i].period)) i++;
+
+        const level_t *l = &h->levels[i];
+        level_read(l, t / l->period, acc);
+        t = (t / l->period + 1) * l->period;
+    }
+}
+
+uint32_t sensor_history_decimate(sensor_history_id_t id, int64_t end_s, uint32_t span_s,
+                                 sensor_history_point_t *out, uint32_t cols)
+{
+    if (out == NULL) return 0;
+    for (uint32_t c = 0; c < cols; c++) {
+        out[c] = (sensor_history_point_t) { NAN, NAN, NAN };
+    }
+    if ((unsigned) id >= SENSOR_HISTORY_COUNT || span_s == 0) return 0;
+    const history_t *h = &histories[id];
+    if (h->levels[0].slots == NULL || h->newest < 0) return 0;
+
+    int64_t start = end_s - span_s + 1;
+    int64_t newest = h->newest;
+    uint32_t filled = 0;
+    for (uint32_t c = 0; c < cols; c++) {
+        int64_t c0 = start + (int64_t) c * span_s / cols;
+        int64_t c1 = start + (int64_t)(c + 1) * span_s / cols;
+        if (c0 < 0) c0 = 0;
+        if (c1 > newest + 1) c1 = newest + 1;
+
+        acc_t acc = { .min = INT16_MAX, .max = INT16_MIN };
+        history_read(h, c0, c1, &acc);
+        if (acc.cnt) {
+            out[c].min = (float) acc.min / SCALE;
+            out[c].max = (float) acc.max / SCALE;
+            out[c].avg = (float) acc.sum / acc.cnt / SCALE;
+            filled++;
+        }
+    }
+    return filled;
+}
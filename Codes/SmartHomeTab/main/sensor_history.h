@@ -0,0 +1,100 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+// Sensors with a recorded history
+typedef enum {
+    SENSOR_HISTORY_TEMPERATURE,
+    SENSOR_HISTORY_HUMIDITY,
+    SENSOR_HISTORY_LIGHT,
+    SENSOR_HISTORY_COUNT,
+} sensor_history_id_t;
+
+// One column of a decimated window. All NAN if the column has no sample.
+typedef struct {
+    float min;
+    float max;
+    float avg;
+} sensor_history_point_t;
+
+// Rollup of the samples of one period, in fixed-point hundredths
+typedef struct {
+    int32_t sum;
+    int16_t min;
+    int16_t max;
+    uint16_t cnt;                           // 0: no sample
+} sensor_history_rollup_t;
+
+/**
+ * @brief Allocate the history of every sensor in PSRAM.
+ *
+ * Each sensor keeps one sample per second for CONFIG_SMARTHOME_HISTORY_RAW_HOURS, and
+ * min/max/average rollups per minute, per 15 minutes and per hour for
+ * CONFIG_SMARTHOME_HISTORY_DAYS. Values are stored as fixed-point hundredths (-327.67 to 327.67).
+ * Time is in seconds, see sensor_history_now().
+ *
+ * The history is not locked: call all functions from one task (the LVGL task).
+ * A sensor whose buffers cannot be allocated records nothing.
+ */
+void sensor_history_init(void);
+
+// The time base of the history: seconds since boot, or since sensor_history_set_now()
+int64_t sensor_history_now(void);
+
+/**
+ * @brief Continue the time base of a history saved before a restart.
+ *
+ * sensor_history_now() returns `t_s` at the call and counts on from there, so restored periods
+ * keep their place behind the new samples. Call before recording.
+ */
+void sensor_history_set_now(int64_t t_s);
+
+/**
+ * @brief Record a value of a sensor at the current second.
+ *
+ * Several values within one second all count in the rollups; the raw sample keeps the last one.
+ */
+void sensor_history_add(sensor_history_id_t id, float value);
+
+/**
+ * @brief Record a value at a given second.
+ *
+ * Times before the newest recorded second are recorded at the newest second.
+ * Seconds skipped since the newest recorded second have no sample.
+ */
+void sensor_history_add_at(sensor_history_id_t id, int64_t t_s, float value);
+
+/**
+ * @brief Read the rollup of one minute (t / 60) of a sensor.
+ *
+ * @return False if the minute has no sample or is no longer kept
+ */
+bool sensor_history_get_minute(sensor_history_id_t id, int64_t minute, sensor_history_rollup_t *out);
+
+/**
+ * @brief Add the rollup of one minute read by sensor_history_get_minute(), e.g. from flash.
+ *
+ * The minute counts in the coarser rollups as well; its seconds are not restored, so windows
+ * that read them fall back to the minute. Add minutes oldest first.
+ */
+void sensor_history_add_minute(sensor_history_id_t id, int64_t minute, const sensor_history_rollup_t *r);
+
+/**
+ * @brief Reduce a time window to one min/max/average per column.
+ *
+ * Column `i` covers the seconds [start + i * span_s / cols, start + (i + 1) * span_s / cols)
+ * where start = end_s - span_s + 1. Each column is read from the longest rollups that fit in
+ * it and the samples at its edges, so its cost does not grow with `span_s` (at most 152 reads
+ * plus one per hour of the column) and its values are exact. Where the 1-second samples are
+ * no longer kept, the edges of a column are read from the rollup period around them.
+ *
+ * @param[in] id: Sensor
+ * @param[in] end_s: Last second of the window, e.g. sensor_history_now()
+ * @param[in] span_s: Length of the window (s)
+ * @param[out] out: `cols` columns, oldest first
+ * @param[in] cols: Number of columns
+ *
+ * @return Number of columns with at least one sample
+ */
+uint32_t sensor_history_decimate(sensor_history_id_t id, int64_t end_s, uint32_t span_s,
+                                 sensor_history_point_t *out, uint32_t cols);
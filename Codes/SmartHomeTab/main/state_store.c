@@ -0,0 +1,490 @@
+#include "state_store.h"
+#include "sensor_history.h"
+#include "ui_mqtt_bridge.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "lvgl.h"
+#include "sdkconfig.h"
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const char *TAG = "STATE_STORE";
+
+// ------------------------------------------------------------
+// LOG
+// The partition is a ring of flash sectors written in order and
+// erased only when the ring comes round, so every sector wears
+// alike. A sector starts with a header carrying its sequence
+// number; the newest sector is the one with the highest. Records
+// follow back to back. A record's header is written after its
+// data, so a power cut leaves either a whole record or erased
+// header bytes, and the CRC catches anything else.
+//
+// The oldest sector is dropped as the ring comes round: the log
+// holds about two weeks with the default checkpoint period.
+// ------------------------------------------------------------
+#define SECTOR_SIZE         4096
+#define SECTOR_MAGIC        0x54534853u     // "SHST", also the format version
+#define REC_BLANK           0xFFFF          // erased flash: no more records in the sector
+#define REC_MINUTES         1
+#define REC_STATE           2
+#define MINUTES_PER_REC     64
+#define HISTORY_MINUTES     ((int64_t) CONFIG_SMARTHOME_HISTORY_DAYS * 1440)
+#define WALL_VALID          1577836800      // 2020-01-01: the system time was set
+#define ALIGN4(n)           (((n) + 3u) & ~3u)
+#define WRITER_STACK_SIZE   (3 * 1024)
+#define WRITER_PRIORITY     (tskIDLE_PRIORITY + 1)  // below every other task
+
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;                           // sectors started before this one, plus one
+    uint32_t crc;                           // of magic and seq
+    uint32_t reserved;
+} sector_hdr_t;
+
+typedef struct {
+    uint16_t type;
+    uint16_t len;                           // of the data that follows
+    uint32_t crc;                           // of type, len and the data
+} rec_hdr_t;
+
+#define REC_MAX             (SECTOR_SIZE - sizeof(sector_hdr_t) - sizeof(rec_hdr_t))
+
+// Consecutive minutes of every sensor
+typedef struct {
+    int64_t minute;                         // first minute (t / 60)
+    uint16_t cnt;                           // minutes
+    uint16_t sensors;                       // rollups per minute
+    uint32_t reserved;
+    sensor_history_rollup_t r[];            // minute by minute
+} minutes_rec_t;
+
+// The clock and what the screens showed
+typedef struct {
+    int64_t now;                            // sensor_history_now()
+    int64_t wall;                           // time(), 0 if not set
+    char payloads[];                        // "topic\0payload\0" pairs
+} state_rec_t;
+
+// Records of one checkpoint, each a header followed by its data padded to 4 bytes
+typedef struct snapshot {
+    struct snapshot *next;
+    uint32_t len;
+    uint32_t cap;
+    alignas(8) uint8_t recs[];
+} snapshot_t;
+
+static const esp_partition_t *part;
+
+// The log, written by the writer task only once loaded
+static uint32_t sector_cnt;
+static uint32_t head;                       // sector written
+static uint32_t head_off;                   // first free byte in it
+static uint32_t seq;                        // of the head sector
+
+// Checkpoints, built in the LVGL task
+static int64_t saved_minute = -1;           // newest minute in the log
+static alignas(8) uint8_t rec_buf[REC_MAX];
+static uint32_t rec_len;
+static snapshot_t *snap;                    // checkpoint being built
+
+// Checkpoints waiting for the writer, oldest first, under queue_lock
+static portMUX_TYPE queue_lock = portMUX_INITIALIZER_UNLOCKED;
+static snapshot_t *queue_first;
+static snapshot_t *queue_last;
+static bool writing;                        // the writer has taken checkpoints it has not written yet
+static SemaphoreHandle_t write_sem;         // given when a checkpoint is queued
+static SemaphoreHandle_t idle_sem;          // given when the writer runs out of checkpoints
+
+static uint32_t rec_crc(uint16_t type, uint16_t len, const void *data)
+{
+    uint16_t tl[2] = { type, len };
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *) tl, sizeof(tl));
+    return esp_rom_crc32_le(crc, data, len);
+}
+
+static bool sector_hdr_valid(const sector_hdr_t *h)
+{
+    return h->magic == SECTOR_MAGIC &&
+           h->crc == esp_rom_crc32_le(0, (const uint8_t *) h, offsetof(sector_hdr_t, crc));
+}
+
+static esp_err_t sector_start(void)
+{
+    uint32_t next = (head + 1) % sector_cnt;
+    esp_err_t err = esp_partition_erase_range(part, (size_t) next * SECTOR_SIZE, SECTOR_SIZE);
+    if (err != ESP_OK) return err;
+
+    sector_hdr_t h = { .magic = SECTOR_MAGIC, .seq = seq + 1, .reserved = UINT32_MAX };
+    h.crc = esp_rom_crc32_le(0, (const uint8_t *) &h, offsetof(sector_hdr_t, crc));
+    err = esp_partition_write(part, (size_t) next * SECTOR_SIZE, &h, sizeof(h));
+    if (err != ESP_OK) return err;
+
+    head = next;
+    head_off = sizeof(h);
+    seq = h.seq;
+    return ESP_OK;
+}
+
+// `h` has the CRC of the `data` that follows it
+static esp_err_t log_append(const rec_hdr_t *h)
+{
+    uint32_t size = ALIGN4(sizeof(*h) + h->len);
+    if (head_off + size > SECTOR_SIZE) {
+        esp_err_t err = sector_start();
+        if (err != ESP_OK) return err;
+    }
+
+    size_t off = (size_t) head * SECTOR_SIZE + head_off;
+    esp_err_t err = esp_partition_write(part, off + sizeof(*h), h + 1, h->len);
+    if (err == ESP_OK) err = esp_partition_write(part, off, h, sizeof(*h));
+
+    // Even a failed write used the space
+    head_off += size;
+    return err;
+}
+
+// ------------------------------------------------------------
+// WRITER
+// Erasing a sector takes tens of milliseconds, so the flash is
+// written by a task of its own, below the LVGL task, and never
+// under the LVGL lock.
+// ------------------------------------------------------------
+static void snapshot_write(const snapshot_t *sn)
+{
+    for (uint32_t off = 0; off < sn->len; ) {
+        const rec_hdr_t *h = (const rec_hdr_t *)(sn->recs + off);
+        esp_err_t err = log_append(h);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Cannot save the %s: %s", h->type == REC_MINUTES ? "history" : "state",
+                     esp_err_to_name(err));
+        }
+        off += ALIGN4(sizeof(*h) + h->len);
+    }
+    ESP_LOGD(TAG, "Checkpoint, sector %u now at %u", (unsigned) head, (unsigned) head_off);
+}
+
+static void writer_task(void *arg)
+{
+    for (;;) {
+        xSemaphoreTake(write_sem, portMAX_DELAY);
+
+        for (;;) {
+            taskENTER_CRITICAL(&queue_lock);
+            snapshot_t *sn = queue_first;
+            queue_first = queue_last = NULL;
+            writing = sn != NULL;
+            taskEXIT_CRITICAL(&queue_lock);
+            if (sn == NULL) break;
+
+            while (sn) {
+                snapshot_t *next = sn->next;
+                snapshot_write(sn);
+                free(sn);
+                sn = next;
+            }
+        }
+        xSemaphoreGive(idle_sem);
+    }
+}
+
+// ------------------------------------------------------------
+// CHECKPOINT
+// Built in the LVGL task from the history and the bridge, then
+// queued for the writer.
+// ------------------------------------------------------------
+static void snap_add(uint16_t type, const void *data, uint16_t len)
+{
+    uint32_t size = ALIGN4(sizeof(rec_hdr_t) + len);
+    if (snap == NULL || snap->len + size > snap->cap) {
+        uint32_t cap = snap ? snap->cap * 2 : 2 * SECTOR_SIZE;
+        while (cap < (snap ? snap->len : 0) + size) cap *= 2;
+        snapshot_t *p = realloc(snap, sizeof(*snap) + cap);
+        if (p == NULL) {
+            ESP_LOGE(TAG, "No memory to save the %s", type == REC_MINUTES ? "history" : "state");
+            return;
+        }
+        if (snap == NULL) p->len = 0;
+        p->next = NULL;
+        p->cap = cap;
+        snap = p;
+    }
+
+    rec_hdr_t *h = (rec_hdr_t *)(snap->recs + snap->len);
+    h->type = type;
+    h->len = len;
+    h->crc = rec_crc(type, len, data);
+    memcpy(h + 1, data, len);
+    snap->len += size;
+}
+
+static void minutes_flush(minutes_rec_t *rec)
+{
+    if (rec->cnt == 0) return;
+    uint32_t len = sizeof(*rec) + (uint32_t) rec->cnt * rec->sensors * sizeof(rec->r[0]);
+    snap_add(REC_MINUTES, rec, (uint16_t) len);
+    rec->cnt = 0;
+}
+
+// The completed minutes since the last checkpoint, in runs of minutes with samples
+static void save_minutes(int64_t now)
+{
+    _Static_assert(sizeof(minutes_rec_t) + MINUTES_PER_REC * SENSOR_HISTORY_COUNT *
+                   sizeof(sensor_history_rollup_t) <= REC_MAX, "MINUTES_PER_REC too large");
+
+    int64_t last = now / 60 - 1;
+    int64_t m = saved_minute + 1;
+    if (m < last + 1 - HISTORY_MINUTES) m = last + 1 - HISTORY_MINUTES;
+
+    minutes_rec_t *rec = (minutes_rec_t *) rec_buf;
+    rec->cnt = 0;
+    rec->sensors = SENSOR_HISTORY_COUNT;
+    rec->reserved = 0;
+    for (; m <= last; m++) {
+        sensor_history_rollup_t *r = &rec->r[rec->cnt * SENSOR_HISTORY_COUNT];
+        bool any = false;
+        for (int id = 0; id < SENSOR_HISTORY_COUNT; id++) {
+            if (sensor_history_get_minute(id, m, &r[id])) any = true;
+            else r[id] = (sensor_history_rollup_t) { 0 };
+        }
+
+        if (!any) {
+            minutes_flush(rec);
+            continue;
+        }
+        if (rec->cnt == 0) rec->minute = m;
+        if (++rec->cnt == MINUTES_PER_REC) minutes_flush(rec);
+    }
+    minutes_flush(rec);
+    if (last > saved_minute) saved_minute = last;
+}
+
+static void state_add_payload(const char *topic, const char *payload, void *ctx)
+{
+    size_t tl = strlen(topic) + 1, pl = strlen(payload) + 1;
+    if (rec_len + tl + pl > REC_MAX) {
+        ESP_LOGW(TAG, "No room to save %s", topic);
+        return;
+    }
+    memcpy(rec_buf + rec_len, topic, tl);
+    memcpy(rec_buf + rec_len + tl, payload, pl);
+    rec_len += tl + pl;
+}
+
+static void save_state(int64_t now)
+{
+    state_rec_t *rec = (state_rec_t *) rec_buf;
+    time_t wall = time(NULL);
+    rec->now = now;
+    rec->wall = wall >= WALL_VALID ? (int64_t) wall : 0;
+    rec_len = sizeof(*rec);
+    ui_mqtt_bridge_foreach_payload(state_add_payload, NULL);
+    snap_add(REC_STATE, rec, (uint16_t) rec_len);
+}
+
+void state_store_checkpoint(void)
+{
+    if (part == NULL) return;
+
+    int64_t now = sensor_history_now();
+    save_minutes(now);
+    save_state(now);
+    if (snap == NULL) return;
+
+    taskENTER_CRITICAL(&queue_lock);
+    if (queue_last) queue_last->next = snap;
+    else queue_first = snap;
+    queue_last = snap;
+    taskEXIT_CRITICAL(&queue_lock);
+    snap = NULL;
+    xSemaphoreGive(write_sem);
+}
+
+bool state_store_wait(int timeout_ms)
+{
+    if (part == NULL) return true;
+
+    TickType_t ticks = timeout_ms < 0 ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    for (;;) {
+        taskENTER_CRITICAL(&queue_lock);
+        bool busy = queue_first != NULL || writing;
+        taskEXIT_CRITICAL(&queue_lock);
+        if (!busy) return true;
+        if (xSemaphoreTake(idle_sem, ticks) != pdTRUE) return false;
+    }
+}
+
+static void checkpoint_timer_cb(lv_timer_t *timer)
+{
+    state_store_checkpoint();
+}
+
+// ------------------------------------------------------------
+// RESTORE
+// ------------------------------------------------------------
+static void load_minutes(const uint8_t *data, uint16_t len)
+{
+    minutes_rec_t rec;
+    if (len < sizeof(rec)) return;
+    memcpy(&rec, data, sizeof(rec));
+    if (sizeof(rec) + (uint32_t) rec.cnt * rec.sensors * sizeof(rec.r[0]) > len) return;
+
+    const uint8_t *r = data + sizeof(rec);
+    for (uint16_t i = 0; i < rec.cnt; i++) {
+        for (uint16_t id = 0; id < rec.sensors; id++, r += sizeof(rec.r[0])) {
+            sensor_history_rollup_t roll;
+            memcpy(&roll, r, sizeof(roll));
+            if (id < SENSOR_HISTORY_COUNT) sensor_history_add_minute(id, rec.minute + i, &roll);
+        }
+    }
+    if (rec.cnt && rec.minute + rec.cnt - 1 > saved_minute) saved_minute = rec.minute + rec.cnt - 1;
+}
+
+// `data` is NULL if the log has no state record
+static void load_state(const uint8_t *data, uint16_t len)
+{
+    state_rec_t rec = { .now = 0, .wall = 0 };
+    if (data == NULL || len < sizeof(rec)) len = 0;
+    else memcpy(&rec, data, sizeof(rec));
+
+    // The history goes on where it stopped, after the time the tablet was off
+    int64_t now = rec.now;
+    if ((saved_minute + 1) * 60 > now) now = (saved_minute + 1) * 60;
+    time_t wall = time(NULL);
+    if (rec.wall > 0 && wall >= WALL_VALID && (int64_t) wall > rec.wall) now += (int64_t) wall - rec.wall;
+    sensor_history_set_now(now + 1);
+
+    if (len == 0) return;
+    const char *p = (const char *) data + sizeof(rec);
+    const char *end = (const char *) data + len;
+    while (p < end) {
+        const char *topic = p;
+        const char *payload = memchr(topic, '\0', end - topic);
+        if (payload == NULL || ++payload >= end) break;
+        p = memchr(payload, '\0', end - payload);
+        if (p == NULL) break;
+        p++;
+        ui_mqtt_bridge_restore(topic, payload);
+    }
+}
+
+// Apply the records of one sector; the offset after the last valid record
+static uint32_t load_sector(const uint8_t *sector, const uint8_t **state, uint16_t *state_len)
+{
+    uint32_t off = sizeof(sector_hdr_t);
+    while (off + sizeof(rec_hdr_t) <= SECTOR_SIZE) {
+        rec_hdr_t h;
+        memcpy(&h, sector + off, sizeof(h));
+        if (h.type == REC_BLANK) break;
+
+        const uint8_t *data = sector + off + sizeof(h);
+        if (off + sizeof(h) + h.len > SECTOR_SIZE || h.crc != rec_crc(h.type, h.len, data)) break;
+
+        if (h.type == REC_MINUTES) {
+            load_minutes(data, h.len);
+        } else if (h.type == REC_STATE) {
+            // Only the last one counts
+            *state = data;
+            *state_len = h.len;
+        }
+        off += ALIGN4(sizeof(h) + h.len);
+    }
+    return off;
+}
+
+static bool is_erased(const uint8_t *p, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        if (p[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+static void log_load(const uint8_t *flash)
+{
+    // Sectors are started in ring order, so the ring after the newest is oldest first
+    bool found = false;
+    for (uint32_t i = 0; i < sector_cnt; i++) {
+        const sector_hdr_t *h = (const sector_hdr_t *)(flash + (size_t) i * SECTOR_SIZE);
+        if (sector_hdr_valid(h) && (!found || h->seq > seq)) {
+            found = true;
+            head = i;
+            seq = h->seq;
+        }
+    }
+    if (!found) {
+        // The first record starts sector 0
+        head = sector_cnt - 1;
+        head_off = SECTOR_SIZE;
+        seq = 0;
+        return;
+    }
+
+    const uint8_t *state = NULL;
+    uint16_t state_len = 0;
+    uint32_t sectors = 0;
+    for (uint32_t i = 1; i <= sector_cnt; i++) {
+        uint32_t s = (head + i) % sector_cnt;
+        const uint8_t *sector = flash + (size_t) s * SECTOR_SIZE;
+        const sector_hdr_t *h = (const sector_hdr_t *) sector;
+        if (!sector_hdr_valid(h) || h->seq > seq || seq - h->seq >= sector_cnt) continue;
+
+        uint32_t end = load_sector(sector, &state, &state_len);
+        sectors++;
+        if (s == head) {
+            // Go on writing after the last record, unless a cut write left something behind it
+            head_off = is_erased(sector + end, SECTOR_SIZE - end) ? end : SECTOR_SIZE;
+        }
+    }
+    load_state(state, state_len);
+    ESP_LOGI(TAG, "Restored %u sectors, minutes up to %lld", (unsigned) sectors, (long long) saved_minute);
+}
+
+void state_store_init(void)
+{
+    if (part) return;
+
+    const esp_partition_t *p = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                        ESP_PARTITION_SUBTYPE_DATA_UNDEFINED, "state");
+    if (p == NULL || p->size < 2 * SECTOR_SIZE) {
+        ESP_LOGW(TAG, "No state partition, nothing is saved");
+        return;
+    }
+    part = p;
+    sector_cnt = part->size / SECTOR_SIZE;
+
+    // Read the whole log at once through the cache
+    int64_t t0 = esp_timer_get_time();
+    const void *flash;
+    esp_partition_mmap_handle_t map;
+    esp_err_t err = esp_partition_mmap(part, 0, (size_t) sector_cnt * SECTOR_SIZE, ESP_PARTITION_MMAP_DATA,
+                                       &flash, &map);
+    if (err == ESP_OK) {
+        log_load(flash);
+        esp_partition_munmap(map);
+    } else {
+        // Without knowing the newest sector, writing could overwrite it
+        ESP_LOGE(TAG, "Cannot map the state partition: %s", esp_err_to_name(err));
+        part = NULL;
+        return;
+    }
+    ESP_LOGI(TAG, "Loaded in %u ms", (unsigned)((esp_timer_get_time() - t0) / 1000));
+
+    write_sem = xSemaphoreCreateBinary();
+    idle_sem = xSemaphoreCreateBinary();
+    if (write_sem == NULL || idle_sem == NULL ||
+        xTaskCreate(writer_task, "state_store", WRITER_STACK_SIZE, NULL, WRITER_PRIORITY, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "Cannot start the writer, nothing is saved");
+        part = NULL;
+        return;
+    }
+    lv_timer_create(checkpoint_timer_cb, CONFIG_SMARTHOME_STATE_CHECKPOINT_S * 1000, NULL);
+}
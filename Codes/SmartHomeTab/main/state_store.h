@@ -0,0 +1,34 @@
+#pragma once
+#include <stdbool.h>
+
+/**
+ * @brief Show the state saved before the last restart and keep saving it.
+ *
+ * The `state` partition (partitions.csv) is a log of checkpoints: the completed minutes of the
+ * sensor history and the last payload of every topic bound to a widget, appended every
+ * CONFIG_SMARTHOME_STATE_CHECKPOINT_S. At init the whole log is read back: the minutes go into
+ * the sensor history, whose time base continues from the last checkpoint plus the time the
+ * tablet was off (from the system time), and the payloads are shown through
+ * ui_mqtt_bridge_restore().
+ *
+ * Call from the LVGL thread with the lock held, after sensor_history_init() and
+ * ui_mqtt_bridge_init() and before the first frame. Without the partition nothing is saved.
+ */
+void state_store_init(void);
+
+/**
+ * @brief Take a checkpoint now, e.g. before a planned restart. LVGL thread.
+ *
+ * Checkpoints are written to flash by a low-priority task, outside the LVGL lock: use
+ * state_store_wait() to know when it is saved.
+ */
+void state_store_checkpoint(void);
+
+/**
+ * @brief Wait until every checkpoint taken so far is written. Any task.
+ *
+ * @param[in] timeout_ms: Longest wait, negative to wait forever
+ *
+ * @return false on timeout
+ */
+bool state_store_wait(int timeout_ms);
@@ -0,0 +1,73 @@
+#include "ui_clock.h"
+#include "ui_numeric.h"
+#include "ui_screens.h"
+#include "ui.h"
+#include <stdio.h>
+
+static int shown_wday = -1;
+
+// ------------------------------------------------------------
+// Swap the labels for numeric displays whenever the home screen is built
+// ------------------------------------------------------------
+static lv_obj_t *numeric_from_label(lv_obj_t *scr, lv_obj_t *label)
+{
+    if (label == NULL || lv_obj_get_screen(label) != scr || !lv_obj_check_type(label, &lv_label_class)) {
+        return label;
+    }
+
+    // Digits take equal cells, so the text is wider than the designed label. Keep the left
+    // edge of the design so the date does not run into the day name.
+    lv_obj_t *parent = lv_obj_get_parent(label);
+    lv_area_t content;
+    lv_obj_update_layout(label);
+    lv_obj_get_content_coords(parent, &content);
+    lv_coord_t x = label->coords.x1 - content.x1;
+    lv_coord_t y = label->coords.y1 - content.y1;
+
+    lv_obj_t *obj = ui_numeric_replace_label(label);
+    lv_obj_set_align(obj, LV_ALIGN_TOP_LEFT);
+    lv_obj_set_pos(obj, x, y);
+    return obj;
+}
+
+static void screen_built_cb(lv_obj_t *scr)
+{
+    uic_time = numeric_from_label(scr, uic_time);
+    uic_date = numeric_from_label(scr, uic_date);
+}
+
+void ui_clock_init(void)
+{
+    ui_screens_add_build_cb(screen_built_cb);
+
+    ui_numeric_set_text(uic_time, "00:00:00");
+    ui_numeric_set_text(uic_date, "0000-00-00");
+    lv_label_set_text(uic_day, "Loading...");
+    shown_wday = -1;
+}
+
+void ui_clock_set(const struct tm *tm_now)
+{
+    static const char *days[] = {
+        "Sunday", "Monday", "Tuesday", "Wednesday",
+        "Thursday", "Friday", "Saturday"
+    };
+    char buf[UI_NUMERIC_MAX_CELLS + 1];
+
+    // Fields wrapped to their width, so the text always fits the cells
+    snprintf(buf, sizeof(buf), "%02u:%02u:%02u",
+             (unsigned) tm_now->tm_hour % 100u, (unsigned) tm_now->tm_min % 100u,
+             (unsigned) tm_now->tm_sec % 100u);
+    ui_numeric_set_text(uic_time, buf);
+
+    snprintf(buf, sizeof(buf), "%04u-%02u-%02u",
+             (unsigned) (tm_now->tm_year + 1900) % 10000u, (unsigned) (tm_now->tm_mon + 1) % 100u,
+             (unsigned) tm_now->tm_mday % 100u);
+    ui_numeric_set_text(uic_date, buf);
+
+    // A label relayouts on every set, even to the same text
+    if (tm_now->tm_wday != shown_wday && tm_now->tm_wday >= 0 && tm_now->tm_wday < 7) {
+        lv_label_set_text(uic_day, days[tm_now->tm_wday]);
+        shown_wday = tm_now->tm_wday;
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <time.h>
+
+/**
+ * @brief Turn the time and date labels of the home screen into numeric displays.
+ *
+ * uic_time and uic_date then point at the numeric displays (see ui_numeric.h); use
+ * ui_clock_set() rather than lv_label_set_text() on them. Shows placeholders until the
+ * first ui_clock_set(). Call under the LVGL lock after ui_screens_init().
+ */
+void ui_clock_init(void);
+
+/**
+ * @brief Show a time. Only the digits that changed are redrawn. Call under the LVGL lock.
+ */
+void ui_clock_set(const struct tm *tm_now);
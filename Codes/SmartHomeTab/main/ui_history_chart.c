@@ -0,0 +1,254 @@
+#include "ui_history_chart.h"
+#include "sensor_history.h"
+#include "ui_screens.h"
+#include "ui.h"
+#include "esp_heap_caps.h"
+#include "sdkconfig.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ------------------------------------------------------------
+// WINDOWS
+// The labels of the X axis fall on whole units of time.
+// ------------------------------------------------------------
+#define MAX_COLS        256
+#define Y_SCALE         10                  // chart values are tenths
+
+typedef struct {
+    uint32_t span_s;
+    uint8_t intervals;                      // between the labels of the X axis
+} window_t;
+
+static const window_t windows[] = {
+    { 60,           6 },                    // 10 s
+    { 15 * 60,      3 },                    // 5 min
+    { 3600,         4 },                    // 15 min
+    { 6 * 3600,     6 },                    // 1 h
+    { 86400,        6 },                    // 4 h
+    { 7 * 86400,    7 },                    // 1 day
+};
+#define WINDOW_CNT      (sizeof(windows) / sizeof(windows[0]))
+
+typedef struct {
+    lv_obj_t **chart;                       // SquareLine variable
+    sensor_history_id_t id;
+    uint8_t window;                         // index in windows[], kept while the chart is deleted
+    lv_chart_series_t *ser;
+    lv_timer_t *timer;                      // NULL while the chart is deleted
+    lv_coord_t width;                       // content width of the chart
+    lv_opa_t *cache;                        // the drawn line, see lv_chart_set_cache_buf()
+    int64_t end;                            // last second shown
+    uint32_t col_s;
+    uint32_t cols;
+    int32_t y0, y1;                         // range of the Y axis in whole units
+    lv_coord_t points[2 * MAX_COLS];        // min and max of each column, a ring once the chart shifted
+} view_t;
+
+static view_t views[] = {
+    { .chart = &uic_tempChart,  .id = SENSOR_HISTORY_TEMPERATURE },
+    { .chart = &uic_humiChart,  .id = SENSOR_HISTORY_HUMIDITY },
+    { .chart = &uic_lightChart, .id = SENSOR_HISTORY_LIGHT },
+};
+#define VIEW_CNT        (sizeof(views) / sizeof(views[0]))
+
+static sensor_history_point_t cols_buf[MAX_COLS];
+static lv_coord_t next_points[2 * MAX_COLS];
+
+// The windows the rollups reach back to
+static uint32_t window_cnt(void)
+{
+    uint32_t n = 1;
+    while (n < WINDOW_CNT && windows[n].span_s <= (uint32_t) CONFIG_SMARTHOME_HISTORY_DAYS * 86400) n++;
+    return n;
+}
+
+static void format_age(char *buf, size_t len, uint32_t age_s)
+{
+    if (age_s == 0) snprintf(buf, len, "now");
+    else if (age_s % 86400 == 0) snprintf(buf, len, "%ud", (unsigned)(age_s / 86400));
+    else if (age_s % 3600 == 0) snprintf(buf, len, "%uh", (unsigned)(age_s / 3600));
+    else if (age_s % 60 == 0) snprintf(buf, len, "%um", (unsigned)(age_s / 60));
+    else snprintf(buf, len, "%us", (unsigned) age_s);
+}
+
+// ------------------------------------------------------------
+// VIEW
+// ------------------------------------------------------------
+// Whole seconds per column; windows shorter than the chart get one column per second
+static uint32_t view_col_s(const view_t *v)
+{
+    uint32_t max_cols = LV_CLAMP(1, v->width, MAX_COLS);
+    return (windows[v->window].span_s + max_cols - 1) / max_cols;
+}
+
+// Move the chart by the columns that started since the last refresh, so only they are drawn.
+// False if anything else changed and the chart needs to be drawn in full.
+static bool view_shift(view_t *v, uint32_t col_s, uint32_t cols, int64_t end, int32_t y0, int32_t y1)
+{
+    lv_obj_t *chart = *v->chart;
+
+    if (v->cache == NULL || col_s != v->col_s || cols != v->cols || y0 != v->y0 || y1 != v->y1 ||
+        end < v->end || (end - v->end) / col_s >= cols) {
+        return false;
+    }
+
+    // The columns that were complete must have stayed as they were; only the last one fills up
+    uint32_t k = (uint32_t)((end - v->end) / col_s);             // new columns
+    uint32_t cnt = 2 * cols;
+    uint32_t start = lv_chart_get_x_start_point(chart, v->ser) + 2 * k;
+    uint32_t keep = cnt - 2 * k - 2;
+    for (uint32_t i = 0; i < keep; i++) {
+        if (v->points[(start + i) % cnt] != next_points[i]) return false;
+    }
+    for (uint32_t i = keep; i < keep + 2; i++) {
+        uint16_t id = (start + i) % cnt;
+        if (v->points[id] != next_points[i]) lv_chart_set_value_by_id(chart, v->ser, id, next_points[i]);
+    }
+    for (uint32_t i = keep + 2; i < cnt; i++) {
+        lv_chart_set_next_value(chart, v->ser, next_points[i]);
+    }
+    return true;
+}
+
+static void view_refresh(view_t *v)
+{
+    lv_obj_t *chart = *v->chart;
+
+    // Columns start on multiples of their length, so the data moves by whole columns
+    uint32_t col_s = view_col_s(v);
+    uint32_t cols = windows[v->window].span_s / col_s;
+    int64_t now = sensor_history_now();
+    int64_t end = now - now % col_s + col_s - 1;
+    uint32_t filled = sensor_history_decimate(v->id, end, cols * col_s, cols_buf, cols);
+
+    float lo = INFINITY, hi = -INFINITY;
+    for (uint32_t c = 0; c < cols; c++) {
+        const sensor_history_point_t *p = &cols_buf[c];
+        if (isnan(p->min)) {
+            next_points[2 * c] = LV_CHART_POINT_NONE;
+            next_points[2 * c + 1] = LV_CHART_POINT_NONE;
+            continue;
+        }
+        next_points[2 * c] = (lv_coord_t) lroundf(p->min * Y_SCALE);
+        next_points[2 * c + 1] = (lv_coord_t) lroundf(p->max * Y_SCALE);
+        lo = fminf(lo, p->min);
+        hi = fmaxf(hi, p->max);
+    }
+
+    // Whole units at the labels of the Y axis, the data centered between them
+    int32_t y0 = 0, y1 = 100;
+    if (filled) {
+        int32_t steps = ((lv_chart_t *) chart)->tick[LV_CHART_AXIS_PRIMARY_Y].major_cnt - 1;
+        if (steps < 1) steps = 1;
+        y0 = (int32_t) floorf(lo);
+        y1 = (int32_t) ceilf(hi);
+        int32_t step = (y1 - y0 + steps - 1) / steps;
+        if (step < 1) step = 1;
+        y0 -= (step * steps - (y1 - y0)) / 2;
+        if (y0 < 0 && lo >= 0) y0 = 0;
+        y1 = y0 + step * steps;
+    }
+
+    if (!view_shift(v, col_s, cols, end, y0, y1)) {
+        lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, y0 * Y_SCALE, y1 * Y_SCALE);
+        lv_chart_set_range(chart, LV_CHART_AXIS_SECONDARY_Y, y0 * Y_SCALE, y1 * Y_SCALE);
+
+        lv_chart_set_point_count(chart, 2 * cols);
+        memcpy(v->points, next_points, 2 * cols * sizeof(lv_coord_t));
+        if (lv_chart_get_y_array(chart, v->ser) != v->points) {
+            lv_chart_set_ext_y_array(chart, v->ser, v->points);
+        }
+        lv_chart_set_x_start_point(chart, v->ser, 0);
+        lv_chart_refresh(chart);
+    }
+    v->end = end;
+    v->col_s = col_s;
+    v->cols = cols;
+    v->y0 = y0;
+    v->y1 = y1;
+}
+
+static void view_set_window(view_t *v)
+{
+    lv_obj_t *chart = *v->chart;
+    const window_t *w = &windows[v->window];
+    const lv_chart_tick_dsc_t *t = &((lv_chart_t *) chart)->tick[LV_CHART_AXIS_PRIMARY_X];
+
+    // Keep the tick lengths of the design, with a label and a grid line per interval
+    lv_chart_set_axis_tick(chart, LV_CHART_AXIS_PRIMARY_X, t->major_len, t->minor_len, w->intervals + 1,
+                           t->minor_cnt, t->label_en, t->draw_size);
+    lv_chart_set_div_line_count(chart, ((lv_chart_t *) chart)->hdiv_cnt, w->intervals + 1);
+
+    // The last column fills up as samples arrive; show them within 10 s on the wide windows
+    lv_timer_set_period(v->timer, LV_CLAMP(1, view_col_s(v), 10) * 1000);
+}
+
+static void timer_cb(lv_timer_t *timer)
+{
+    view_refresh(timer->user_data);
+}
+
+static void chart_event_cb(lv_event_t *e)
+{
+    view_t *v = lv_event_get_user_data(e);
+    lv_event_code_t code = lv_event_get_code(e);
+
+    if (code == LV_EVENT_DRAW_PART_BEGIN) {
+        lv_obj_draw_part_dsc_t *dsc = lv_event_get_draw_part_dsc(e);
+        if (dsc->part != LV_PART_TICKS || dsc->text == NULL) return;
+
+        if (dsc->id == LV_CHART_AXIS_PRIMARY_X) {
+            const window_t *w = &windows[v->window];
+            format_age(dsc->text, dsc->text_length, w->span_s / w->intervals * (w->intervals - dsc->value));
+        } else {
+            snprintf(dsc->text, dsc->text_length, "%d", (int)(dsc->value / Y_SCALE));
+        }
+    } else if (code == LV_EVENT_CLICKED) {
+        v->window = (v->window + 1) % window_cnt();
+        view_set_window(v);
+        view_refresh(v);
+    } else if (code == LV_EVENT_DELETE) {
+        lv_timer_del(v->timer);
+        v->timer = NULL;
+        v->ser = NULL;
+        free(v->cache);
+        v->cache = NULL;
+    }
+}
+
+// ------------------------------------------------------------
+// Take over the charts whenever Screen2 is built
+// ------------------------------------------------------------
+static void screen_built_cb(lv_obj_t *scr)
+{
+    for (size_t i = 0; i < VIEW_CNT; i++) {
+        view_t *v = &views[i];
+        lv_obj_t *chart = *v->chart;
+        if (chart == NULL || lv_obj_get_screen(chart) != scr || v->timer) continue;
+
+        lv_obj_update_layout(chart);
+        v->width = lv_obj_get_content_width(chart);
+        v->ser = lv_chart_get_series_next(chart, NULL);
+        if (v->ser == NULL) v->ser = lv_chart_add_series(chart, lv_color_hex(0x808080), LV_CHART_AXIS_PRIMARY_Y);
+        lv_obj_set_style_size(chart, 0, LV_PART_INDICATOR);     // a line, no point markers
+        lv_obj_add_event_cb(chart, chart_event_cb, LV_EVENT_ALL, v);
+
+        // Keep the drawn line so a refresh draws only the new columns
+        size_t cache_size = lv_chart_get_cache_size(chart);
+        v->cache = heap_caps_malloc(cache_size, MALLOC_CAP_SPIRAM);
+        if (v->cache) lv_chart_set_cache_buf(chart, v->cache, cache_size);
+        v->cols = 0;
+
+        v->timer = lv_timer_create(timer_cb, 1000, v);
+        if (v->window >= window_cnt()) v->window = 0;
+        view_set_window(v);
+        view_refresh(v);
+    }
+}
+
+void ui_history_chart_init(void)
+{
+    ui_screens_add_build_cb(screen_built_cb);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+/**
+ * @brief Draw the sensor charts of Screen2 from the sensor history.
+ *
+ * Each chart shows one min/max pair per pixel column of a time window ending now, read with
+ * sensor_history_decimate(), so every window costs the same to draw. A tap on a chart moves
+ * it to the next window: 1 min, 15 min, 1 h, 6 h, 1 day, 1 week, then back to 1 min.
+ * The window of each chart is kept while Screen2 is deleted. The Y range follows the data.
+ * While the range stays, a refresh scrolls the drawn line and draws only the new columns
+ * (lv_chart_set_cache_buf()), the buffer of which is taken from PSRAM.
+ *
+ * Call under the LVGL lock after sensor_history_init() and ui_screens_init().
+ */
+void ui_history_chart_init(void);
@@ -0,0 +1,298 @@
+#include "ui_img_rle.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if LV_COLOR_DEPTH != 16
+#error "The RLE images are RGB565 (tools/img_rle.py)"
+#endif
+
+static const char *TAG = "UI_IMG_RLE";
+
+// ------------------------------------------------------------
+// STREAM (see tools/img_rle.py)
+// ------------------------------------------------------------
+#define RLE_HEADER_SIZE     12          // format, pixel size, box, run count
+#define SPAN_TRANSP         0
+#define SPAN_OPAQUE         1
+#define SPAN_SEMI           2
+#define SPAN_KIND(run)      ((run) >> 14)
+#define SPAN_LEN(run)       ((run) & 0x3FFF)
+
+// An inflated image. The box and spans stay in flash, in the stream.
+typedef struct {
+    const uint8_t *buf;                 // inflated pixels, NULL if the slot is free
+    lv_coord_t w;
+    lv_coord_t h;
+    lv_area_t box;                      // pixels outside are transparent; relative to the image
+    const uint8_t *row_index;           // first run of each box row (u16), NULL without spans
+    const uint8_t *runs;                // u16 each
+} rle_img_t;
+
+// Every image cache entry keeps its image open; without the cache, one image is open at a time
+#define RLE_OPEN_MAX    (LV_IMG_CACHE_DEF_SIZE + 1)
+
+static rle_img_t open_imgs[RLE_OPEN_MAX];
+
+// The stream has no alignment, read byte by byte
+static inline uint16_t rd16(const uint8_t *p, uint32_t i)
+{
+    return (uint16_t)(p[2 * i] | (p[2 * i + 1] << 8));
+}
+
+// Box and spans; returns the start of the pixel packets or NULL if the header is bad
+static const uint8_t *parse_header(const lv_img_dsc_t *dsc, rle_img_t *img)
+{
+    const uint8_t *d = dsc->data;
+    uint32_t ofs = RLE_HEADER_SIZE;
+
+    if (dsc->data_size < RLE_HEADER_SIZE) return NULL;
+
+    img->w = dsc->header.w;
+    img->h = dsc->header.h;
+    img->box.x1 = rd16(d + 2, 0);
+    img->box.y1 = rd16(d + 2, 1);
+    img->box.x2 = rd16(d + 2, 2);
+    img->box.y2 = rd16(d + 2, 3);
+    img->row_index = NULL;
+    img->runs = NULL;
+
+    uint32_t run_cnt = rd16(d + 2, 4);
+    if (run_cnt) {
+        if (img->box.x1 > img->box.x2 || img->box.y1 > img->box.y2 ||
+            img->box.x2 >= img->w || img->box.y2 >= img->h) {
+            return NULL;
+        }
+        uint32_t rows = lv_area_get_height(&img->box);
+        img->row_index = d + ofs;
+        ofs += 2 * (rows + 1);
+        img->runs = d + ofs;
+        ofs += 2 * run_cnt;
+        if (ofs > dsc->data_size || rd16(img->row_index, rows) != run_cnt) return NULL;
+    }
+    return d + ofs;
+}
+
+// ------------------------------------------------------------
+// DECODING
+// Images with alpha are inflated to LV_IMG_CF_RGB565A8: all colors, then
+// all opacities. Opaque spans are then plain copies of the color plane.
+// ------------------------------------------------------------
+static inline void put_px(uint8_t *out, uint32_t px_cnt, uint8_t px_size, uint32_t i, const uint8_t *px)
+{
+    if (px_size == 3) {
+        out[2 * i] = px[0];
+        out[2 * i + 1] = px[1];
+        out[2 * px_cnt + i] = px[2];
+    } else {
+        memcpy(out + i * px_size, px, px_size);
+    }
+}
+
+static bool rle_decode(const uint8_t *in, const uint8_t *in_end, uint8_t px_size, uint8_t *out, uint32_t px_cnt)
+{
+    uint32_t i = 0;
+
+    while (i < px_cnt) {
+        if (in >= in_end) return false;
+        uint8_t c = *in++;
+        uint32_t n = (uint32_t)(c & 0x7F) + 1;
+
+        if (n > px_cnt - i) return false;
+
+        if (c & 0x80) {
+            // Mostly runs of transparent pixels
+            if ((uint32_t)(in_end - in) < px_size) return false;
+            for (uint32_t end = i + n; i < end; i++) put_px(out, px_cnt, px_size, i, in);
+            in += px_size;
+        } else {
+            if ((uint32_t)(in_end - in) < n * px_size) return false;
+            for (uint32_t end = i + n; i < end; i++, in += px_size) put_px(out, px_cnt, px_size, i, in);
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------
+// LVGL DECODER
+// ------------------------------------------------------------
+static lv_res_t rle_info(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header)
+{
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) return LV_RES_INV;
+
+    const lv_img_dsc_t *img = src;
+    if (img->header.cf != UI_IMG_RLE_CF || img->data_size < RLE_HEADER_SIZE) return LV_RES_INV;
+
+    // Report the format of the inflated pixels, so drawing takes the usual paths
+    header->always_zero = 0;
+    header->w = img->header.w;
+    header->h = img->header.h;
+    header->cf = img->data[0] == LV_IMG_CF_TRUE_COLOR_ALPHA ? LV_IMG_CF_RGB565A8 : img->data[0];
+    return LV_RES_OK;
+}
+
+static lv_res_t rle_open(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    const lv_img_dsc_t *src = dsc->src;
+    uint8_t px_size = src->data[1];
+    uint32_t px_cnt = (uint32_t) src->header.w * src->header.h;
+    rle_img_t img;
+
+    const uint8_t *pixels = parse_header(src, &img);
+    if (pixels == NULL || px_size != lv_img_cf_get_px_size(src->data[0]) / 8) {
+        ESP_LOGE(TAG, "Bad header of a %dx%d image", src->header.w, src->header.h);
+        return LV_RES_INV;
+    }
+
+    uint8_t *buf = heap_caps_malloc(px_cnt * px_size, MALLOC_CAP_SPIRAM);
+    if (buf == NULL) buf = malloc(px_cnt * px_size);
+    if (buf == NULL) {
+        ESP_LOGW(TAG, "No memory to inflate a %dx%d image", src->header.w, src->header.h);
+        dsc->error_msg = "out of memory";
+        return LV_RES_INV;
+    }
+
+    if (!rle_decode(pixels, src->data + src->data_size, px_size, buf, px_cnt)) {
+        ESP_LOGE(TAG, "Corrupt %dx%d image", src->header.w, src->header.h);
+        free(buf);
+        return LV_RES_INV;
+    }
+
+    // Remember the spans for drawing; without a free slot the image is drawn by LVGL alone
+    lv_refr_lock_shared();
+    for (int i = 0; i < RLE_OPEN_MAX; i++) {
+        if (open_imgs[i].buf == NULL) {
+            img.buf = buf;
+            open_imgs[i] = img;
+            break;
+        }
+    }
+    lv_refr_unlock_shared();
+
+    dsc->img_data = buf;
+    return LV_RES_OK;
+}
+
+static void rle_close(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    lv_refr_lock_shared();
+    for (int i = 0; i < RLE_OPEN_MAX; i++) {
+        if (open_imgs[i].buf == dsc->img_data) open_imgs[i].buf = NULL;
+    }
+    lv_refr_unlock_shared();
+    free((void *) dsc->img_data);
+    dsc->img_data = NULL;
+}
+
+// ------------------------------------------------------------
+// DRAWING
+// Plain copies of inflated images walk the spans: transparent spans are
+// skipped, opaque ones copied and only the edges are blended. The rest
+// (transforms, recoloring, masks, ...) is left to LVGL.
+// ------------------------------------------------------------
+static void (*base_draw_img_decoded)(lv_draw_ctx_t *draw_ctx, const lv_draw_img_dsc_t *dsc,
+                                     const lv_area_t *coords, const uint8_t *src_buf, lv_img_cf_t cf);
+
+// Copies the slot out: another band may be opening or closing an image meanwhile
+static bool open_find(const uint8_t *buf, rle_img_t *img)
+{
+    bool found = false;
+    lv_refr_lock_shared();
+    for (int i = 0; i < RLE_OPEN_MAX && !found; i++) {
+        if (open_imgs[i].buf == buf) {
+            *img = open_imgs[i];
+            found = true;
+        }
+    }
+    lv_refr_unlock_shared();
+    return found;
+}
+
+// Same results as the masked map_normal() of lv_draw_sw_blend.c
+static void draw_span(lv_color_t *dest, const lv_color_t *color, const lv_opa_t *alpha,
+                      lv_coord_t len, uint16_t kind, lv_opa_t opa)
+{
+    if (opa > LV_OPA_MAX) {
+        if (kind == SPAN_OPAQUE) {
+            lv_memcpy(dest, color, len * sizeof(lv_color_t));
+            return;
+        }
+        for (lv_coord_t i = 0; i < len; i++) {
+            dest[i] = lv_color_mix(color[i], dest[i], alpha[i]);
+        }
+    } else {
+        for (lv_coord_t i = 0; i < len; i++) {
+            lv_opa_t a = alpha[i] >= LV_OPA_MAX ? opa : (lv_opa_t)((opa * alpha[i]) >> 8);
+            dest[i] = lv_color_mix(color[i], dest[i], a);
+        }
+    }
+}
+
+static void rle_draw_img_decoded(lv_draw_ctx_t *draw_ctx, const lv_draw_img_dsc_t *dsc,
+                                 const lv_area_t *coords, const uint8_t *src_buf, lv_img_cf_t cf)
+{
+    rle_img_t img;
+    lv_disp_drv_t *drv = _lv_refr_get_disp_refreshing()->driver;
+
+    if (!open_find(src_buf, &img) || img.runs == NULL || cf != LV_IMG_CF_RGB565A8 ||
+        dsc->angle != 0 || dsc->zoom != LV_IMG_ZOOM_NONE || dsc->recolor_opa != LV_OPA_TRANSP ||
+        dsc->blend_mode != LV_BLEND_MODE_NORMAL ||
+        lv_area_get_width(coords) != img.w || lv_area_get_height(coords) != img.h ||
+        drv->set_px_cb || drv->screen_transp || !drv->antialiasing ||
+        lv_draw_mask_is_any(draw_ctx->clip_area)) {
+        base_draw_img_decoded(draw_ctx, dsc, coords, src_buf, cf);
+        return;
+    }
+
+    lv_area_t box = img.box;
+    lv_area_t draw_area;
+    lv_area_move(&box, coords->x1, coords->y1);
+    if (!_lv_area_intersect(&draw_area, &box, draw_ctx->clip_area)) return;
+
+    if (draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+
+    const lv_color_t *src_color = (const lv_color_t *) src_buf;
+    const lv_opa_t *src_alpha = src_buf + sizeof(lv_color_t) * img.w * img.h;
+    lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
+    lv_color_t *dest = (lv_color_t *) draw_ctx->buf + dest_stride * (draw_area.y1 - draw_ctx->buf_area->y1) +
+                       (draw_area.x1 - draw_ctx->buf_area->x1);
+
+    for (lv_coord_t y = draw_area.y1; y <= draw_area.y2; y++, dest += dest_stride) {
+        uint32_t row = y - box.y1;
+        int32_t row_px = (int32_t)(y - coords->y1) * img.w - coords->x1;    // pixel index minus x
+        uint32_t end = rd16(img.row_index, row + 1);
+        lv_coord_t x = box.x1;
+
+        for (uint32_t r = rd16(img.row_index, row); r < end && x <= draw_area.x2; r++) {
+            uint16_t run = rd16(img.runs, r);
+            lv_coord_t x1 = LV_MAX(x, draw_area.x1);
+            lv_coord_t x2 = LV_MIN(x + SPAN_LEN(run) - 1, draw_area.x2);
+            x += SPAN_LEN(run);
+            if (x1 > x2 || SPAN_KIND(run) == SPAN_TRANSP) continue;
+
+            draw_span(dest + (x1 - draw_area.x1), src_color + (row_px + x1), src_alpha + (row_px + x1),
+                      x2 - x1 + 1, SPAN_KIND(run), dsc->opa);
+        }
+    }
+}
+
+void ui_img_rle_init(void)
+{
+    lv_img_decoder_t *decoder = lv_img_decoder_create();
+    if (decoder == NULL) {
+        ESP_LOGE(TAG, "Can't create the image decoder");
+        return;
+    }
+    lv_img_decoder_set_info_cb(decoder, rle_info);
+    lv_img_decoder_set_open_cb(decoder, rle_open);
+    lv_img_decoder_set_close_cb(decoder, rle_close);
+
+    lv_disp_t *disp = lv_disp_get_default();
+    if (disp == NULL || disp->driver->draw_ctx == NULL) {
+        ESP_LOGW(TAG, "No display yet, images are drawn without their spans");
+        return;
+    }
+    base_draw_img_decoded = disp->driver->draw_ctx->draw_img_decoded;
+    disp->driver->draw_ctx->draw_img_decoded = rle_draw_img_decoded;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "lvgl.h"
+
+// Color format of the images compressed by tools/img_rle.py
+#define UI_IMG_RLE_CF   LV_IMG_CF_USER_ENCODED_0
+
+/**
+ * @brief Register the image decoder of the RLE-compressed UI images.
+ *
+ * The build runs tools/img_rle.py on the SquareLine images (main/ui/ui_img_*.c), so they
+ * are stored run-length encoded in flash. An image is inflated in PSRAM when it is first
+ * drawn and the buffer belongs to the LVGL image cache entry: it is reused by every later
+ * draw and freed when the cache evicts the entry (CONFIG_LV_IMG_CACHE_DEF_SIZE entries).
+ *
+ * The converter also stores the box of the non-transparent pixels and the transparent,
+ * opaque and semi-transparent spans of its rows. Untransformed images are drawn on the
+ * default display along these spans: transparent ones are skipped and opaque ones copied.
+ *
+ * Must be called after the display is registered and before any image is set.
+ */
+void ui_img_rle_init(void);
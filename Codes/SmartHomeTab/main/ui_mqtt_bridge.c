@@ -1,11 +1,15 @@
 #include "ui_mqtt_bridge.h"
 #include "mqtt_manager.h"
 #include "ui.h"
+#include "ui_screens.h"
+#include "sensor_history.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include "esp_timer.h" 
-#include "driver/i2c.h" 
+#include "esp_log.h"
+#include "i2c_bus.h"
 
 static bool is_muted = false; 
 
@@ -30,6 +34,11 @@ static backlight_state_t current_backlight_state = STATE_BRIGHT;
 #define TEMP_THRESHOLD_LOW  26.0f
 #define ALARM_INTERVAL_MS   60000  
 
+// --- Update filtering (see ui_mqtt_bridge_register) ---
+#define DEADBAND_ALWAYS     (-1.0f)     // every value, e.g. chart samples and the alarm
+#define DEADBAND_EXACT      0.0f        // skip repeats of the same value
+#define SENSOR_DEADBAND     0.05f       // hysteresis of the temperature/humidity readouts
+
 static bool alarm_active = false;
 static int64_t last_alarm_time = 0;
 
@@ -37,120 +46,559 @@ static int64_t last_alarm_time = 0;
 #define CMD_V13_BUZZER_ON  0xF6
 #define CMD_V13_BUZZER_OFF 0xF7
 
+// I2C sequence channels: a new sequence replaces the running one of its channel
+#define SEQ_BUZZER         0
+#define SEQ_BACKLIGHT      1
+
 static const char *TAG = "UI_MQTT_BRIDGE";
 
-static float to_float(const char *s) { return atof(s); }
+static int clamp_0_100(float v) {
+    if (v < 0) return 0;
+    if (v > 100) return 100;
+    return (int)v;
+}
+
+// Two beeps, played by the I2C bus task
+static void trigger_temp_alert() {
+    static const i2c_bus_step_t beeps[] = {
+        { DEVICE_ADDR_STC8, CMD_V13_BUZZER_ON,  100 },
+        { DEVICE_ADDR_STC8, CMD_V13_BUZZER_OFF, 150 },
+        { DEVICE_ADDR_STC8, CMD_V13_BUZZER_ON,  100 },
+        { DEVICE_ADDR_STC8, CMD_V13_BUZZER_OFF, 0 },
+    };
+    i2c_bus_submit_seq(SEQ_BUZZER, beeps, sizeof(beeps) / sizeof(beeps[0]));
+}
 
-static void ui_update_label(lv_obj_t *label, const char *value) {
+static void set_backlight(uint8_t val) {
+    const i2c_bus_step_t step = { DEVICE_ADDR_STC8, val, 0 };
+    i2c_bus_submit_seq(SEQ_BACKLIGHT, &step, 1);
+}
+
+// ------------------------------------------------------------
+// PARSERS
+// ------------------------------------------------------------
+bool ui_mqtt_parse_float(const char *payload, ui_mqtt_value_t *out) {
+    char *end;
+    out->num = strtof(payload, &end);
+    return end != payload;
+}
+
+bool ui_mqtt_parse_percent(const char *payload, ui_mqtt_value_t *out) {
+    if (!ui_mqtt_parse_float(payload, out)) return false;
+    out->num = clamp_0_100(out->num);
+    return true;
+}
+
+bool ui_mqtt_parse_on_off(const char *payload, ui_mqtt_value_t *out) {
+    out->on = (strcmp(payload, "ON") == 0);
+    return true;
+}
+
+// ------------------------------------------------------------
+// HANDLERS
+// ------------------------------------------------------------
+// lv_label_set_text always invalidates, even for the same text
+static void label_set_text_if_changed(lv_obj_t *label, const char *text) {
+    if (strcmp(lv_label_get_text(label), text) == 0) return;
+    lv_label_set_text(label, text);
+}
+
+void ui_mqtt_set_label_float(lv_obj_t *label, const ui_mqtt_value_t *value, void *fmt) {
     if (label == NULL) return;
-    lv_label_set_text(label, value);
+    char buf[16];
+    snprintf(buf, sizeof(buf), fmt ? (const char *)fmt : "%.2f", value->num);
+    label_set_text_if_changed(label, buf);
 }
 
-static void ui_update_bar(lv_obj_t *bar, int value) {
+void ui_mqtt_set_label_int(lv_obj_t *label, const ui_mqtt_value_t *value, void *user_data) {
+    if (label == NULL) return;
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%d", (int)value->num);
+    label_set_text_if_changed(label, buf);
+}
+
+void ui_mqtt_set_bar(lv_obj_t *bar, const ui_mqtt_value_t *value, void *user_data) {
     if (bar == NULL) return;
-    lv_bar_set_value(bar, value, LV_ANIM_OFF);
+    lv_bar_set_value(bar, clamp_0_100(value->num), LV_ANIM_OFF);
 }
 
-static int clamp_0_100(float v) {
-    if (v < 0) return 0;
-    if (v > 100) return 100;
-    return (int)v;
+void ui_mqtt_set_checked(lv_obj_t *obj, const ui_mqtt_value_t *value, void *user_data) {
+    if (obj == NULL) return;
+    value->on ? lv_obj_add_state(obj, LV_STATE_CHECKED) : lv_obj_clear_state(obj, LV_STATE_CHECKED);
 }
 
-static void trigger_temp_alert() {
-    uint8_t on = CMD_V13_BUZZER_ON;
-    uint8_t off = CMD_V13_BUZZER_OFF;
-    i2c_master_write_to_device(I2C_NUM_0, DEVICE_ADDR_STC8, &on, 1, pdMS_TO_TICKS(100));
-    vTaskDelay(pdMS_TO_TICKS(100));
-    i2c_master_write_to_device(I2C_NUM_0, DEVICE_ADDR_STC8, &off, 1, pdMS_TO_TICKS(100));
-    vTaskDelay(pdMS_TO_TICKS(150)); 
-    i2c_master_write_to_device(I2C_NUM_0, DEVICE_ADDR_STC8, &on, 1, pdMS_TO_TICKS(100));
-    vTaskDelay(pdMS_TO_TICKS(100));
-    i2c_master_write_to_device(I2C_NUM_0, DEVICE_ADDR_STC8, &off, 1, pdMS_TO_TICKS(100));
-}
-
-void ui_handle_mqtt_message_async(void *arg)
-{
-    typedef struct { char *topic; char *payload; } mqtt_async_data_t;
-    mqtt_async_data_t *d = (mqtt_async_data_t *)arg;
-    const char *topic = d->topic;
-    const char *msg   = d->payload;
-
-    if (strcmp(topic, "home/roomhub/sensor/temperature") == 0) {
-        float t = to_float(msg);
-        int64_t now = esp_timer_get_time() / 1000;
-        if (t >= TEMP_THRESHOLD_HIGH) alarm_active = true;
-        else if (t < TEMP_THRESHOLD_LOW) alarm_active = false;
-
-        if (alarm_active && !is_muted) {
-            if (now - last_alarm_time >= ALARM_INTERVAL_MS) {
-                trigger_temp_alert();
-                last_alarm_time = now;
+// Inverted switch: ON -> unchecked, OFF -> checked
+void ui_mqtt_set_unchecked(lv_obj_t *obj, const ui_mqtt_value_t *value, void *user_data) {
+    if (obj == NULL) return;
+    value->on ? lv_obj_clear_state(obj, LV_STATE_CHECKED) : lv_obj_add_state(obj, LV_STATE_CHECKED);
+}
+
+static void temp_alarm_handler(lv_obj_t *unused, const ui_mqtt_value_t *value, void *user_data) {
+    float t = value->num;
+    int64_t now = esp_timer_get_time() / 1000;
+    if (t >= TEMP_THRESHOLD_HIGH) alarm_active = true;
+    else if (t < TEMP_THRESHOLD_LOW) alarm_active = false;
+
+    if (alarm_active && !is_muted) {
+        if (now - last_alarm_time >= ALARM_INTERVAL_MS) {
+            trigger_temp_alert();
+            last_alarm_time = now;
+        }
+    }
+}
+
+static void record_history(lv_obj_t *unused, const ui_mqtt_value_t *value, void *id) {
+    sensor_history_add((sensor_history_id_t)(intptr_t) id, value->num);
+}
+
+// ------------------------------------------------------------
+// TOPIC DISPATCH TABLE
+// Topics are interned into an open-addressing hash table the first
+// time they are seen. Each entry holds the chain of bindings whose
+// filter matches it (exact or wildcard), so dispatch is one hash,
+// one strcmp and a walk over the bindings that actually fire.
+//
+// Widget updates are coalesced: a message only stores its payload in
+// the topic entry, and a timer applies the latest payload of every
+// dirty topic once per window. Bindings without a widget (history,
+// alarm) see every message as it arrives, so what they record does
+// not depend on the frame timing. Each binding then skips values
+// that moved less than its deadband from the last value it applied.
+// ------------------------------------------------------------
+#define TOPIC_MAX       CONFIG_SMARTHOME_MQTT_TOPIC_MAX_LEN
+#define PAYLOAD_MAX     CONFIG_SMARTHOME_MQTT_PAYLOAD_MAX_LEN
+#define COALESCE_MS     CONFIG_SMARTHOME_UI_MQTT_COALESCE_MS
+#define MAX_BINDINGS    CONFIG_SMARTHOME_UI_MQTT_MAX_BINDINGS
+#define TOPIC_SLOTS     CONFIG_SMARTHOME_UI_MQTT_TOPIC_SLOTS
+#define MAX_ROUTES      (MAX_BINDINGS * 2)
+#define ROUTE_NONE      0xFFFF
+
+_Static_assert((TOPIC_SLOTS & (TOPIC_SLOTS - 1)) == 0,
+               "CONFIG_SMARTHOME_UI_MQTT_TOPIC_SLOTS must be a power of two");
+
+typedef struct {
+    char filter[TOPIC_MAX];
+    bool wildcard;
+    ui_mqtt_parser_t parser;
+    ui_mqtt_handler_t handler;
+    lv_obj_t **widget;
+    void *user_data;
+    float deadband;
+    bool has_last;          // last_num/last_on hold the last applied value
+    bool missed;            // a value arrived while the widget did not exist
+    bool last_on;
+    float last_num;
+} ui_mqtt_binding_t;
+
+typedef struct {
+    uint16_t binding;
+    uint16_t next;
+} ui_mqtt_route_t;
+
+typedef struct {
+    bool used;
+    uint32_t hash;
+    uint16_t first_route;
+    bool dirty;             // `pending` holds a payload not applied yet
+    bool has_payload;       // `pending` holds the latest payload received
+    char topic[TOPIC_MAX];
+    char pending[PAYLOAD_MAX];
+} ui_mqtt_topic_t;
+
+static ui_mqtt_binding_t bindings[MAX_BINDINGS];
+static uint16_t binding_cnt = 0;
+static ui_mqtt_route_t routes[MAX_ROUTES];
+static uint16_t route_cnt = 0;
+static ui_mqtt_topic_t topics[TOPIC_SLOTS];
+static uint16_t topic_cnt = 0;
+static uint16_t dirty_list[TOPIC_SLOTS];
+static uint16_t dirty_cnt = 0;
+static lv_timer_t *coalesce_timer = NULL;
+static ui_mqtt_bridge_stats_t stats;
+static void (*first_data_cb)(void) = NULL;
+
+// FNV-1a
+static uint32_t topic_hash(const char *s) {
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= (uint8_t)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// MQTT filter matching: '+' matches one level, '#' matches the remaining levels
+static bool topic_matches(const char *filter, const char *topic) {
+    // Wildcards never match topics starting with '$' at the first level
+    if (topic[0] == '$' && (filter[0] == '+' || filter[0] == '#')) return false;
+
+    while (*filter) {
+        if (*filter == '#') return true;
+        if (*filter == '+') {
+            while (*topic && *topic != '/') topic++;
+            filter++;
+        } else {
+            if (*filter != *topic) {
+                // "a/#" also matches "a"
+                return (*topic == '\0' && filter[0] == '/' && filter[1] == '#' && filter[2] == '\0');
             }
+            filter++;
+            topic++;
         }
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%.2f", t);
-        ui_update_label(uic_temperature, buf);
-        ui_update_bar(uic_tempBar, clamp_0_100(t));
-        if (uic_tempChart) {
-            lv_chart_series_t *s = lv_chart_get_series_next(uic_tempChart, NULL);
-            if (s) lv_chart_set_next_value(uic_tempChart, s, t);
+    }
+    return *topic == '\0';
+}
+
+static bool filter_is_valid(const char *filter, bool *wildcard) {
+    size_t len = strlen(filter);
+    if (len == 0 || len >= TOPIC_MAX) return false;
+
+    *wildcard = false;
+    for (size_t i = 0; i < len; i++) {
+        if (filter[i] == '+' || filter[i] == '#') {
+            // Wildcards must occupy a whole level; '#' must be last
+            bool level_start = (i == 0 || filter[i - 1] == '/');
+            bool level_end = (i + 1 == len || filter[i + 1] == '/');
+            if (!level_start || !level_end) return false;
+            if (filter[i] == '#' && i + 1 != len) return false;
+            *wildcard = true;
         }
     }
-    else if (strcmp(topic, "home/roomhub/sensor/humidity") == 0) {
-        float h = to_float(msg);
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%.2f", h);
-        ui_update_label(uic_humidity, buf);
-        ui_update_bar(uic_humiBar, clamp_0_100(h));
-        if (uic_humiChart) {
-            lv_chart_series_t *s = lv_chart_get_series_next(uic_humiChart, NULL);
-            if (s) lv_chart_set_next_value(uic_humiChart, s, h);
+    return true;
+}
+
+static ui_mqtt_topic_t *topic_lookup(const char *topic, uint32_t hash) {
+    for (uint32_t i = 0; i < TOPIC_SLOTS; i++) {
+        ui_mqtt_topic_t *e = &topics[(hash + i) & (TOPIC_SLOTS - 1)];
+        if (!e->used) return NULL;
+        if (e->hash == hash && strcmp(e->topic, topic) == 0) return e;
+    }
+    return NULL;
+}
+
+static bool route_append(ui_mqtt_topic_t *e, uint16_t binding) {
+    if (route_cnt >= MAX_ROUTES) return false;
+
+    uint16_t r = route_cnt++;
+    routes[r].binding = binding;
+    routes[r].next = ROUTE_NONE;
+
+    // Keep registration order so handlers run in the order they were bound
+    uint16_t *link = &e->first_route;
+    while (*link != ROUTE_NONE) link = &routes[*link].next;
+    *link = r;
+    return true;
+}
+
+static bool binding_matches(const ui_mqtt_binding_t *b, const char *topic) {
+    return b->wildcard ? topic_matches(b->filter, topic) : (strcmp(b->filter, topic) == 0);
+}
+
+// Add `topic` to the table together with every binding that matches it
+static ui_mqtt_topic_t *topic_intern(const char *topic, uint32_t hash) {
+    // Keep the load factor below 3/4 so probe sequences stay short
+    if ((topic_cnt + 1) * 4 > TOPIC_SLOTS * 3 || strlen(topic) >= TOPIC_MAX) return NULL;
+
+    uint16_t matches = 0;
+    for (uint16_t i = 0; i < binding_cnt; i++) {
+        if (binding_matches(&bindings[i], topic)) matches++;
+    }
+    if (route_cnt + matches > MAX_ROUTES) return NULL;
+
+    ui_mqtt_topic_t *e = &topics[hash & (TOPIC_SLOTS - 1)];
+    while (e->used) {
+        e = (e == &topics[TOPIC_SLOTS - 1]) ? &topics[0] : e + 1;
+    }
+    e->used = true;
+    e->hash = hash;
+    e->first_route = ROUTE_NONE;
+    e->dirty = false;
+    e->has_payload = false;
+    strcpy(e->topic, topic);
+    topic_cnt++;
+
+    for (uint16_t i = 0; i < binding_cnt; i++) {
+        if (binding_matches(&bindings[i], topic)) route_append(e, i);
+    }
+    return e;
+}
+
+// Parse result shared by the bindings of one message
+typedef struct {
+    ui_mqtt_value_t value;
+    ui_mqtt_parser_t parser;    // parser that produced `value`
+    bool parsed;
+    bool valid;
+} ui_mqtt_parse_cache_t;
+
+// Run one binding, reusing the previous parse when the parser is the same
+static void binding_run(ui_mqtt_binding_t *b, const char *topic, const char *payload,
+                        ui_mqtt_parse_cache_t *pc) {
+    if (!pc->parsed || pc->parser != b->parser) {
+        memset(&pc->value, 0, sizeof(pc->value));
+        pc->value.topic = topic;
+        pc->value.raw = payload;
+        pc->valid = b->parser ? b->parser(payload, &pc->value) : true;
+        pc->parser = b->parser;
+        pc->parsed = true;
+    }
+    if (!pc->valid) return;
+
+    // The bound widget does not exist (yet): it gets the latest value when its screen is built
+    lv_obj_t *widget = b->widget ? *b->widget : NULL;
+    if (b->widget && widget == NULL) {
+        b->missed = true;
+        return;
+    }
+
+    if (b->has_last && b->deadband >= 0.0f &&
+        b->last_on == pc->value.on && fabsf(pc->value.num - b->last_num) <= b->deadband) {
+        stats.suppressed++;
+        return;
+    }
+    b->has_last = true;
+    b->last_on = pc->value.on;
+    b->last_num = pc->value.num;
+    b->handler(widget, &pc->value, b->user_data);
+}
+
+esp_err_t ui_mqtt_bridge_register(const char *filter, ui_mqtt_parser_t parser,
+                                  ui_mqtt_handler_t handler, lv_obj_t **widget, void *user_data,
+                                  float deadband)
+{
+    bool wildcard;
+    if (filter == NULL || handler == NULL || !filter_is_valid(filter, &wildcard)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (binding_cnt >= MAX_BINDINGS) return ESP_ERR_NO_MEM;
+
+    // Make sure every already interned topic the new filter matches can get a route
+    uint16_t matches = 0;
+    for (uint32_t i = 0; i < TOPIC_SLOTS; i++) {
+        if (topics[i].used && (wildcard ? topic_matches(filter, topics[i].topic)
+                                        : strcmp(filter, topics[i].topic) == 0)) {
+            matches++;
         }
     }
-    else if (strcmp(topic, "home/roomhub/sensor/light") == 0) {
-        float percent_float = to_float(msg); 
-        int p = clamp_0_100(percent_float);
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%d", p);
-        ui_update_label(uic_light, buf);
-        ui_update_bar(uic_lightBar, p);
-        if (uic_lightChart) {
-            lv_chart_series_t *s = lv_chart_get_series_next(uic_lightChart, NULL);
-            if (s) lv_chart_set_next_value(uic_lightChart, s, p);
+    if (route_cnt + matches + (wildcard ? 0 : 1) > MAX_ROUTES) return ESP_ERR_NO_MEM;
+
+    uint16_t idx = binding_cnt;
+    ui_mqtt_binding_t *b = &bindings[idx];
+    strcpy(b->filter, filter);
+    b->wildcard = wildcard;
+    b->parser = parser;
+    b->handler = handler;
+    b->widget = widget;
+    b->user_data = user_data;
+    b->deadband = deadband;
+    b->has_last = false;
+    b->missed = false;
+    binding_cnt++;
+
+    if (wildcard) {
+        for (uint32_t i = 0; i < TOPIC_SLOTS; i++) {
+            if (topics[i].used && topic_matches(filter, topics[i].topic)) route_append(&topics[i], idx);
         }
+    } else {
+        uint32_t hash = topic_hash(filter);
+        ui_mqtt_topic_t *e = topic_lookup(filter, hash);
+        if (e) {
+            route_append(e, idx);
+        } else {
+            // Interning picks up the new binding itself
+            topic_intern(filter, hash);
+        }
+    }
+
+    mqtt_manager_subscribe(filter);
+    return ESP_OK;
+}
+
+// Run the bindings of a topic that have a widget, or those that have none
+static void topic_apply(ui_mqtt_topic_t *e, const char *payload, bool widgets)
+{
+    ui_mqtt_parse_cache_t pc = { .parsed = false };
+
+    for (uint16_t r = e->first_route; r != ROUTE_NONE; r = routes[r].next) {
+        ui_mqtt_binding_t *b = &bindings[routes[r].binding];
+        if ((b->widget != NULL) == widgets) binding_run(b, e->topic, payload, &pc);
     }
+}
+
+// A received message has reached the widgets
+static void first_data_done(void)
+{
+    void (*cb)(void) = first_data_cb;
+    first_data_cb = NULL;
+    if (cb) cb();
+}
+
+// Timer callback: apply the latest payload of every topic updated during the window
+static void coalesce_timer_cb(lv_timer_t *timer)
+{
+    for (uint16_t i = 0; i < dirty_cnt; i++) {
+        ui_mqtt_topic_t *e = &topics[dirty_list[i]];
+        e->dirty = false;
+        topic_apply(e, e->pending, true);
+    }
+    dirty_cnt = 0;
+    lv_timer_pause(timer);
+    first_data_done();
+}
 
-    // --- MODIFIED AUTO STATE LOGIC (Unchecked = Enabled, Checked = Disabled) ---
-    if (strcmp(topic, "home/roomhub/auto/all/state") == 0) {
-        if (uic_autoDisBtn) {
-            // RoomHub says ON (Enabled) -> UI Unchecked
-            if (strcmp(msg, "ON") == 0) {
-                lv_obj_clear_state(uic_autoDisBtn, LV_STATE_CHECKED);
-            } 
-            // RoomHub says OFF (Disabled) -> UI Checked
-            else {
-                lv_obj_add_state(uic_autoDisBtn, LV_STATE_CHECKED);
+void ui_handle_mqtt_message(const char *topic, const char *msg)
+{
+    stats.received++;
+
+    uint32_t hash = topic_hash(topic);
+    ui_mqtt_topic_t *e = topic_lookup(topic, hash);
+    if (e == NULL) e = topic_intern(topic, hash);
+
+    if (e == NULL) {
+        // Table full: fall back to matching every binding, without coalescing
+        ESP_LOGD(TAG, "topic table full, slow dispatch for %s", topic);
+        ui_mqtt_parse_cache_t pc = { .parsed = false };
+        for (uint16_t i = 0; i < binding_cnt; i++) {
+            if (binding_matches(&bindings[i], topic)) {
+                binding_run(&bindings[i], topic, msg, &pc);
             }
         }
+        first_data_done();
+        return;
     }
+    if (e->first_route == ROUTE_NONE) return;
+
+    topic_apply(e, msg, false);
+
+    // Latest value wins: overwrite the payload waiting for this topic.
+    // It is kept after being applied, for widgets built later.
+    strncpy(e->pending, msg, PAYLOAD_MAX - 1);
+    e->pending[PAYLOAD_MAX - 1] = '\0';
+    e->has_payload = true;
 
-    else if (strcmp(topic, "home/roomhub/relay/ac/state") == 0) {
-        if (uic_ac) (strcmp(msg, "ON") == 0) ? lv_obj_add_state(uic_ac, LV_STATE_CHECKED) : lv_obj_clear_state(uic_ac, LV_STATE_CHECKED);
+    if (coalesce_timer == NULL) {
+        topic_apply(e, e->pending, true);
+        first_data_done();
+        return;
+    }
+
+    if (e->dirty) {
+        stats.coalesced++;
+    } else {
+        e->dirty = true;
+        dirty_list[dirty_cnt++] = (uint16_t)(e - topics);
+        if (dirty_cnt == 1) {
+            // Start the window at the first update
+            lv_timer_reset(coalesce_timer);
+            lv_timer_resume(coalesce_timer);
+        }
     }
-    else if (strcmp(topic, "home/roomhub/relay/fan/state") == 0) {
-        if (uic_fan) (strcmp(msg, "ON") == 0) ? lv_obj_add_state(uic_fan, LV_STATE_CHECKED) : lv_obj_clear_state(uic_fan, LV_STATE_CHECKED);
+}
+
+// Apply the latest payload to the bindings of `scr` that missed it while the screen was deleted
+static void replay_missed(lv_obj_t *scr)
+{
+    for (uint32_t i = 0; i < TOPIC_SLOTS; i++) {
+        ui_mqtt_topic_t *e = &topics[i];
+        // A dirty topic reaches the new widgets with the next coalescing run
+        if (!e->used || !e->has_payload || e->dirty) continue;
+
+        ui_mqtt_parse_cache_t pc = { .parsed = false };
+        for (uint16_t r = e->first_route; r != ROUTE_NONE; r = routes[r].next) {
+            ui_mqtt_binding_t *b = &bindings[routes[r].binding];
+            if (!b->missed || b->widget == NULL || *b->widget == NULL) continue;
+            if (lv_obj_get_screen(*b->widget) != scr) continue;
+            b->missed = false;
+            b->has_last = false;
+            binding_run(b, e->topic, e->pending, &pc);
+        }
     }
-    else if (strcmp(topic, "home/roomhub/relay/tv/state") == 0) {
-        if (uic_tv) (strcmp(msg, "ON") == 0) ? lv_obj_add_state(uic_tv, LV_STATE_CHECKED) : lv_obj_clear_state(uic_tv, LV_STATE_CHECKED);
+}
+
+void ui_mqtt_bridge_on_first_data(void (*cb)(void))
+{
+    first_data_cb = cb;
+}
+
+void ui_mqtt_bridge_get_stats(ui_mqtt_bridge_stats_t *out)
+{
+    if (out) *out = stats;
+}
+
+// ------------------------------------------------------------
+// SAVED STATE
+// ------------------------------------------------------------
+static bool topic_has_widget(const ui_mqtt_topic_t *e)
+{
+    for (uint16_t r = e->first_route; r != ROUTE_NONE; r = routes[r].next) {
+        if (bindings[routes[r].binding].widget) return true;
     }
-    else if (strcmp(topic, "home/roomhub/relay/bulb/state") == 0) {
-        if (uic_bulb) (strcmp(msg, "ON") == 0) ? lv_obj_add_state(uic_bulb, LV_STATE_CHECKED) : lv_obj_clear_state(uic_bulb, LV_STATE_CHECKED);
+    return false;
+}
+
+void ui_mqtt_bridge_restore(const char *topic, const char *payload)
+{
+    uint32_t hash = topic_hash(topic);
+    ui_mqtt_topic_t *e = topic_lookup(topic, hash);
+    if (e == NULL) e = topic_intern(topic, hash);
+    if (e == NULL || e->has_payload) return;
+
+    strncpy(e->pending, payload, PAYLOAD_MAX - 1);
+    e->pending[PAYLOAD_MAX - 1] = '\0';
+    e->has_payload = true;
+
+    ui_mqtt_parse_cache_t pc = { .parsed = false };
+    for (uint16_t r = e->first_route; r != ROUTE_NONE; r = routes[r].next) {
+        ui_mqtt_binding_t *b = &bindings[routes[r].binding];
+        if (b->widget) binding_run(b, e->topic, e->pending, &pc);
     }
+}
 
-    free(d->topic); free(d->payload); free(d);
+void ui_mqtt_bridge_foreach_payload(ui_mqtt_payload_cb_t cb, void *ctx)
+{
+    for (uint32_t i = 0; i < TOPIC_SLOTS; i++) {
+        const ui_mqtt_topic_t *e = &topics[i];
+        if (e->used && e->has_payload && topic_has_widget(e)) cb(e->topic, e->pending, ctx);
+    }
 }
 
+// ------------------------------------------------------------
+// DEFAULT BINDINGS
+// ------------------------------------------------------------
+typedef struct {
+    const char *filter;
+    ui_mqtt_parser_t parser;
+    ui_mqtt_handler_t handler;
+    lv_obj_t **widget;
+    void *user_data;
+    float deadband;
+} ui_mqtt_binding_def_t;
+
+static const ui_mqtt_binding_def_t default_bindings[] = {
+    // Sensors
+    { "home/roomhub/sensor/temperature", ui_mqtt_parse_float,   temp_alarm_handler,      NULL,             NULL,   DEADBAND_ALWAYS },
+    { "home/roomhub/sensor/temperature", ui_mqtt_parse_float,   ui_mqtt_set_label_float, &uic_temperature, "%.2f", SENSOR_DEADBAND },
+    { "home/roomhub/sensor/temperature", ui_mqtt_parse_float,   ui_mqtt_set_bar,         &uic_tempBar,     NULL,   DEADBAND_EXACT },
+    { "home/roomhub/sensor/humidity",    ui_mqtt_parse_float,   ui_mqtt_set_label_float, &uic_humidity,    "%.2f", SENSOR_DEADBAND },
+    { "home/roomhub/sensor/humidity",    ui_mqtt_parse_float,   ui_mqtt_set_bar,         &uic_humiBar,     NULL,   DEADBAND_EXACT },
+    { "home/roomhub/sensor/light",       ui_mqtt_parse_percent, ui_mqtt_set_label_int,   &uic_light,       NULL,   DEADBAND_EXACT },
+    { "home/roomhub/sensor/light",       ui_mqtt_parse_percent, ui_mqtt_set_bar,         &uic_lightBar,    NULL,   DEADBAND_EXACT },
+
+    // Every sample goes to the history the charts are drawn from
+    { "home/roomhub/sensor/temperature", ui_mqtt_parse_float,   record_history, NULL, (void *) SENSOR_HISTORY_TEMPERATURE, DEADBAND_ALWAYS },
+    { "home/roomhub/sensor/humidity",    ui_mqtt_parse_float,   record_history, NULL, (void *) SENSOR_HISTORY_HUMIDITY,    DEADBAND_ALWAYS },
+    { "home/roomhub/sensor/light",       ui_mqtt_parse_percent, record_history, NULL, (void *) SENSOR_HISTORY_LIGHT,       DEADBAND_ALWAYS },
+
+    // Relay states: always applied, the switch may have been toggled locally since the last report
+    { "home/roomhub/relay/ac/state",     ui_mqtt_parse_on_off,  ui_mqtt_set_checked,     &uic_ac,          NULL,   DEADBAND_ALWAYS },
+    { "home/roomhub/relay/fan/state",    ui_mqtt_parse_on_off,  ui_mqtt_set_checked,     &uic_fan,         NULL,   DEADBAND_ALWAYS },
+    { "home/roomhub/relay/tv/state",     ui_mqtt_parse_on_off,  ui_mqtt_set_checked,     &uic_tv,          NULL,   DEADBAND_ALWAYS },
+    { "home/roomhub/relay/bulb/state",   ui_mqtt_parse_on_off,  ui_mqtt_set_checked,     &uic_bulb,        NULL,   DEADBAND_ALWAYS },
+
+    // Automation state (Unchecked = Enabled, Checked = Disabled)
+    { "home/roomhub/auto/all/state",     ui_mqtt_parse_on_off,  ui_mqtt_set_unchecked,   &uic_autoDisBtn,  NULL,   DEADBAND_ALWAYS },
+};
+
 static void ac_event_cb(lv_event_t * e) {
     bool on = lv_obj_has_state(uic_ac, LV_STATE_CHECKED);
     mqtt_manager_publish("home/roomhub/relay/ac/cmd", on ? "ON" : "OFF");
@@ -173,8 +621,9 @@ void mute_btn_event_cb(lv_event_t * e) {
     if(lv_event_get_code(e) == LV_EVENT_VALUE_CHANGED) {
         is_muted = lv_obj_has_state(obj, LV_STATE_CHECKED);
         if (is_muted) {
-            uint8_t off = CMD_V13_BUZZER_OFF;
-            i2c_master_write_to_device(I2C_NUM_0, DEVICE_ADDR_STC8, &off, 1, pdMS_TO_TICKS(100));
+            // Also cuts an alert that is still beeping
+            const i2c_bus_step_t off = { DEVICE_ADDR_STC8, CMD_V13_BUZZER_OFF, 0 };
+            i2c_bus_submit_seq(SEQ_BUZZER, &off, 1);
         }
     }
 }
@@ -188,27 +637,27 @@ static void auto_all_event_cb(lv_event_t * e)
     mqtt_manager_publish("home/roomhub/auto/all/cmd", is_checked ? "OFF" : "ON");
 }
 
+// Ramp from dim to full brightness in steps of 5, 10 ms apart, played by the I2C bus task
 static void fade_in_backlight() {
+    i2c_bus_step_t steps[(BRIGHTNESS_DIM - BRIGHTNESS_FULL) / 5 + 1];
+    size_t n = 0;
     for (int b = BRIGHTNESS_DIM; b >= BRIGHTNESS_FULL; b -= 5) {
-        uint8_t val = (uint8_t)b;
-        i2c_master_write_to_device(I2C_NUM_0, DEVICE_ADDR_STC8, &val, 1, pdMS_TO_TICKS(50));
-        vTaskDelay(pdMS_TO_TICKS(10)); 
+        steps[n++] = (i2c_bus_step_t){ DEVICE_ADDR_STC8, (uint8_t)b, 10 };
     }
+    i2c_bus_submit_seq(SEQ_BACKLIGHT, steps, n);
 }
 
 static void update_backlight_dimming() {
     uint32_t idle_time = lv_disp_get_inactive_time(NULL); 
     if (idle_time > OFF_TIMEOUT_MS) {
         if (current_backlight_state != STATE_OFF) {
-            uint8_t val = BRIGHTNESS_OFF;
-            i2c_master_write_to_device(I2C_NUM_0, DEVICE_ADDR_STC8, &val, 1, pdMS_TO_TICKS(100));
+            set_backlight(BRIGHTNESS_OFF);
             current_backlight_state = STATE_OFF;
             lv_obj_clear_flag(uic_WakePanel, LV_OBJ_FLAG_HIDDEN); 
         }
     } else if (idle_time > DIM_TIMEOUT_MS) {
         if (current_backlight_state != STATE_DIMMED) {
-            uint8_t val = BRIGHTNESS_DIM;
-            i2c_master_write_to_device(I2C_NUM_0, DEVICE_ADDR_STC8, &val, 1, pdMS_TO_TICKS(100));
+            set_backlight(BRIGHTNESS_DIM);
             current_backlight_state = STATE_DIMMED;
             lv_obj_clear_flag(uic_WakePanel, LV_OBJ_FLAG_HIDDEN);
         }
@@ -223,14 +672,46 @@ static void update_backlight_dimming() {
 
 static void dimming_timer_cb(lv_timer_t * timer) { update_backlight_dimming(); }
 
+// Widgets that publish a command when the user changes them
+static const struct {
+    lv_obj_t **widget;
+    lv_event_cb_t cb;
+} command_widgets[] = {
+    { &uic_ac,          ac_event_cb },
+    { &uic_fan,         fan_event_cb },
+    { &uic_tv,          tv_event_cb },
+    { &uic_bulb,        bulb_event_cb },
+    { &uic_MuteBtn,     mute_btn_event_cb },
+    { &uic_autoDisBtn,  auto_all_event_cb },
+};
+
+// Screens are built on demand: hook up every new instance of the widgets
+static void screen_built_cb(lv_obj_t *scr)
+{
+    for (size_t i = 0; i < sizeof(command_widgets) / sizeof(command_widgets[0]); i++) {
+        lv_obj_t *obj = *command_widgets[i].widget;
+        if (obj && lv_obj_get_screen(obj) == scr) {
+            lv_obj_add_event_cb(obj, command_widgets[i].cb, LV_EVENT_VALUE_CHANGED, NULL);
+        }
+    }
+    replay_missed(scr);
+}
+
 void ui_mqtt_bridge_init(void)
 {
     lv_obj_set_parent(uic_WakePanel, lv_layer_sys());
-    if (uic_ac) lv_obj_add_event_cb(uic_ac, ac_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
-    if (uic_fan) lv_obj_add_event_cb(uic_fan, fan_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
-    if (uic_tv) lv_obj_add_event_cb(uic_tv, tv_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
-    if (uic_bulb) lv_obj_add_event_cb(uic_bulb, bulb_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
-    if (uic_MuteBtn) lv_obj_add_event_cb(uic_MuteBtn, mute_btn_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
-    if (uic_autoDisBtn) lv_obj_add_event_cb(uic_autoDisBtn, auto_all_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    ui_screens_add_build_cb(screen_built_cb);
+
+    for (size_t i = 0; i < sizeof(default_bindings) / sizeof(default_bindings[0]); i++) {
+        const ui_mqtt_binding_def_t *d = &default_bindings[i];
+        if (ui_mqtt_bridge_register(d->filter, d->parser, d->handler, d->widget, d->user_data,
+                                    d->deadband) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to bind %s", d->filter);
+        }
+    }
+#if COALESCE_MS > 0
+    coalesce_timer = lv_timer_create(coalesce_timer_cb, COALESCE_MS, NULL);
+    lv_timer_pause(coalesce_timer);
+#endif
     lv_timer_create(dimming_timer_cb, 500, NULL);
 }
\ No newline at end of file
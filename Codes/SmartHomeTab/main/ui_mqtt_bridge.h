@@ -1,4 +1,94 @@
 #pragma once
+#include <stdbool.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+// Decoded form of one inbound message, filled by a parser
+typedef struct {
+    const char *topic;      // topic the message arrived on
+    const char *raw;        // payload as received
+    float num;              // numeric value (float/percent parsers)
+    bool on;                // switch value (on/off parser)
+} ui_mqtt_value_t;
+
+// Returns false if the payload is not valid for this parser; the handler is then skipped
+typedef bool (*ui_mqtt_parser_t)(const char *payload, ui_mqtt_value_t *out);
+
+// Runs in the LVGL thread. `widget` is NULL for bindings registered without one; bindings whose
+// widget does not exist yet are not called, they get the latest value when it is built.
+typedef void (*ui_mqtt_handler_t)(lv_obj_t *widget, const ui_mqtt_value_t *value, void *user_data);
+
+// Counters of the update filtering
+typedef struct {
+    uint32_t received;      // messages handed to the bridge
+    uint32_t coalesced;     // payloads overwritten by a newer one within the window
+    uint32_t suppressed;    // binding updates skipped by the deadband
+} ui_mqtt_bridge_stats_t;
+
+// Built-in parsers
+bool ui_mqtt_parse_float(const char *payload, ui_mqtt_value_t *out);
+bool ui_mqtt_parse_percent(const char *payload, ui_mqtt_value_t *out);
+bool ui_mqtt_parse_on_off(const char *payload, ui_mqtt_value_t *out);
+
+// Built-in handlers
+void ui_mqtt_set_label_float(lv_obj_t *label, const ui_mqtt_value_t *value, void *fmt);
+void ui_mqtt_set_label_int(lv_obj_t *label, const ui_mqtt_value_t *value, void *user_data);
+void ui_mqtt_set_bar(lv_obj_t *bar, const ui_mqtt_value_t *value, void *user_data);
+void ui_mqtt_set_checked(lv_obj_t *obj, const ui_mqtt_value_t *value, void *user_data);
+void ui_mqtt_set_unchecked(lv_obj_t *obj, const ui_mqtt_value_t *value, void *user_data);
+
+/**
+ * @brief Bind a topic filter to a widget.
+ *
+ * The filter may contain MQTT wildcards (`+` for one level, `#` for the rest),
+ * and several bindings may share a filter, so one message can update many widgets.
+ * The filter is subscribed on the broker automatically. Must be called from the LVGL thread.
+ *
+ * Messages are coalesced per topic for CONFIG_SMARTHOME_UI_MQTT_COALESCE_MS; only the
+ * latest payload of the window reaches the handler of a widget. Bindings without a widget
+ * get every message as it arrives, e.g. to record it. The handler is further skipped while
+ * the parsed value stays within `deadband` of the last value it was called with.
+ *
+ * @param[in] filter: Topic filter, copied internally
+ * @param[in] parser: Payload parser
+ * @param[in] handler: Called with the parsed value
+ * @param[in] widget: Address of the widget pointer (e.g. &uic_temperature), may be NULL
+ * @param[in] user_data: Passed to the handler
+ * @param[in] deadband: Changes up to this size are skipped: 0 skips repeats of the same value,
+ *                      negative applies every value
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Filter is malformed or too long
+ *      - ESP_ERR_NO_MEM: Binding or topic table is full
+ */
+esp_err_t ui_mqtt_bridge_register(const char *filter, ui_mqtt_parser_t parser,
+                                  ui_mqtt_handler_t handler, lv_obj_t **widget, void *user_data,
+                                  float deadband);
+
+// Called with the latest payload of a topic
+typedef void (*ui_mqtt_payload_cb_t)(const char *topic, const char *payload, void *ctx);
 
 void ui_mqtt_bridge_init(void);
-void ui_handle_mqtt_message_async(void *arg);
+void ui_handle_mqtt_message(const char *topic, const char *payload);
+void ui_mqtt_bridge_get_stats(ui_mqtt_bridge_stats_t *stats);
+
+/**
+ * @brief Show a payload saved before a restart, as if it had just been received.
+ *
+ * Only the bindings of widgets run, so the saved values are neither recorded in the sensor
+ * history nor raise alarms. Skipped if the topic already got a message. Must be called from
+ * the LVGL thread after ui_mqtt_bridge_init().
+ */
+void ui_mqtt_bridge_restore(const char *topic, const char *payload);
+
+/**
+ * @brief Get called once when the first received message has been applied to the widgets.
+ *
+ * Payloads of ui_mqtt_bridge_restore() don't count. `cb` runs in the LVGL thread. Must be
+ * called from the LVGL thread.
+ */
+void ui_mqtt_bridge_on_first_data(void (*cb)(void));
+
+// Call `cb` with the latest payload of every topic bound to a widget. Must be called from the LVGL thread.
+void ui_mqtt_bridge_foreach_payload(ui_mqtt_payload_cb_t cb, void *ctx);
@@ -0,0 +1,308 @@
+#include "ui_numeric.h"
+#include "esp_log.h"
+#include "src/draw/sw/lv_draw_sw_blend.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "UI_NUMERIC";
+
+// ------------------------------------------------------------
+// GLYPH ATLAS
+// One per font, shared by every numeric display using the font.
+// Glyphs are decoded from the font's packed bpp format to one
+// opacity byte per pixel the first time they are shown, so drawing
+// a digit is a single masked fill. The bitmaps are small, so they
+// stay in internal RAM; they are kept for the lifetime of the app.
+// ------------------------------------------------------------
+#define ATLAS_FONTS     4
+#define ATLAS_GLYPHS    24      // digits, separators and a few letters
+
+typedef struct {
+    uint32_t letter;
+    lv_coord_t box_w;
+    lv_coord_t box_h;
+    lv_coord_t ofs_x;
+    lv_coord_t ofs_y;
+    lv_coord_t adv_w;
+    lv_opa_t *a8;               // box_w * box_h, NULL for empty glyphs
+} atlas_glyph_t;
+
+typedef struct {
+    const lv_font_t *font;
+    lv_coord_t digit_w;         // cell width of every digit: the widest one
+    uint8_t cnt;
+    atlas_glyph_t glyphs[ATLAS_GLYPHS];
+} atlas_t;
+
+static atlas_t atlases[ATLAS_FONTS];
+
+static atlas_t *atlas_get(const lv_font_t *font)
+{
+    for (int i = 0; i < ATLAS_FONTS; i++) {
+        if (atlases[i].font == font) return &atlases[i];
+    }
+    for (int i = 0; i < ATLAS_FONTS; i++) {
+        atlas_t *a = &atlases[i];
+        if (a->font) continue;
+
+        a->font = font;
+        for (uint32_t d = '0'; d <= '9'; d++) {
+            lv_font_glyph_dsc_t g;
+            if (lv_font_get_glyph_dsc(font, &g, d, 0) && g.adv_w > a->digit_w) a->digit_w = g.adv_w;
+        }
+        return a;
+    }
+    return NULL;
+}
+
+// Unpack a glyph bitmap of 1..8 bpp (rows are not padded) to opacity bytes
+static void glyph_to_a8(const uint8_t *bitmap, uint8_t bpp, lv_opa_t *out, uint32_t px_cnt)
+{
+    const uint32_t mask = (1u << bpp) - 1;
+    for (uint32_t i = 0; i < px_cnt; i++) {
+        uint32_t bit = i * bpp;
+        uint32_t byte = bit >> 3;
+        // Two bytes, so that 3 bpp pixels crossing a byte boundary read correctly
+        uint32_t word = (uint32_t)bitmap[byte] << 8;
+        if (((bit & 7) + bpp) > 8) word |= bitmap[byte + 1];
+        uint32_t v = (word >> (16 - bpp - (bit & 7))) & mask;
+        out[i] = (lv_opa_t)(v * 255 / mask);
+    }
+}
+
+static const atlas_glyph_t *atlas_glyph(atlas_t *a, uint32_t letter)
+{
+    for (int i = 0; i < a->cnt; i++) {
+        if (a->glyphs[i].letter == letter) return &a->glyphs[i];
+    }
+    if (a->cnt >= ATLAS_GLYPHS) {
+        ESP_LOGW(TAG, "Atlas full, '%c' not shown", (char) letter);
+        return NULL;
+    }
+
+    lv_font_glyph_dsc_t g;
+    if (!lv_font_get_glyph_dsc(a->font, &g, letter, 0) || g.bpp == 0 || g.bpp > 8) return NULL;
+
+    atlas_glyph_t *ag = &a->glyphs[a->cnt];
+    ag->letter = letter;
+    ag->box_w = g.box_w;
+    ag->box_h = g.box_h;
+    ag->ofs_x = g.ofs_x;
+    ag->ofs_y = g.ofs_y;
+    ag->adv_w = g.adv_w;
+    ag->a8 = NULL;
+
+    uint32_t px_cnt = (uint32_t) g.box_w * g.box_h;
+    if (px_cnt) {
+        const uint8_t *bitmap = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+        if (bitmap == NULL) return NULL;
+        ag->a8 = malloc(px_cnt);
+        if (ag->a8 == NULL) return NULL;
+        glyph_to_a8(bitmap, g.bpp, ag->a8, px_cnt);
+    }
+    a->cnt++;
+    return ag;
+}
+
+// ------------------------------------------------------------
+// WIDGET
+// ------------------------------------------------------------
+typedef struct {
+    lv_obj_t obj;
+    char text[UI_NUMERIC_MAX_CELLS + 1];
+    lv_coord_t cell_x[UI_NUMERIC_MAX_CELLS + 1];    // left edge of each cell; [len] is the width
+    atlas_t *atlas;
+} ui_numeric_t;
+
+static void ui_numeric_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void ui_numeric_event(const lv_obj_class_t *class_p, lv_event_t *e);
+
+static const lv_obj_class_t ui_numeric_class = {
+    .base_class = &lv_obj_class,
+    .constructor_cb = ui_numeric_constructor,
+    .event_cb = ui_numeric_event,
+    .width_def = LV_SIZE_CONTENT,
+    .height_def = LV_SIZE_CONTENT,
+    .instance_size = sizeof(ui_numeric_t),
+};
+#define MY_CLASS &ui_numeric_class
+
+static bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// Cell positions of the current text and font
+static void layout(lv_obj_t *obj)
+{
+    ui_numeric_t *num = (ui_numeric_t *)obj;
+    const lv_font_t *font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_coord_t space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    lv_coord_t x = 0;
+    size_t i;
+
+    num->atlas = atlas_get(font);
+    for (i = 0; num->text[i]; i++) {
+        num->cell_x[i] = x;
+        if (num->atlas == NULL) continue;
+        const atlas_glyph_t *g = is_digit(num->text[i]) ? NULL : atlas_glyph(num->atlas, (uint8_t) num->text[i]);
+        x += (is_digit(num->text[i]) ? num->atlas->digit_w : (g ? g->adv_w : 0)) + space;
+    }
+    num->cell_x[i] = i ? x - space : 0;
+    lv_obj_refresh_self_size(obj);
+    lv_obj_invalidate(obj);
+}
+
+// Area covered by the glyph of cell `i`; false if nothing is drawn
+static bool glyph_area(lv_obj_t *obj, size_t i, const atlas_glyph_t *g, lv_area_t *area)
+{
+    ui_numeric_t *num = (ui_numeric_t *)obj;
+    const lv_font_t *font = num->atlas->font;
+    lv_area_t content;
+
+    if (g == NULL || g->a8 == NULL) return false;
+    lv_obj_get_content_coords(obj, &content);
+
+    lv_coord_t cell_w = num->cell_x[i + 1] - num->cell_x[i];
+    lv_coord_t space = (num->text[i + 1] ? lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN) : 0);
+    area->x1 = content.x1 + num->cell_x[i] + (cell_w - space - g->adv_w) / 2 + g->ofs_x;
+    area->y1 = content.y1 + (font->line_height - font->base_line) - g->box_h - g->ofs_y;
+    area->x2 = area->x1 + g->box_w - 1;
+    area->y2 = area->y1 + g->box_h - 1;
+    return true;
+}
+
+static void draw_cells(lv_event_t *e)
+{
+    lv_obj_t *obj = lv_event_get_target(e);
+    ui_numeric_t *num = (ui_numeric_t *)obj;
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    lv_draw_label_dsc_t dsc;
+
+    if (num->atlas == NULL) return;
+    lv_draw_label_dsc_init(&dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &dsc);
+    if (dsc.opa <= LV_OPA_MIN) return;
+
+    for (size_t i = 0; num->text[i]; i++) {
+        lv_refr_lock_shared();                  // Another band may be adding a glyph to the atlas
+        const atlas_glyph_t *g = atlas_glyph(num->atlas, (uint8_t) num->text[i]);
+        lv_refr_unlock_shared();
+        lv_area_t area;
+        lv_area_t clipped;
+        if (!glyph_area(obj, i, g, &area) || !_lv_area_intersect(&clipped, &area, draw_ctx->clip_area)) continue;
+
+        if (lv_draw_mask_is_any(&area)) {
+            // Rounded or masked parents: let LVGL apply the masks
+            lv_point_t pos = { area.x1 - g->ofs_x, area.y2 + 1 + g->ofs_y - (num->atlas->font->line_height - num->atlas->font->base_line) };
+            lv_draw_letter(draw_ctx, &dsc, &pos, g->letter);
+            continue;
+        }
+
+        lv_draw_sw_blend_dsc_t blend;
+        lv_memset_00(&blend, sizeof(blend));
+        blend.blend_area = &area;
+        blend.mask_area = &area;
+        blend.mask_buf = g->a8;
+        blend.mask_res = LV_DRAW_MASK_RES_CHANGED;
+        blend.color = dsc.color;
+        blend.opa = dsc.opa;
+        blend.blend_mode = dsc.blend_mode;
+        lv_draw_sw_blend(draw_ctx, &blend);
+    }
+}
+
+static void ui_numeric_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj)
+{
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    layout(obj);
+}
+
+static void ui_numeric_event(const lv_obj_class_t *class_p, lv_event_t *e)
+{
+    if (lv_obj_event_base(MY_CLASS, e) != LV_RES_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+    ui_numeric_t *num = (ui_numeric_t *)obj;
+
+    if (code == LV_EVENT_GET_SELF_SIZE) {
+        lv_point_t *p = lv_event_get_param(e);
+        const lv_font_t *font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+        p->x = LV_MAX(p->x, num->cell_x[strlen(num->text)]);
+        p->y = LV_MAX(p->y, lv_font_get_line_height(font));
+    } else if (code == LV_EVENT_STYLE_CHANGED) {
+        layout(obj);
+    } else if (code == LV_EVENT_DRAW_MAIN) {
+        draw_cells(e);
+    }
+}
+
+// ------------------------------------------------------------
+// PUBLIC
+// ------------------------------------------------------------
+lv_obj_t *ui_numeric_create(lv_obj_t *parent)
+{
+    lv_obj_t *obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+void ui_numeric_set_text(lv_obj_t *obj, const char *text)
+{
+    ui_numeric_t *num = (ui_numeric_t *)obj;
+    size_t len = strnlen(text, UI_NUMERIC_MAX_CELLS);
+    size_t old_len = strlen(num->text);
+
+    if (len == old_len && strncmp(num->text, text, len) == 0) return;
+
+    // Same length and separators: the cells stay, only changed digits are redrawn
+    bool same_layout = (len == old_len) && num->atlas;
+    for (size_t i = 0; same_layout && i < len; i++) {
+        if ((is_digit(text[i]) || is_digit(num->text[i])) ? !(is_digit(text[i]) && is_digit(num->text[i]))
+                                                          : text[i] != num->text[i]) {
+            same_layout = false;
+        }
+    }
+
+    if (!same_layout) {
+        memcpy(num->text, text, len);
+        num->text[len] = '\0';
+        layout(obj);
+        return;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        if (text[i] == num->text[i]) continue;
+        lv_area_t area;
+        if (glyph_area(obj, i, atlas_glyph(num->atlas, (uint8_t) num->text[i]), &area)) {
+            lv_obj_invalidate_area(obj, &area);
+        }
+        num->text[i] = text[i];
+        if (glyph_area(obj, i, atlas_glyph(num->atlas, (uint8_t) num->text[i]), &area)) {
+            lv_obj_invalidate_area(obj, &area);
+        }
+    }
+}
+
+const char *ui_numeric_get_text(const lv_obj_t *obj)
+{
+    return ((const ui_numeric_t *)obj)->text;
+}
+
+lv_obj_t *ui_numeric_replace_label(lv_obj_t *label)
+{
+    lv_obj_t *obj = ui_numeric_create(lv_obj_get_parent(label));
+
+    lv_obj_move_to_index(obj, lv_obj_get_index(label));
+    lv_obj_set_align(obj, lv_obj_get_style_align(label, LV_PART_MAIN));
+    lv_obj_set_pos(obj, lv_obj_get_style_x(label, LV_PART_MAIN), lv_obj_get_style_y(label, LV_PART_MAIN));
+    lv_obj_set_style_text_font(obj, lv_obj_get_style_text_font(label, LV_PART_MAIN), LV_PART_MAIN);
+    lv_obj_set_style_text_color(obj, lv_obj_get_style_text_color(label, LV_PART_MAIN), LV_PART_MAIN);
+    lv_obj_set_style_text_opa(obj, lv_obj_get_style_text_opa(label, LV_PART_MAIN), LV_PART_MAIN);
+    lv_obj_set_style_text_letter_space(obj, lv_obj_get_style_text_letter_space(label, LV_PART_MAIN), LV_PART_MAIN);
+    ui_numeric_set_text(obj, lv_label_get_text(label));
+
+    lv_obj_del(label);
+    return obj;
+}
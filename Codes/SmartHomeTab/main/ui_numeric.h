@@ -0,0 +1,38 @@
+#pragma once
+#include "lvgl.h"
+
+#define UI_NUMERIC_MAX_CELLS    16      // characters of the longest text
+
+/**
+ * @brief Create a numeric display.
+ *
+ * A text widget for frequently updated numbers such as a clock. Glyphs are rasterized once
+ * per font into an A8 atlas; each character gets a cell (digits share one width), and a text
+ * change only invalidates the cells whose character changed. No kerning, one line.
+ * The font, color and opacity come from the text style properties of LV_PART_MAIN.
+ *
+ * @param[in] parent: Parent object
+ *
+ * @return The new object
+ */
+lv_obj_t *ui_numeric_create(lv_obj_t *parent);
+
+/**
+ * @brief Set the text. Characters beyond UI_NUMERIC_MAX_CELLS are dropped.
+ *
+ * A text with the same length and the same non-digit characters keeps the layout,
+ * so changing digits costs only the changed cells.
+ */
+void ui_numeric_set_text(lv_obj_t *obj, const char *text);
+
+const char *ui_numeric_get_text(const lv_obj_t *obj);
+
+/**
+ * @brief Replace a label by a numeric display.
+ *
+ * The numeric display takes the parent, position in the parent, alignment, offsets,
+ * text style and text of the label. The label is deleted.
+ *
+ * @return The numeric display
+ */
+lv_obj_t *ui_numeric_replace_label(lv_obj_t *label);
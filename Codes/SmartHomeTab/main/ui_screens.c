@@ -0,0 +1,337 @@
+#include "ui_screens.h"
+#include "ui_transition.h"
+#include "ui.h"
+#include "esp_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "UI_SCREENS";
+
+// ------------------------------------------------------------
+// SCREEN TABLE
+// The SquareLine screens already support being built late and
+// destroyed (ui_ScreenN_screen_init/_destroy, NULL-ed variables);
+// this table decides when. Screen1 holds the clock and the wake
+// panel, which are used from outside the UI, so it stays built.
+// ------------------------------------------------------------
+#define LIVE_SCREENS    CONFIG_SMARTHOME_UI_LIVE_SCREENS
+#define MAX_BUILD_CBS   4
+
+typedef struct {
+    lv_obj_t **scr;
+    void (*init)(void);
+    void (*destroy)(void);
+    bool pinned;            // never deleted
+    uint32_t last_shown;    // value of show_cnt when last loaded
+    uint8_t *state;         // saved dynamic state while the screen is deleted
+    size_t state_len;
+} ui_screen_entry_t;
+
+static ui_screen_entry_t screens[] = {
+    { .scr = &ui_Screen1, .init = ui_Screen1_screen_init, .destroy = ui_Screen1_screen_destroy, .pinned = true },
+    { .scr = &ui_Screen2, .init = ui_Screen2_screen_init, .destroy = ui_Screen2_screen_destroy },
+    { .scr = &ui_Screen3, .init = ui_Screen3_screen_init, .destroy = ui_Screen3_screen_destroy },
+};
+#define SCREEN_CNT      (sizeof(screens) / sizeof(screens[0]))
+
+static uint32_t show_cnt = 0;
+static bool evict_pending = false;
+static ui_screens_build_cb_t build_cbs[MAX_BUILD_CBS];
+static int build_cb_cnt = 0;
+
+// ------------------------------------------------------------
+// STATE SNAPSHOT
+// Widgets are numbered in depth-first order. A generated screen is
+// rebuilt with the same tree, so the number and the class identify
+// the widget again. Each record is a header followed by its data,
+// padded to the alignment of the header.
+// ------------------------------------------------------------
+typedef enum {
+    REC_CHECKED,            // uint8_t: 1 if checked
+    REC_LABEL,              // NUL-terminated text
+    REC_BAR,                // int32_t: value
+    REC_CHART,              // uint16_t series, uint16_t points, per series: uint16_t start, lv_coord_t[points]
+} rec_kind_t;
+
+_Static_assert(sizeof(lv_coord_t) == sizeof(uint16_t), "REC_CHART layout assumes 16-bit coordinates");
+
+typedef struct {
+    const lv_obj_class_t *cls;
+    uint16_t idx;
+    uint8_t kind;
+    uint32_t len;
+} rec_hdr_t;
+
+#define REC_ALIGN(n)    (((n) + _Alignof(rec_hdr_t) - 1) & ~(size_t)(_Alignof(rec_hdr_t) - 1))
+
+typedef struct {
+    uint8_t *buf;
+    size_t len;
+    size_t cap;
+    bool failed;
+} rec_buf_t;
+
+static void *rec_add(rec_buf_t *rb, lv_obj_t *obj, uint16_t idx, rec_kind_t kind, size_t len)
+{
+    size_t need = rb->len + sizeof(rec_hdr_t) + REC_ALIGN(len);
+    if (rb->failed) return NULL;
+    if (need > rb->cap) {
+        size_t cap = rb->cap ? rb->cap * 2 : 256;
+        while (cap < need) cap *= 2;
+        uint8_t *p = realloc(rb->buf, cap);
+        if (p == NULL) {
+            rb->failed = true;
+            return NULL;
+        }
+        rb->buf = p;
+        rb->cap = cap;
+    }
+
+    rec_hdr_t *h = (rec_hdr_t *)(rb->buf + rb->len);
+    h->cls = lv_obj_get_class(obj);
+    h->idx = idx;
+    h->kind = kind;
+    h->len = len;
+    rb->len = need;
+    return h + 1;
+}
+
+static void save_chart(rec_buf_t *rb, lv_obj_t *chart, uint16_t idx)
+{
+    uint16_t ser_cnt = 0;
+    uint16_t pt_cnt = lv_chart_get_point_count(chart);
+    lv_chart_series_t *ser;
+
+    for (ser = lv_chart_get_series_next(chart, NULL); ser; ser = lv_chart_get_series_next(chart, ser)) ser_cnt++;
+    if (ser_cnt == 0) return;
+
+    size_t ser_len = sizeof(uint16_t) + pt_cnt * sizeof(lv_coord_t);
+    uint16_t *p = rec_add(rb, chart, idx, REC_CHART, 2 * sizeof(uint16_t) + ser_cnt * ser_len);
+    if (p == NULL) return;
+    *p++ = ser_cnt;
+    *p++ = pt_cnt;
+    for (ser = lv_chart_get_series_next(chart, NULL); ser; ser = lv_chart_get_series_next(chart, ser)) {
+        *p++ = lv_chart_get_x_start_point(chart, ser);
+        memcpy(p, lv_chart_get_y_array(chart, ser), pt_cnt * sizeof(lv_coord_t));
+        p += pt_cnt;
+    }
+}
+
+static void save_obj(rec_buf_t *rb, lv_obj_t *obj, uint16_t *idx)
+{
+    uint16_t i = (*idx)++;
+
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_CHECKABLE)) {
+        uint8_t *p = rec_add(rb, obj, i, REC_CHECKED, 1);
+        if (p) *p = lv_obj_has_state(obj, LV_STATE_CHECKED);
+    }
+    if (lv_obj_has_class(obj, &lv_label_class)) {
+        const char *text = lv_label_get_text(obj);
+        char *p = rec_add(rb, obj, i, REC_LABEL, strlen(text) + 1);
+        if (p) strcpy(p, text);
+    } else if (lv_obj_has_class(obj, &lv_bar_class)) {
+        int32_t *p = rec_add(rb, obj, i, REC_BAR, sizeof(int32_t));
+        if (p) *p = lv_bar_get_value(obj);
+    } else if (lv_obj_has_class(obj, &lv_chart_class)) {
+        save_chart(rb, obj, i);
+    }
+
+    for (uint32_t c = 0; c < lv_obj_get_child_cnt(obj); c++) {
+        save_obj(rb, lv_obj_get_child(obj, c), idx);
+    }
+}
+
+static void collect_objs(lv_obj_t *obj, lv_obj_t **objs, uint16_t *idx)
+{
+    if (objs) objs[*idx] = obj;
+    (*idx)++;
+    for (uint32_t c = 0; c < lv_obj_get_child_cnt(obj); c++) {
+        collect_objs(lv_obj_get_child(obj, c), objs, idx);
+    }
+}
+
+static void restore_chart(lv_obj_t *chart, const uint16_t *p)
+{
+    uint16_t ser_cnt = *p++;
+    uint16_t pt_cnt = *p++;
+    if (pt_cnt != lv_chart_get_point_count(chart)) return;
+
+    lv_chart_series_t *ser = lv_chart_get_series_next(chart, NULL);
+    for (uint16_t s = 0; s < ser_cnt && ser; s++) {
+        lv_chart_set_x_start_point(chart, ser, *p++);
+        memcpy(lv_chart_get_y_array(chart, ser), p, pt_cnt * sizeof(lv_coord_t));
+        p += pt_cnt;
+        ser = lv_chart_get_series_next(chart, ser);
+    }
+    lv_chart_refresh(chart);
+}
+
+static void state_restore(lv_obj_t *scr, const uint8_t *state, size_t len)
+{
+    uint16_t cnt = 0;
+    collect_objs(scr, NULL, &cnt);
+    lv_obj_t **objs = malloc(cnt * sizeof(lv_obj_t *));
+    if (objs == NULL) return;
+    cnt = 0;
+    collect_objs(scr, objs, &cnt);
+
+    for (size_t ofs = 0; ofs < len; ) {
+        const rec_hdr_t *h = (const rec_hdr_t *)(state + ofs);
+        const void *data = h + 1;
+        ofs += sizeof(rec_hdr_t) + REC_ALIGN(h->len);
+
+        lv_obj_t *obj = h->idx < cnt ? objs[h->idx] : NULL;
+        if (obj == NULL || lv_obj_get_class(obj) != h->cls) continue;
+
+        switch (h->kind) {
+        case REC_CHECKED:
+            *(const uint8_t *)data ? lv_obj_add_state(obj, LV_STATE_CHECKED) : lv_obj_clear_state(obj, LV_STATE_CHECKED);
+            break;
+        case REC_LABEL:
+            if (strcmp(lv_label_get_text(obj), data) != 0) lv_label_set_text(obj, data);
+            break;
+        case REC_BAR:
+            lv_bar_set_value(obj, *(const int32_t *)data, LV_ANIM_OFF);
+            break;
+        case REC_CHART:
+            restore_chart(obj, data);
+            break;
+        }
+    }
+    free(objs);
+}
+
+// ------------------------------------------------------------
+// BUILD / EVICT
+// ------------------------------------------------------------
+static void evict_cb(void *unused);
+
+static void screen_event_cb(lv_event_t *e)
+{
+    // A screen change is complete: trim the built screens once the animation is gone
+    if (!evict_pending) {
+        evict_pending = true;
+        lv_async_call(evict_cb, NULL);
+    }
+}
+
+static void screen_build(ui_screen_entry_t *s)
+{
+    s->init();
+    if (s->state) {
+        state_restore(*s->scr, s->state, s->state_len);
+        free(s->state);
+        s->state = NULL;
+        s->state_len = 0;
+    }
+    lv_obj_add_event_cb(*s->scr, screen_event_cb, LV_EVENT_SCREEN_LOADED, NULL);
+
+    for (int i = 0; i < build_cb_cnt; i++) {
+        build_cbs[i](*s->scr);
+    }
+}
+
+static void screen_evict(ui_screen_entry_t *s)
+{
+    rec_buf_t rb = { 0 };
+    uint16_t idx = 0;
+
+    save_obj(&rb, *s->scr, &idx);
+    if (rb.failed) {
+        ESP_LOGW(TAG, "No memory to keep the state of a screen");
+        free(rb.buf);
+        rb.buf = NULL;
+        rb.len = 0;
+    }
+    s->state = rb.buf;
+    s->state_len = rb.len;
+    s->destroy();
+    ESP_LOGD(TAG, "Screen %d deleted, %u bytes of state kept", (int)(s - screens), (unsigned) rb.len);
+}
+
+// A screen is in use while shown, animated or about to be shown
+static bool screen_busy(lv_obj_t *scr)
+{
+    lv_disp_t *disp = lv_disp_get_default();
+    return scr == lv_scr_act() || scr == disp->prev_scr || scr == disp->scr_to_load;
+}
+
+static void evict_cb(void *unused)
+{
+    evict_pending = false;
+    if (ui_transition_active()) return;     // runs again when the target is loaded
+
+    int live = 0;
+    for (size_t i = 0; i < SCREEN_CNT; i++) {
+        if (*screens[i].scr) live++;
+    }
+
+    while (live > LIVE_SCREENS) {
+        ui_screen_entry_t *lru = NULL;
+        for (size_t i = 0; i < SCREEN_CNT; i++) {
+            ui_screen_entry_t *s = &screens[i];
+            if (*s->scr == NULL || s->pinned || screen_busy(*s->scr)) continue;
+            if (lru == NULL || s->last_shown < lru->last_shown) lru = s;
+        }
+        if (lru == NULL) break;
+        screen_evict(lru);
+        live--;
+    }
+}
+
+// ------------------------------------------------------------
+// PUBLIC
+// ------------------------------------------------------------
+void ui_screens_init(void)
+{
+    ui_screen_entry_t *home = &screens[0];
+
+    // ui_init() of SquareLine, except that only the home screen is built
+    LV_EVENT_GET_COMP_CHILD = lv_event_register_id();
+
+    lv_disp_t *disp = lv_disp_get_default();
+    lv_theme_t *theme = lv_theme_default_init(disp, lv_palette_main(LV_PALETTE_BLUE), lv_palette_main(LV_PALETTE_RED),
+                                              false, LV_FONT_DEFAULT);
+    lv_disp_set_theme(disp, theme);
+
+    screen_build(home);
+    home->last_shown = ++show_cnt;
+    ui____initial_actions0 = lv_obj_create(NULL);
+    lv_disp_load_scr(*home->scr);
+}
+
+bool ui_screens_load(lv_obj_t **scr, lv_scr_load_anim_t anim, uint32_t time, uint32_t delay)
+{
+    for (size_t i = 0; i < SCREEN_CNT; i++) {
+        ui_screen_entry_t *s = &screens[i];
+        if (s->scr != scr) continue;
+
+        if (*s->scr == NULL) screen_build(s);
+        s->last_shown = ++show_cnt;
+        ui_transition_load(*s->scr, anim, time, delay);
+        return true;
+    }
+    return false;
+}
+
+// The generated event handlers change screens through _ui_screen_change() of
+// ui_helpers.c. The link wraps it (-Wl,--wrap) so main/ui/ stays as exported.
+void __wrap__ui_screen_change(lv_obj_t **target, lv_scr_load_anim_t fademode, int spd, int delay,
+                              void (*target_init)(void))
+{
+    if (ui_screens_load(target, fademode, spd, delay)) return;
+
+    if (*target == NULL) target_init();
+    ui_transition_load(*target, fademode, spd, delay);
+}
+
+bool ui_screens_add_build_cb(ui_screens_build_cb_t cb)
+{
+    if (build_cb_cnt >= MAX_BUILD_CBS) return false;
+    build_cbs[build_cb_cnt++] = cb;
+
+    for (size_t i = 0; i < SCREEN_CNT; i++) {
+        if (*screens[i].scr) cb(*screens[i].scr);
+    }
+    return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <stdbool.h>
+#include "lvgl.h"
+
+// Called with the root of a screen every time the screen is built
+typedef void (*ui_screens_build_cb_t)(lv_obj_t *scr);
+
+/**
+ * @brief Set up the SquareLine UI, build the home screen and show it.
+ *
+ * Call instead of ui_init(), which builds every screen. Screen changes of the generated
+ * event handlers (_ui_screen_change()) go through ui_screens_load().
+ *
+ * The other screens are built on their first visit. At most CONFIG_SMARTHOME_UI_LIVE_SCREENS
+ * screens stay built; once a screen change is complete, the least recently shown screens are
+ * deleted. The home screen is never deleted. The dynamic state of a deleted screen (checked
+ * states, label texts, bar values and chart points) is kept and put back when it is rebuilt.
+ * Must be called from the LVGL thread.
+ */
+void ui_screens_init(void);
+
+/**
+ * @brief Show a screen, building it first if needed.
+ *
+ * @param[in] scr: Screen variable of the SquareLine UI, e.g. &ui_Screen2
+ * @param[in] anim: Animation, as for lv_scr_load_anim()
+ * @param[in] time: Duration of the animation (ms)
+ * @param[in] delay: Delay before the animation starts (ms)
+ *
+ * @return false if `scr` is not a managed screen
+ */
+bool ui_screens_load(lv_obj_t **scr, lv_scr_load_anim_t anim, uint32_t time, uint32_t delay);
+
+/**
+ * @brief Get called whenever a screen is built.
+ *
+ * Widgets of a screen are recreated when the screen is rebuilt, so event callbacks and
+ * other per-widget setup belong here. The callback also runs at once for the screens
+ * already built. Must be called from the LVGL thread.
+ *
+ * @return false if no more callbacks can be added
+ */
+bool ui_screens_add_build_cb(ui_screens_build_cb_t cb);
@@ -0,0 +1,273 @@
+#include "ui_transition.h"
+#include "esp_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if CONFIG_SMARTHOME_UI_SNAPSHOT_TRANSITIONS
+
+static const char *TAG = "UI_TRANS";
+
+// ------------------------------------------------------------
+// STATE
+// The two bitmaps are allocated on the first transition and kept.
+// With CONFIG_SPIRAM_USE_MALLOC they are far above the internal
+// threshold, so they live in PSRAM next to the frame buffers.
+// ------------------------------------------------------------
+#define TRANS_RANGE     256     // animation value of a completed transition
+
+typedef struct {
+    const lv_color_t *img;      // full screen bitmap
+    lv_coord_t x;               // position of the bitmap on the screen
+    lv_coord_t y;
+} trans_layer_t;
+
+static lv_color_t *snap_old = NULL;     // screen being left
+static lv_color_t *snap_new = NULL;     // screen being loaded
+static uint32_t snap_size = 0;          // bytes of each bitmap
+static lv_coord_t snap_w;
+static lv_coord_t snap_h;
+
+static lv_obj_t *trans_scr = NULL;      // plain screen shown during the transition
+static lv_obj_t *trans_target = NULL;
+static lv_scr_load_anim_t trans_anim;
+static int32_t trans_pos;               // 0 .. TRANS_RANGE
+
+// ------------------------------------------------------------
+// BLEND KERNELS
+// ------------------------------------------------------------
+
+// dst = a * (1 - mix) + b * mix, mix in 0..255
+static void blend_row(lv_color_t *dst, const lv_color_t *a, const lv_color_t *b, int32_t n, lv_opa_t mix)
+{
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+    // RGB565 spread to 0x07E0F81F leaves 5 free bits above each channel,
+    // so one multiply per pixel and operand blends all three channels
+    const uint32_t wb = (mix + 4) >> 3;  // 0..32
+    const uint32_t wa = 32 - wb;
+    for (int32_t i = 0; i < n; i++) {
+        uint32_t ca = a[i].full;
+        uint32_t cb = b[i].full;
+        ca = (ca | (ca << 16)) & 0x07E0F81F;
+        cb = (cb | (cb << 16)) & 0x07E0F81F;
+        uint32_t c = ((ca * wa + cb * wb) >> 5) & 0x07E0F81F;
+        dst[i].full = (uint16_t)(c | (c >> 16));
+    }
+#else
+    for (int32_t i = 0; i < n; i++) {
+        dst[i] = lv_color_mix(b[i], a[i], mix);
+    }
+#endif
+}
+
+// Copy the part of a layer inside `clip` into the draw buffer
+static void copy_layer(lv_color_t *buf, const lv_area_t *buf_area, const lv_area_t *clip,
+                       const trans_layer_t *layer)
+{
+    lv_area_t layer_area = { layer->x, layer->y, layer->x + snap_w - 1, layer->y + snap_h - 1 };
+    lv_area_t a;
+    if (!_lv_area_intersect(&a, &layer_area, clip)) return;
+
+    const lv_coord_t buf_w = lv_area_get_width(buf_area);
+    const size_t row_bytes = lv_area_get_width(&a) * sizeof(lv_color_t);
+    lv_color_t *dst = buf + (a.y1 - buf_area->y1) * buf_w + (a.x1 - buf_area->x1);
+    const lv_color_t *src = layer->img + (a.y1 - layer->y) * snap_w + (a.x1 - layer->x);
+    for (lv_coord_t y = a.y1; y <= a.y2; y++) {
+        memcpy(dst, src, row_bytes);
+        dst += buf_w;
+        src += snap_w;
+    }
+}
+
+static void blend_layers(lv_color_t *buf, const lv_area_t *buf_area, const lv_area_t *clip, lv_opa_t mix)
+{
+    const lv_coord_t buf_w = lv_area_get_width(buf_area);
+    const int32_t n = lv_area_get_width(clip);
+    lv_color_t *dst = buf + (clip->y1 - buf_area->y1) * buf_w + (clip->x1 - buf_area->x1);
+    const int32_t ofs = clip->y1 * snap_w + clip->x1;
+    const lv_color_t *a = snap_old + ofs;
+    const lv_color_t *b = snap_new + ofs;
+    for (lv_coord_t y = clip->y1; y <= clip->y2; y++) {
+        blend_row(dst, a, b, n, mix);
+        dst += buf_w;
+        a += snap_w;
+        b += snap_w;
+    }
+}
+
+// ------------------------------------------------------------
+// TRANSITION SCREEN
+// ------------------------------------------------------------
+
+// Place the two bitmaps for the current position. Returns the number of layers, bottom first.
+static int layout_layers(trans_layer_t layers[2])
+{
+    const lv_coord_t dx = (lv_coord_t)((int32_t)snap_w * trans_pos / TRANS_RANGE);
+    const lv_coord_t dy = (lv_coord_t)((int32_t)snap_h * trans_pos / TRANS_RANGE);
+    trans_layer_t *old = &layers[0];
+    trans_layer_t *new = &layers[1];
+
+    *old = (trans_layer_t){ snap_old, 0, 0 };
+    *new = (trans_layer_t){ snap_new, 0, 0 };
+
+    switch (trans_anim) {
+    case LV_SCR_LOAD_ANIM_OVER_LEFT:    new->x = snap_w - dx; break;
+    case LV_SCR_LOAD_ANIM_OVER_RIGHT:   new->x = dx - snap_w; break;
+    case LV_SCR_LOAD_ANIM_OVER_TOP:     new->y = snap_h - dy; break;
+    case LV_SCR_LOAD_ANIM_OVER_BOTTOM:  new->y = dy - snap_h; break;
+    case LV_SCR_LOAD_ANIM_MOVE_LEFT:    old->x = -dx; new->x = old->x + snap_w; break;
+    case LV_SCR_LOAD_ANIM_MOVE_RIGHT:   old->x = dx;  new->x = old->x - snap_w; break;
+    case LV_SCR_LOAD_ANIM_MOVE_TOP:     old->y = -dy; new->y = old->y + snap_h; break;
+    case LV_SCR_LOAD_ANIM_MOVE_BOTTOM:  old->y = dy;  new->y = old->y - snap_h; break;
+    // The old screen moves away on top of the new one
+    case LV_SCR_LOAD_ANIM_OUT_LEFT:     old->x = -dx; break;
+    case LV_SCR_LOAD_ANIM_OUT_RIGHT:    old->x = dx;  break;
+    case LV_SCR_LOAD_ANIM_OUT_TOP:      old->y = -dy; break;
+    case LV_SCR_LOAD_ANIM_OUT_BOTTOM:   old->y = dy;  break;
+    default:                            break;
+    }
+
+    if (trans_anim >= LV_SCR_LOAD_ANIM_OUT_LEFT && trans_anim <= LV_SCR_LOAD_ANIM_OUT_BOTTOM) {
+        trans_layer_t tmp = *old;
+        *old = *new;
+        *new = tmp;
+    }
+    return 2;
+}
+
+static void trans_scr_event_cb(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+
+    if (code == LV_EVENT_COVER_CHECK) {
+        // Every pixel is written below: nothing behind the screen needs drawing
+        lv_cover_check_info_t *info = lv_event_get_param(e);
+        info->res = LV_COVER_RES_COVER;
+    } else if (code == LV_EVENT_DRAW_MAIN) {
+        lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+        const lv_area_t scr_area = { 0, 0, snap_w - 1, snap_h - 1 };
+        lv_area_t clip;
+        if (!_lv_area_intersect(&clip, draw_ctx->clip_area, &scr_area)) return;
+
+        if (draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+        lv_color_t *buf = draw_ctx->buf;
+
+        if (trans_anim == LV_SCR_LOAD_ANIM_FADE_IN || trans_anim == LV_SCR_LOAD_ANIM_FADE_OUT) {
+            blend_layers(buf, draw_ctx->buf_area, &clip, (lv_opa_t)LV_MIN(trans_pos, 255));
+        } else {
+            trans_layer_t layers[2];
+            int cnt = layout_layers(layers);
+            for (int i = 0; i < cnt; i++) {
+                copy_layer(buf, draw_ctx->buf_area, &clip, &layers[i]);
+            }
+        }
+    }
+}
+
+static void trans_anim_cb(void *var, int32_t v)
+{
+    trans_pos = v;
+    lv_obj_invalidate(var);
+}
+
+// Load the target for good and drop the transition screen
+static void trans_finish(void)
+{
+    lv_obj_t *scr = trans_scr;
+    lv_obj_t *target = trans_target;
+
+    trans_scr = NULL;
+    trans_target = NULL;
+    lv_anim_del(scr, NULL);
+    lv_scr_load(target);
+    lv_obj_del_async(scr);
+}
+
+static void trans_ready_cb(lv_anim_t *a)
+{
+    trans_finish();
+}
+
+static bool snapshot_alloc(void)
+{
+    lv_disp_t *disp = lv_disp_get_default();
+    snap_w = lv_disp_get_hor_res(disp);
+    snap_h = lv_disp_get_ver_res(disp);
+    snap_size = (uint32_t)snap_w * snap_h * sizeof(lv_color_t);
+
+    snap_old = malloc(snap_size);
+    snap_new = malloc(snap_size);
+    if (snap_old == NULL || snap_new == NULL) {
+        ESP_LOGW(TAG, "No memory for screen snapshots (2 x %u bytes)", (unsigned) snap_size);
+        free(snap_old);
+        free(snap_new);
+        snap_old = snap_new = NULL;
+        return false;
+    }
+    return true;
+}
+
+static bool snapshot_take(lv_obj_t *scr, lv_color_t *buf)
+{
+    lv_img_dsc_t dsc;
+
+    lv_obj_update_layout(scr);  // A screen never shown has no layout yet
+    if (lv_snapshot_buf_size_needed(scr, LV_IMG_CF_TRUE_COLOR) != snap_size) return false;
+    return lv_snapshot_take_to_buf(scr, LV_IMG_CF_TRUE_COLOR, &dsc, buf, snap_size) == LV_RES_OK;
+}
+
+// ------------------------------------------------------------
+// PUBLIC
+// ------------------------------------------------------------
+void ui_transition_load(lv_obj_t *scr, lv_scr_load_anim_t anim, uint32_t time, uint32_t delay)
+{
+    if (trans_scr) {
+        trans_finish();
+    }
+
+    lv_obj_t *act = lv_scr_act();
+    if (scr == act) return;
+
+    if (anim == LV_SCR_LOAD_ANIM_NONE || time == 0 || (snap_old == NULL && !snapshot_alloc()) ||
+            !snapshot_take(act, snap_old) || !snapshot_take(scr, snap_new)) {
+        lv_scr_load_anim(scr, anim, time, delay, false);
+        return;
+    }
+
+    trans_scr = lv_obj_create(NULL);
+    lv_obj_remove_style_all(trans_scr);     // nothing drawn but the bitmaps
+    lv_obj_clear_flag(trans_scr, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(trans_scr, trans_scr_event_cb, LV_EVENT_ALL, NULL);
+    trans_target = scr;
+    trans_anim = anim;
+    trans_pos = 0;
+    lv_scr_load(trans_scr);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, trans_scr);
+    lv_anim_set_exec_cb(&a, trans_anim_cb);
+    lv_anim_set_ready_cb(&a, trans_ready_cb);
+    lv_anim_set_values(&a, 0, TRANS_RANGE);
+    lv_anim_set_time(&a, time);
+    lv_anim_set_delay(&a, delay);
+    lv_anim_start(&a);
+}
+
+bool ui_transition_active(void)
+{
+    return trans_scr != NULL;
+}
+
+#else
+
+void ui_transition_load(lv_obj_t *scr, lv_scr_load_anim_t anim, uint32_t time, uint32_t delay)
+{
+    lv_scr_load_anim(scr, anim, time, delay, false);
+}
+
+bool ui_transition_active(void)
+{
+    return false;
+}
+
+#endif /* CONFIG_SMARTHOME_UI_SNAPSHOT_TRANSITIONS */
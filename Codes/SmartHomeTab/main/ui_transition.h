@@ -0,0 +1,25 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+/**
+ * @brief Load a screen with a load animation played from snapshots.
+ *
+ * Both screens are rendered once into cached bitmaps; while the animation runs only a
+ * cross-fade or a copy of the two bitmaps is drawn, so the frame time does not depend on
+ * the widgets of the screens. Fade, move, over and out animations are supported. The screen
+ * is loaded with lv_scr_load_anim() if CONFIG_SMARTHOME_UI_SNAPSHOT_TRANSITIONS is off, for
+ * LV_SCR_LOAD_ANIM_NONE, or if the bitmaps cannot be allocated. Must be called from the LVGL thread.
+ *
+ * A transition still running is completed first.
+ *
+ * @param[in] scr: Screen to load
+ * @param[in] anim: Animation, as for lv_scr_load_anim()
+ * @param[in] time: Duration of the animation (ms)
+ * @param[in] delay: Delay before the animation starts (ms)
+ */
+void ui_transition_load(lv_obj_t *scr, lv_scr_load_anim_t anim, uint32_t time, uint32_t delay);
+
+// True while a snapshot transition is running
+bool ui_transition_active(void);
@@ -18,7 +18,7 @@
 #define I2C_MASTER_SCL_IO           16       /*!< GPIO number used for I2C master clock */
 #define I2C_MASTER_SDA_IO           15       /*!< GPIO number used for I2C master data  */
 #define I2C_MASTER_NUM              0       /*!< I2C master i2c port number, the number of i2c peripheral interfaces available will depend on the chip */
-#define I2C_MASTER_FREQ_HZ          400000                     /*!< I2C master clock frequency */
+#define I2C_MASTER_FREQ_HZ          (CONFIG_SMARTHOME_I2C_FREQ_HZ) /*!< I2C master clock frequency */
 #define I2C_MASTER_TX_BUF_DISABLE   0                          /*!< I2C master doesn't need buffer */
 #define I2C_MASTER_RX_BUF_DISABLE   0                          /*!< I2C master doesn't need buffer */
 #define I2C_MASTER_TIMEOUT_MS       1000
@@ -63,7 +63,7 @@
 #define EXAMPLE_LCD_BK_LIGHT_OFF_LEVEL  !EXAMPLE_LCD_BK_LIGHT_ON_LEVEL
 
 #define EXAMPLE_PIN_NUM_TOUCH_RST       (-1)            // -1 if not used
-#define EXAMPLE_PIN_NUM_TOUCH_INT       (-1)            // -1 if not used
+#define EXAMPLE_PIN_NUM_TOUCH_INT       (CONFIG_EXAMPLE_LCD_TOUCH_INT_GPIO) // -1 if not used
 
 static const char *TAG = "example";
 
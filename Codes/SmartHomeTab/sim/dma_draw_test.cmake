@@ -0,0 +1,22 @@
+# Run a feed on the simulator with and without the DMA draw context
+# and compare the screenshots.
+#
+#   cmake -DSIM=... -DSIM_DMA=... -DFEED=... -DOUT=dir -P dma_draw_test.cmake
+file(MAKE_DIRECTORY ${OUT})
+foreach(sim cpu dma)
+    if(sim STREQUAL "cpu")
+        set(exe ${SIM})
+    else()
+        set(exe ${SIM_DMA})
+    endif()
+    execute_process(COMMAND ${exe} --feed ${FEED} --dump ${OUT}/${sim}.ppm
+                    RESULT_VARIABLE res OUTPUT_QUIET ERROR_QUIET TIMEOUT 300)
+    if(NOT res EQUAL 0)
+        message(FATAL_ERROR "${exe} failed: ${res}")
+    endif()
+endforeach()
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${OUT}/cpu.ppm ${OUT}/dma.ppm RESULT_VARIABLE res)
+if(NOT res EQUAL 0)
+    message(FATAL_ERROR "The DMA draw context drew ${OUT}/dma.ppm unlike the CPU (${OUT}/cpu.ppm)")
+endif()
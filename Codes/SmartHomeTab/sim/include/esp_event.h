@@ -0,0 +1,8 @@
+// Host simulator stand-in for the ESP-IDF header of the same name
+#pragma once
+#include <stdint.h>
+
+typedef const char *esp_event_base_t;
+typedef void (*esp_event_handler_t)(void *handler_args, esp_event_base_t base, int32_t event_id, void *event_data);
+
+#define ESP_EVENT_ANY_ID    (-1)
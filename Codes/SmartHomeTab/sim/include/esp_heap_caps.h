@@ -0,0 +1,15 @@
+// Host simulator stand-in for the ESP-IDF header of the same name
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_8BIT         (1 << 2)
+#define MALLOC_CAP_SPIRAM       (1 << 10)
+#define MALLOC_CAP_INTERNAL     (1 << 11)
+
+// One heap on the host
+static inline void *heap_caps_malloc(size_t size, uint32_t caps)
+{
+    (void) caps;
+    return malloc(size);
+}
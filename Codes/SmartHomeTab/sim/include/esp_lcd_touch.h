@@ -0,0 +1,4 @@
+// Host simulator stand-in for the component header of the same name
+#pragma once
+
+typedef struct esp_lcd_touch_s *esp_lcd_touch_handle_t;
@@ -0,0 +1,5 @@
+// Host simulator stand-in for the ESP-IDF header of the same name
+#pragma once
+
+typedef struct esp_lcd_panel_t *esp_lcd_panel_handle_t;
+typedef struct esp_lcd_panel_io_t *esp_lcd_panel_io_handle_t;
@@ -0,0 +1,14 @@
+// Host simulator stand-in for the ESP-IDF header of the same name
+#pragma once
+#include <stdint.h>
+
+// CRC-32 (IEEE, reflected) like the ROM function: pass the previous result to continue it
+static inline uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int i = 0; i < 8; i++) crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+    }
+    return ~crc;
+}
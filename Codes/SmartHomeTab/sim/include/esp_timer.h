@@ -0,0 +1,6 @@
+// Host simulator stand-in for the ESP-IDF header of the same name
+#pragma once
+#include <stdint.h>
+
+// Microseconds since the simulator started, on the simulated clock of feed files (see sim.h)
+int64_t esp_timer_get_time(void);
@@ -0,0 +1,15 @@
+// Host simulator stand-in for the FreeRTOS header of the same name
+#pragma once
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define configTICK_RATE_HZ      1000
+#define portTICK_PERIOD_MS      (1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY           ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+#define pdTRUE                  1
+#define pdFALSE                 0
+#define pdPASS                  pdTRUE
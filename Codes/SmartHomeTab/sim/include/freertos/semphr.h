@@ -0,0 +1,12 @@
+// Host simulator stand-in for the FreeRTOS header of the same name
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+typedef struct sim_semaphore *SemaphoreHandle_t;
+
+// Binary semaphore, created empty
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+
+// pdTRUE once given, pdFALSE after `ticks` (host time)
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
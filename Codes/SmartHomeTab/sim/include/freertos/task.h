@@ -0,0 +1,24 @@
+// Host simulator stand-in for the FreeRTOS header of the same name
+#pragma once
+#include <pthread.h>
+#include "freertos/FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void *arg);
+typedef void *TaskHandle_t;
+
+#define tskIDLE_PRIORITY    0
+
+// A detached thread; the stack size and the priority are ignored
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                       UBaseType_t priority, TaskHandle_t *handle);
+
+void vTaskDelay(TickType_t ticks);
+
+// Spinlocks of the critical sections, a mutex on the host
+typedef struct {
+    pthread_mutex_t mutex;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED    { PTHREAD_MUTEX_INITIALIZER }
+#define taskENTER_CRITICAL(mux)         pthread_mutex_lock(&(mux)->mutex)
+#define taskEXIT_CRITICAL(mux)          pthread_mutex_unlock(&(mux)->mutex)
@@ -0,0 +1,136 @@
+/*
+ * Host test of the topic routing of main/ui_mqtt_bridge.c.
+ *
+ * Bindings without a widget run as soon as a message arrives, so every handler call can be
+ * checked right after ui_handle_mqtt_message():
+ *   1. exact, `+` and `#` filters get the topics MQTT says they match, in registration order;
+ *   2. wildcards don't match topics starting with '$';
+ *   3. a wildcard bound after a topic was seen gets that topic too;
+ *   4. a binding whose widget is not built yet is not called.
+ *
+ *   ctest --test-dir build   (or ./build/mqtt_bridge_test)
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "lvgl.h"
+#include "ui_mqtt_bridge.h"
+
+// The MQTT client is not needed: the bridge only subscribes
+esp_err_t mqtt_manager_subscribe(const char *filter)
+{
+    (void) filter;
+    return ESP_OK;
+}
+
+void mqtt_manager_publish(const char *topic, const char *payload)
+{
+    (void) topic;
+    (void) payload;
+}
+
+static const char *const filters[] = {
+    "home/a/temp",      // 0
+    "home/+/temp",      // 1
+    "home/#",           // 2
+    "#",                // 3
+    "+/+",              // 4
+    "home/a/+",         // 5
+    "home/+",           // 6
+};
+#define LATE_FILTER     "+/a/#"     // 7, bound after the first round
+
+static const struct {
+    const char *topic;
+    const char *fired;              // bindings called, in order
+} cases[] = {
+    { "home/a/temp", "012357" },    // 7 only once bound
+    { "home/b/temp", "123" },
+    { "home//temp", "123" },        // '+' matches an empty level
+    { "home/a/hum", "235" },
+    { "home/a", "2346" },
+    { "home", "23" },               // "home/#" also matches its parent
+    { "home/a/temp/x", "23" },
+    { "office/x", "34" },
+    { "$SYS/x", "" },
+};
+
+static char fired[16];
+static size_t fired_cnt;
+static int errors;
+
+static void record(lv_obj_t *widget, const ui_mqtt_value_t *value, void *user_data)
+{
+    if (widget != NULL) {
+        printf("FAIL binding %d called with a widget on %s\n", (int)(intptr_t) user_data, value->topic);
+        errors++;
+    }
+    if (fired_cnt < sizeof(fired) - 1) fired[fired_cnt++] = (char)('0' + (intptr_t) user_data);
+    fired[fired_cnt] = '\0';
+}
+
+static void not_built(lv_obj_t *widget, const ui_mqtt_value_t *value, void *user_data)
+{
+    (void) widget;
+    (void) user_data;
+    printf("FAIL binding of a widget not built yet called on %s\n", value->topic);
+    errors++;
+}
+
+static void bind(const char *filter, intptr_t id)
+{
+    if (ui_mqtt_bridge_register(filter, NULL, record, NULL, (void *) id, -1.0f) != ESP_OK) {
+        printf("FAIL cannot bind %s\n", filter);
+        errors++;
+    }
+}
+
+// `expected` with the late binding's id dropped unless `late`
+static void check(const char *topic, const char *expected, bool late)
+{
+    char want[16];
+    size_t n = 0;
+    for (const char *c = expected; *c; c++) {
+        if (*c != '7' || late) want[n++] = *c;
+    }
+    want[n] = '\0';
+
+    fired_cnt = 0;
+    fired[0] = '\0';
+    ui_handle_mqtt_message(topic, "1");
+    if (strcmp(fired, want) != 0) {
+        printf("FAIL %s fired bindings \"%s\", expected \"%s\"\n", topic, fired, want);
+        errors++;
+    }
+}
+
+int main(void)
+{
+    static lv_obj_t *unbuilt_widget;
+
+    lv_init();
+    for (size_t i = 0; i < sizeof(filters) / sizeof(filters[0]); i++) {
+        bind(filters[i], (intptr_t) i);
+    }
+    ui_mqtt_bridge_register("home/#", NULL, not_built, &unbuilt_widget, NULL, -1.0f);
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        check(cases[i].topic, cases[i].fired, false);
+    }
+
+    // The topics are known now: the new wildcard must be routed to those it matches
+    bind(LATE_FILTER, 7);
+    check("home/a/temp", "012357", true);
+    check("office/a", "347", true);     // interned by this message
+    check("home/b/temp", "123", true);
+
+    if (ui_mqtt_bridge_register("home/a+", NULL, record, NULL, NULL, -1.0f) != ESP_ERR_INVALID_ARG ||
+        ui_mqtt_bridge_register("home/#/x", NULL, record, NULL, NULL, -1.0f) != ESP_ERR_INVALID_ARG) {
+        printf("FAIL malformed filter accepted\n");
+        errors++;
+    }
+
+    if (errors == 0) printf("PASS\n");
+    return errors ? 1 : 0;
+}
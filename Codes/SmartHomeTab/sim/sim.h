@@ -0,0 +1,53 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+// Render the current screen and write it as a binary PPM (P6). Safe from any thread.
+bool sim_dump_ppm(const char *path);
+
+// Show screen 1, 2 or 3 of the SquareLine UI. Safe from any thread.
+bool sim_load_screen(int index);
+
+// Change to screen 1, 2 or 3 with the 500 ms fade of the UI buttons. Safe from any thread.
+bool sim_navigate(int index);
+
+// Show a time, "YYYY-MM-DD HH:MM:SS", on the clock like the RTC task. Safe from any thread.
+bool sim_set_time(const char *text);
+
+// Redraw the whole screen FRAMES times and print the time per frame. Safe from any thread.
+void sim_bench(int frames);
+
+// Print frame, queue and bridge counters to stdout. Safe from any thread.
+void sim_print_stats(void);
+
+// True once a message feed (file or stdin) has been read to the end
+bool sim_mqtt_feed_done(void);
+
+// Back the `state` flash partition with a file, created erased if missing. Call before state_store_init().
+bool sim_flash_open(const char *path);
+
+// Run the LVGL tick and vTaskDelay() on the simulated clock from now on (sim_esp.c). Call before
+// the feed thread starts.
+void sim_clock_start(void);
+bool sim_clock_started(void);
+
+// The simulated time, or the host's while the simulated clock is not started. esp_timer_get_time() too.
+int64_t sim_clock_now_us(void);
+
+// Microseconds since the simulator started, on the host's clock: for measuring the rendering
+int64_t sim_host_time_us(void);
+
+// The calling thread works at the current simulated time: the clock waits until it releases it
+// or sleeps in vTaskDelay(). No effect without the simulated clock.
+void sim_clock_hold(void);
+void sim_clock_release(void);
+
+// Main loop: wait until no thread holds the clock. Returns when the sleeping thread wakes, INT64_MAX if none.
+int64_t sim_clock_idle(void);
+
+// Main loop, idle clock: move the simulated time to `us`, waking the sleeping thread if it is due
+void sim_clock_advance(int64_t us);
+
+// Main loop helpers of sim_lvgl_port.c, mirroring lvgl_port_task()
+void sim_lvgl_port_trigger_run(void);
+void sim_lvgl_port_sleep(uint32_t ms);
@@ -0,0 +1,100 @@
+// ------------------------------------------------------------
+// COPY ENGINE
+// Host stand-in for the async memcpy (GDMA) engine of
+// main/lvgl_port_dma.c: a worker thread runs the queued copies in
+// order while the LVGL thread goes on, so a missing wait in the
+// draw context shows up as a wrong screenshot. The alignment rules
+// are the device's, so the same rows go to the engine.
+// ------------------------------------------------------------
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_port_dma.h"
+
+#define SIM_DMA_BACKLOG 16
+
+typedef struct {
+    void *dst;
+    const void *src;
+    size_t size;
+} copy_t;
+
+static pthread_mutex_t mux = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queued_cond = PTHREAD_COND_INITIALIZER;   // A copy was queued
+static pthread_cond_t done_cond = PTHREAD_COND_INITIALIZER;     // A copy is done
+static copy_t queue[SIM_DMA_BACKLOG];
+static int queue_first;
+static int queue_cnt;                         // Queued copies, the running one included
+static pthread_t worker;
+static bool started;
+
+static void *worker_main(void *arg)
+{
+    (void) arg;
+    pthread_mutex_lock(&mux);
+    for (;;) {
+        while (queue_cnt == 0) {
+            pthread_cond_wait(&queued_cond, &mux);
+        }
+        copy_t copy = queue[queue_first];
+        pthread_mutex_unlock(&mux);
+
+        memcpy(copy.dst, copy.src, copy.size);
+
+        pthread_mutex_lock(&mux);
+        queue_first = (queue_first + 1) % SIM_DMA_BACKLOG;
+        queue_cnt--;
+        pthread_cond_broadcast(&done_cond);
+    }
+    return NULL;
+}
+
+bool lvgl_port_dma_init(void)
+{
+    pthread_mutex_lock(&mux);
+    if (!started) {
+        started = pthread_create(&worker, NULL, worker_main, NULL) == 0;
+    }
+    pthread_mutex_unlock(&mux);
+    return started;
+}
+
+void *lvgl_port_dma_alloc(size_t size)
+{
+    size = (size + LVGL_PORT_DMA_ALIGN - 1) / LVGL_PORT_DMA_ALIGN * LVGL_PORT_DMA_ALIGN;
+    return aligned_alloc(LVGL_PORT_DMA_ALIGN, size);
+}
+
+void lvgl_port_dma_free(void *buf)
+{
+    free(buf);
+}
+
+bool lvgl_port_dma_copy(void *dst, const void *src, size_t size)
+{
+    if (!started || (((uintptr_t)dst | size) & (LVGL_PORT_DMA_ALIGN - 1)) != 0 || ((uintptr_t)src & 0x3) != 0) {
+        return false;
+    }
+
+    pthread_mutex_lock(&mux);
+    while (queue_cnt == SIM_DMA_BACKLOG) {
+        pthread_cond_wait(&done_cond, &mux);
+    }
+    queue[(queue_first + queue_cnt) % SIM_DMA_BACKLOG] = (copy_t) {
+        .dst = dst, .src = src, .size = size
+    };
+    queue_cnt++;
+    pthread_cond_signal(&queued_cond);
+    pthread_mutex_unlock(&mux);
+    return true;
+}
+
+void lvgl_port_dma_wait(void)
+{
+    pthread_mutex_lock(&mux);
+    while (queue_cnt > 0) {
+        pthread_cond_wait(&done_cond, &mux);
+    }
+    pthread_mutex_unlock(&mux);
+}
@@ -0,0 +1,319 @@
+// ------------------------------------------------------------
+// ESP-IDF SERVICES USED BY THE APP, ON THE HOST
+// ------------------------------------------------------------
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_timer.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "sim.h"
+
+static const char *TAG = "SIM";
+
+static int64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+int64_t sim_host_time_us(void)
+{
+    static int64_t start = 0;
+    if (start == 0) start = now_us();
+    return now_us() - start;
+}
+
+// The app's time: the sensor history, the alarm and the perf report follow the simulated clock
+int64_t esp_timer_get_time(void)
+{
+    return sim_clock_now_us();
+}
+
+// ------------------------------------------------------------
+// SIMULATED CLOCK
+// File feeds run on a clock of their own, which esp_timer_get_time()
+// returns too. It stands still while the
+// main loop or the feed thread works, and jumps to the next LVGL
+// timer or the end of the feed's `.wait` once both are idle: a feed
+// gives the same frames, counters and screenshots on every run,
+// however fast the host is and however many threads render.
+// ------------------------------------------------------------
+static atomic_bool clock_on;
+static atomic_llong clock_us;                   // Written by the main loop only
+static pthread_mutex_t clock_mux = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t clock_cond = PTHREAD_COND_INITIALIZER;
+static int clock_holders;                       // Threads working at the current time, protected by clock_mux
+static int64_t sleep_until = INT64_MAX;         // Wakeup of the sleeping feed thread, protected by clock_mux
+
+void sim_clock_start(void)
+{
+    atomic_store(&clock_us, sim_host_time_us());
+    atomic_store(&clock_on, true);
+}
+
+bool sim_clock_started(void)
+{
+    return atomic_load(&clock_on);
+}
+
+int64_t sim_clock_now_us(void)
+{
+    return atomic_load(&clock_on) ? atomic_load(&clock_us) : sim_host_time_us();
+}
+
+void sim_clock_hold(void)
+{
+    if (!atomic_load(&clock_on)) return;
+    pthread_mutex_lock(&clock_mux);
+    clock_holders++;
+    pthread_mutex_unlock(&clock_mux);
+}
+
+void sim_clock_release(void)
+{
+    if (!atomic_load(&clock_on)) return;
+    pthread_mutex_lock(&clock_mux);
+    clock_holders--;
+    pthread_cond_broadcast(&clock_cond);
+    pthread_mutex_unlock(&clock_mux);
+}
+
+int64_t sim_clock_idle(void)
+{
+    if (!atomic_load(&clock_on)) return INT64_MAX;
+    pthread_mutex_lock(&clock_mux);
+    while (clock_holders > 0) pthread_cond_wait(&clock_cond, &clock_mux);
+    int64_t wake = sleep_until;
+    pthread_mutex_unlock(&clock_mux);
+    return wake;
+}
+
+void sim_clock_advance(int64_t us)
+{
+    pthread_mutex_lock(&clock_mux);
+    atomic_store(&clock_us, us);
+    if (sleep_until <= us) {
+        // The sleeper works at the new time before the main loop goes on
+        sleep_until = INT64_MAX;
+        clock_holders++;
+        pthread_cond_broadcast(&clock_cond);
+    }
+    pthread_mutex_unlock(&clock_mux);
+}
+
+// On the simulated clock, only the thread holding it (the feed) may sleep
+void vTaskDelay(TickType_t ticks)
+{
+    uint32_t ms = ticks * portTICK_PERIOD_MS;
+
+    if (atomic_load(&clock_on)) {
+        pthread_mutex_lock(&clock_mux);
+        sleep_until = atomic_load(&clock_us) + (int64_t) ms * 1000;
+        clock_holders--;
+        pthread_cond_broadcast(&clock_cond);
+        while (sleep_until != INT64_MAX) pthread_cond_wait(&clock_cond, &clock_mux);
+        pthread_mutex_unlock(&clock_mux);
+        return;
+    }
+
+    struct timespec ts = { .tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000 };
+    nanosleep(&ts, NULL);
+}
+
+// ------------------------------------------------------------
+// TASKS
+// ------------------------------------------------------------
+typedef struct {
+    TaskFunction_t fn;
+    void *arg;
+} task_start_t;
+
+static void *task_main(void *p)
+{
+    task_start_t start = *(task_start_t *) p;
+    free(p);
+    start.fn(start.arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                       UBaseType_t priority, TaskHandle_t *handle)
+{
+    (void) name;
+    (void) stack;
+    (void) priority;
+    task_start_t *start = malloc(sizeof(*start));
+    if (start == NULL) return pdFALSE;
+    start->fn = fn;
+    start->arg = arg;
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, task_main, start) != 0) {
+        free(start);
+        return pdFALSE;
+    }
+    pthread_detach(thread);
+    if (handle) *handle = NULL;
+    return pdPASS;
+}
+
+struct sim_semaphore {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool given;
+};
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    SemaphoreHandle_t sem = calloc(1, sizeof(*sem));
+    if (sem == NULL) return NULL;
+    pthread_mutex_init(&sem->mutex, NULL);
+    pthread_cond_init(&sem->cond, NULL);
+    return sem;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    struct timespec until;
+    clock_gettime(CLOCK_REALTIME, &until);
+    int64_t ns = until.tv_nsec + (int64_t)(ticks % 1000) * 1000000;
+    until.tv_sec += ticks / 1000 + ns / 1000000000;
+    until.tv_nsec = ns % 1000000000;
+
+    pthread_mutex_lock(&sem->mutex);
+    while (!sem->given) {
+        if (ticks == portMAX_DELAY) pthread_cond_wait(&sem->cond, &sem->mutex);
+        else if (pthread_cond_timedwait(&sem->cond, &sem->mutex, &until) != 0) break;
+    }
+    bool taken = sem->given;
+    sem->given = false;
+    pthread_mutex_unlock(&sem->mutex);
+    return taken ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    pthread_mutex_lock(&sem->mutex);
+    bool was_given = sem->given;
+    sem->given = true;
+    pthread_cond_signal(&sem->cond);
+    pthread_mutex_unlock(&sem->mutex);
+    return was_given ? pdFALSE : pdTRUE;
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+    case ESP_OK: return "ESP_OK";
+    case ESP_FAIL: return "ESP_FAIL";
+    case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE: return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+    default: return "ESP_ERR";
+    }
+}
+
+// ------------------------------------------------------------
+// FLASH
+// The `state` partition of partitions.csv as a file, mapped into
+// memory. Writes only clear bits, like NOR flash.
+// ------------------------------------------------------------
+#define SIM_STATE_SIZE      0x200000
+
+static esp_partition_t state_part = {
+    .type = ESP_PARTITION_TYPE_DATA,
+    .subtype = ESP_PARTITION_SUBTYPE_DATA_UNDEFINED,
+    .size = SIM_STATE_SIZE,
+    .erase_size = 4096,
+    .label = "state",
+};
+static uint8_t *flash;
+
+bool sim_flash_open(const char *path)
+{
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        ESP_LOGE(TAG, "Cannot open %s", path);
+        return false;
+    }
+
+    // A new file is erased flash
+    off_t size = lseek(fd, 0, SEEK_END);
+    bool fresh = size < SIM_STATE_SIZE;
+    if (fresh && ftruncate(fd, SIM_STATE_SIZE) != 0) {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, SIM_STATE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    flash = map;
+    if (fresh) memset(flash + size, 0xFF, SIM_STATE_SIZE - size);
+    return true;
+}
+
+static bool flash_range_ok(const esp_partition_t *partition, size_t offset, size_t size)
+{
+    return partition == &state_part && flash && offset <= partition->size && size <= partition->size - offset;
+}
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char *label)
+{
+    if (flash == NULL || type != state_part.type || subtype != state_part.subtype) return NULL;
+    if (label && strcmp(label, state_part.label) != 0) return NULL;
+    return &state_part;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t src_offset, void *dst, size_t size)
+{
+    if (!flash_range_ok(partition, src_offset, size)) return ESP_ERR_INVALID_ARG;
+    memcpy(dst, flash + src_offset, size);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *partition, size_t dst_offset, const void *src, size_t size)
+{
+    if (!flash_range_ok(partition, dst_offset, size)) return ESP_ERR_INVALID_ARG;
+    const uint8_t *s = src;
+    for (size_t i = 0; i < size; i++) flash[dst_offset + i] &= s[i];
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *partition, size_t offset, size_t size)
+{
+    if (!flash_range_ok(partition, offset, size)) return ESP_ERR_INVALID_ARG;
+    if (offset % partition->erase_size || size % partition->erase_size) return ESP_ERR_INVALID_SIZE;
+    memset(flash + offset, 0xFF, size);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t *partition, size_t offset, size_t size,
+                             esp_partition_mmap_memory_t memory, const void **out_ptr,
+                             esp_partition_mmap_handle_t *out_handle)
+{
+    (void) memory;
+    if (!flash_range_ok(partition, offset, size)) return ESP_ERR_INVALID_ARG;
+    *out_ptr = flash + offset;
+    *out_handle = 0;
+    return ESP_OK;
+}
+
+void esp_partition_munmap(esp_partition_mmap_handle_t handle)
+{
+    (void) handle;
+}
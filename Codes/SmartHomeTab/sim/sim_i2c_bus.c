@@ -0,0 +1,57 @@
+// ------------------------------------------------------------
+// I2C BUS
+// The STC8 expander (buzzer, backlight) is not simulated: sequences
+// are logged when submitted, jobs run in the calling thread.
+// ------------------------------------------------------------
+#include <stdio.h>
+#include "esp_log.h"
+#include "i2c_bus.h"
+
+static const char *TAG = "SIM_I2C";
+
+esp_err_t i2c_bus_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t i2c_bus_run(i2c_bus_prio_t prio, i2c_bus_job_fn_t fn, void *arg)
+{
+    (void) prio;
+    return fn(arg);
+}
+
+esp_err_t i2c_bus_submit_seq(int channel, const i2c_bus_step_t *steps, size_t cnt)
+{
+    char line[256];
+    int len = 0;
+
+    if (cnt == 0 || cnt > I2C_BUS_SEQ_MAX_STEPS) return ESP_ERR_INVALID_ARG;
+    for (size_t i = 0; i < cnt && len < (int) sizeof(line); i++) {
+        len += snprintf(line + len, sizeof(line) - len, " 0x%02x<-0x%02x", steps[i].addr, steps[i].data);
+        if (steps[i].delay_ms && len < (int) sizeof(line)) {
+            len += snprintf(line + len, sizeof(line) - len, " +%ums", steps[i].delay_ms);
+        }
+    }
+    ESP_LOGI(TAG, "seq %d:%s", channel, line);
+    return ESP_OK;
+}
+
+bool i2c_bus_probe(uint8_t addr)
+{
+    return false;
+}
+
+esp_err_t i2c_bus_write(uint8_t addr, const uint8_t *data, size_t len)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t i2c_bus_write_reg(uint8_t addr, uint8_t reg, const uint8_t *data, size_t len)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t i2c_bus_read_reg(uint8_t addr, uint8_t reg, uint8_t *data, size_t len)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
@@ -0,0 +1,177 @@
+// ------------------------------------------------------------
+// LVGL PORT
+// Same contract as main/lvgl_port.c in tickless mode: a recursive
+// mutex held by the main loop around lv_timer_handler(), the tick
+// brought up to date on every lock, and a main loop that sleeps
+// until the next timer or a wakeup from another thread.
+// ------------------------------------------------------------
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "esp_log.h"
+#include "lvgl_port.h"
+#include "lvgl_port_perf.h"
+#include "sim.h"
+
+static const char *TAG = "SIM_PORT";
+
+static pthread_mutex_t lvgl_mux;
+static pthread_once_t lvgl_mux_once = PTHREAD_ONCE_INIT;
+static pthread_t lvgl_thread;                 // Thread running the main loop
+static uint32_t lvgl_due_ms;                  // Next wakeup of the main loop, protected by lvgl_mux
+
+static pthread_mutex_t wake_mux = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake_cond;
+static bool wake_pending;
+static lv_timer_t *triggered[LVGL_PORT_TRIGGER_MAX];   // Protected by wake_mux
+static int triggered_cnt;
+
+static void lvgl_mux_init(void)
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&lvgl_mux, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    pthread_condattr_t cattr;
+    pthread_condattr_init(&cattr);
+    pthread_condattr_setclock(&cattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&wake_cond, &cattr);
+    pthread_condattr_destroy(&cattr);
+
+    lvgl_thread = pthread_self();             // The first user is the main thread
+}
+
+static void tick_update(void)
+{
+    static uint32_t last_ms = 0;
+    uint32_t now_ms = (uint32_t)(sim_clock_now_us() / 1000);
+    lv_tick_inc(now_ms - last_ms);
+    last_ms = now_ms;
+}
+
+static uint32_t next_due_ms(void)
+{
+    uint32_t till_next = lv_timer_get_time_till_next();
+    if (till_next > LVGL_PORT_TASK_MAX_DELAY_MS) till_next = LVGL_PORT_TASK_MAX_DELAY_MS;
+    return lv_tick_get() + till_next;
+}
+
+bool lvgl_port_lock(int timeout_ms)
+{
+    pthread_once(&lvgl_mux_once, lvgl_mux_init);
+    int64_t start = sim_host_time_us();
+
+    if (timeout_ms < 0) {
+        if (pthread_mutex_lock(&lvgl_mux) != 0) return false;
+    } else {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_sec += timeout_ms / 1000;
+        ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+        if (ts.tv_nsec >= 1000000000) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000;
+        }
+        if (pthread_mutex_timedlock(&lvgl_mux, &ts) != 0) return false;
+    }
+
+    lvgl_port_perf_lock(sim_host_time_us() - start);
+    tick_update();
+    return true;
+}
+
+void lvgl_port_unlock(void)
+{
+    bool wake = false;
+    if (pthread_equal(pthread_self(), lvgl_thread)) {
+        lvgl_due_ms = next_due_ms();
+    } else {
+        wake = (int32_t)(next_due_ms() - lvgl_due_ms) < 0;
+    }
+    pthread_mutex_unlock(&lvgl_mux);
+    if (wake) lvgl_port_wake();
+}
+
+void lvgl_port_wake(void)
+{
+    pthread_once(&lvgl_mux_once, lvgl_mux_init);
+    pthread_mutex_lock(&wake_mux);
+    wake_pending = true;
+    pthread_cond_signal(&wake_cond);
+    pthread_mutex_unlock(&wake_mux);
+}
+
+void lvgl_port_trigger_timer(lv_timer_t *timer)
+{
+    int i;
+
+    pthread_mutex_lock(&wake_mux);
+    for (i = 0; i < triggered_cnt && triggered[i] != timer; i++);
+    if (i == triggered_cnt) {
+        if (triggered_cnt < LVGL_PORT_TRIGGER_MAX) {
+            triggered[triggered_cnt++] = timer;
+        } else {
+            ESP_LOGW(TAG, "More than %d triggered timers", LVGL_PORT_TRIGGER_MAX);
+        }
+    }
+    pthread_mutex_unlock(&wake_mux);
+    lvgl_port_wake();
+}
+
+bool lvgl_port_notify_rgb_vsync(void)
+{
+    return false;
+}
+
+void sim_lvgl_port_trigger_run(void)
+{
+    lv_timer_t *timers[LVGL_PORT_TRIGGER_MAX];
+    int cnt;
+
+    pthread_mutex_lock(&wake_mux);
+    cnt = triggered_cnt;
+    memcpy(timers, triggered, cnt * sizeof(timers[0]));
+    triggered_cnt = 0;
+    pthread_mutex_unlock(&wake_mux);
+
+    for (int i = 0; i < cnt; i++) {
+        lv_timer_resume(timers[i]);
+        lv_timer_ready(timers[i]);
+    }
+}
+
+void sim_lvgl_port_sleep(uint32_t ms)
+{
+    if (sim_clock_started()) {
+        // Another thread changed the UI: run the timers again at the same time
+        pthread_mutex_lock(&wake_mux);
+        bool woken = wake_pending;
+        wake_pending = false;
+        pthread_mutex_unlock(&wake_mux);
+        if (woken) return;
+
+        int64_t due_us = sim_clock_now_us() + (int64_t) ms * 1000;
+        int64_t feed_us = sim_clock_idle();
+        sim_clock_advance(feed_us < due_us ? feed_us : due_us);
+        return;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += ms / 1000;
+    ts.tv_nsec += (long)(ms % 1000) * 1000000;
+    if (ts.tv_nsec >= 1000000000) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&wake_mux);
+    while (!wake_pending) {
+        if (pthread_cond_timedwait(&wake_cond, &wake_mux, &ts) != 0) break;
+    }
+    wake_pending = false;
+    pthread_mutex_unlock(&wake_mux);
+}
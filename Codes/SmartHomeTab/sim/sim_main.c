@@ -0,0 +1,330 @@
+// ------------------------------------------------------------
+// SMART HOME TAB — HOST SIMULATOR
+// Runs the real UI, MQTT queue and MQTT bridge on a headless
+// LVGL display of the panel's size. See README.md.
+// ------------------------------------------------------------
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include "lvgl.h"
+#include "lvgl_port.h"
+#include "esp_log.h"
+#include "freertos/task.h"
+#include "lvgl_port_draw.h"
+#include "lvgl_port_parallel.h"
+#include "lvgl_port_perf.h"
+#include "mqtt_manager.h"
+#include "perf_report.h"
+#include "sensor_history.h"
+#include "state_store.h"
+#include "ui_clock.h"
+#include "ui_history_chart.h"
+#include "ui_img_rle.h"
+#include "ui_mqtt_bridge.h"
+#include "ui_screens.h"
+#include "ui.h"
+#include "sim.h"
+
+static const char *TAG = "SIM";
+
+static lv_disp_t *disp;
+static lv_color_t *framebuffer;
+static atomic_bool quit;
+
+// ------------------------------------------------------------
+// HEADLESS DISPLAY
+// Direct mode on one full-screen buffer: the buffer is the framebuffer.
+// ------------------------------------------------------------
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    (void) area;
+    (void) color_p;
+    lv_disp_flush_ready(drv);
+}
+
+static void display_init(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t disp_drv;
+    size_t px = (size_t) LVGL_PORT_H_RES * LVGL_PORT_V_RES;
+
+    framebuffer = calloc(px, sizeof(lv_color_t));
+    assert(framebuffer);
+    lv_disp_draw_buf_init(&draw_buf, framebuffer, NULL, px);
+
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = LVGL_PORT_H_RES;
+    disp_drv.ver_res = LVGL_PORT_V_RES;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.direct_mode = 1;
+#if LVGL_PORT_DMA_DRAW
+    lvgl_port_draw_attach(&disp_drv);         // Fills and copies on the worker thread of sim_dma.c
+#endif
+    disp = lv_disp_drv_register(&disp_drv);
+    lvgl_port_perf_attach(disp);
+}
+
+bool sim_dump_ppm(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        ESP_LOGE(TAG, "Cannot write %s", path);
+        return false;
+    }
+
+    lvgl_port_lock(-1);
+    lv_refr_now(disp);
+    fprintf(f, "P6\n%d %d\n255\n", LVGL_PORT_H_RES, LVGL_PORT_V_RES);
+    for (size_t i = 0; i < (size_t) LVGL_PORT_H_RES * LVGL_PORT_V_RES; i++) {
+        uint32_t c = lv_color_to32(framebuffer[i]);
+        uint8_t rgb[3] = { (c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF };
+        fwrite(rgb, 1, sizeof(rgb), f);
+    }
+    lvgl_port_unlock();
+
+    fclose(f);
+    ESP_LOGI(TAG, "Screen written to %s", path);
+    return true;
+}
+
+// Screens are built on demand, so refer to their variables
+static lv_obj_t **const screens[] = { &ui_Screen1, &ui_Screen2, &ui_Screen3 };
+
+bool sim_load_screen(int index)
+{
+    if (index < 1 || index > 3) return false;
+
+    lvgl_port_lock(-1);
+    ui_screens_load(screens[index - 1], LV_SCR_LOAD_ANIM_NONE, 0, 0);
+    lvgl_port_unlock();
+    return true;
+}
+
+bool sim_navigate(int index)
+{
+    if (index < 1 || index > 3) return false;
+
+    // Same animation as the navigation buttons of the SquareLine screens
+    lvgl_port_lock(-1);
+    ui_screens_load(screens[index - 1], LV_SCR_LOAD_ANIM_FADE_ON, 500, 0);
+    lvgl_port_unlock();
+    return true;
+}
+
+bool sim_set_time(const char *text)
+{
+    struct tm tm_now = { 0 };
+    if (sscanf(text, "%d-%d-%d %d:%d:%d", &tm_now.tm_year, &tm_now.tm_mon, &tm_now.tm_mday,
+               &tm_now.tm_hour, &tm_now.tm_min, &tm_now.tm_sec) != 6) {
+        return false;
+    }
+    tm_now.tm_year -= 1900;
+    tm_now.tm_mon -= 1;
+    tm_now.tm_isdst = -1;
+    mktime(&tm_now);    // fills in tm_wday
+
+    lvgl_port_lock(-1);
+    ui_clock_set(&tm_now);
+    lvgl_port_unlock();
+    return true;
+}
+
+// Resolve the styles the draw functions read, for every part of every object of the tree
+static uint32_t bench_styles(lv_obj_t *obj)
+{
+    static const lv_part_t parts[] = {LV_PART_MAIN, LV_PART_INDICATOR, LV_PART_KNOB, LV_PART_ITEMS};
+    uint32_t cnt = 1;
+
+    for (size_t p = 0; p < sizeof(parts) / sizeof(parts[0]); p++) {
+        lv_draw_rect_dsc_t rect;
+        lv_draw_rect_dsc_init(&rect);
+        lv_obj_init_draw_rect_dsc(obj, parts[p], &rect);
+        lv_draw_label_dsc_t label;
+        lv_draw_label_dsc_init(&label);
+        lv_obj_init_draw_label_dsc(obj, parts[p], &label);
+    }
+    for (uint32_t i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+        cnt += bench_styles(lv_obj_get_child(obj, i));
+    }
+    return cnt;
+}
+
+void sim_bench(int frames)
+{
+    if (frames <= 0) return;
+
+    lvgl_port_lock(-1);
+    lv_obj_t *scr = lv_disp_get_scr_act(disp);
+    int64_t start_us = sim_host_time_us();
+    for (int i = 0; i < frames; i++) {
+        lv_obj_invalidate(scr);
+        lv_refr_now(disp);
+    }
+    int64_t us = sim_host_time_us() - start_us;
+
+    uint32_t objs = 0;
+    start_us = sim_host_time_us();
+    for (int i = 0; i < frames; i++) {
+        objs = bench_styles(scr);
+    }
+    int64_t style_us = sim_host_time_us() - start_us;
+    lvgl_port_unlock();
+
+    printf("bench %d full frames, %.2f ms/frame, styles of %u objects %.1f us\n", frames, us / 1000.0 / frames,
+           objs, (double) style_us / frames);
+    fflush(stdout);
+}
+
+void sim_print_stats(void)
+{
+    mqtt_queue_stats_t q;
+    ui_mqtt_bridge_stats_t b;
+
+    mqtt_manager_get_queue_stats(&q);
+    lvgl_port_lock(-1);
+    ui_mqtt_bridge_get_stats(&b);
+    lvgl_port_perf_t perf;
+    lvgl_port_perf_get(&perf, false);
+    lvgl_port_unlock();
+
+    uint32_t frames = perf.frame.count;
+    printf("frames %u, %.0f px/frame, %.1f areas/frame\n", frames,
+           frames ? (double) perf.px_sum / frames : 0.0,
+           frames ? (double) perf.areas_sum / frames : 0.0);
+    // Host time, which differs from run to run
+    printf("render avg %.2f ms max %.2f ms\n",
+           frames ? perf.render.sum_us / 1000.0 / frames : 0.0, perf.render.max_us / 1000.0);
+    printf("queue received %u dropped %u truncated %u oversized %u delivered %u high-water %u\n",
+           q.received, q.dropped, q.truncated, q.oversized, q.delivered, q.high_water);
+    printf("bridge received %u coalesced %u suppressed %u\n", b.received, b.coalesced, b.suppressed);
+    fflush(stdout);
+}
+
+// ------------------------------------------------------------
+// MAIN LOOP — same as the tickless lvgl_port_task()
+// ------------------------------------------------------------
+static void on_signal(int sig)
+{
+    (void) sig;
+    atomic_store(&quit, true);
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s [--broker mqtt://host[:port]] [--user U --pass P]\n"
+            "          [--feed FILE|-] [--run-ms MS] [--settle-ms MS] [--dump FILE.ppm]\n"
+            "          [--render-threads N] [--flash FILE]\n"
+            "With --feed the simulator exits SETTLE ms (default 1000) after the end of the feed.\n"
+            "A feed FILE runs on a simulated clock, so every run gives the same output.\n"
+            "--render-threads draws the refreshed areas in N bands at once (default 2, like the device).\n"
+            "--flash keeps the state partition in FILE: the state is restored at start and saved at exit.\n",
+            argv0);
+}
+
+int main(int argc, char **argv)
+{
+    const char *broker = NULL, *user = NULL, *pass = NULL, *feed = NULL, *dump = NULL, *flash = NULL;
+    int64_t run_ms = 0, settle_ms = 1000;
+    int render_threads = 2;
+    char feed_uri[512];
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!val) {
+            usage(argv[0]);
+            return 1;
+        }
+        if (strcmp(arg, "--broker") == 0) broker = val;
+        else if (strcmp(arg, "--user") == 0) user = val;
+        else if (strcmp(arg, "--pass") == 0) pass = val;
+        else if (strcmp(arg, "--feed") == 0) feed = val;
+        else if (strcmp(arg, "--run-ms") == 0) run_ms = atoll(val);
+        else if (strcmp(arg, "--settle-ms") == 0) settle_ms = atoll(val);
+        else if (strcmp(arg, "--dump") == 0) dump = val;
+        else if (strcmp(arg, "--render-threads") == 0) render_threads = atoi(val);
+        else if (strcmp(arg, "--flash") == 0) flash = val;
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+    if (!broker && !feed) feed = "-";
+    if (feed) {
+        snprintf(feed_uri, sizeof(feed_uri), "file://%s", feed);
+        broker = feed_uri;
+    }
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    if (flash && !sim_flash_open(flash)) return 1;
+
+    // Typed lines come in real time
+    if (feed && strcmp(feed, "-") != 0) sim_clock_start();
+
+    lv_init();
+    display_init();
+
+    // The boot stages of main.c one after the other, with the LVGL lock held
+    lvgl_port_lock(-1);
+#if LVGL_PORT_PARALLEL_RENDER
+    if (render_threads > 1) lvgl_port_parallel_start((uint32_t) render_threads);
+#else
+    (void) render_threads;
+#endif
+    ui_img_rle_init();
+    ui_screens_init();
+    ui_mqtt_bridge_init();
+    ui_clock_init();
+    sensor_history_init();
+    ui_history_chart_init();
+    state_store_init();
+    mqtt_manager_start(broker, user, pass);
+    perf_report_start();
+    lvgl_port_unlock();
+
+    sim_clock_idle();
+    int64_t start_ms = sim_clock_now_us() / 1000;
+    int64_t feed_end_ms = -1;
+
+    while (!atomic_load(&quit)) {
+        sim_clock_idle();
+        int64_t now_ms = sim_clock_now_us() / 1000;
+        uint32_t task_delay_ms;
+
+        lvgl_port_lock(-1);
+        sim_lvgl_port_trigger_run();
+        task_delay_ms = lv_timer_handler();
+        lvgl_port_unlock();
+
+        if (run_ms > 0 && now_ms - start_ms >= run_ms) break;
+        if (feed && sim_mqtt_feed_done()) {
+            if (feed_end_ms < 0) feed_end_ms = now_ms;
+            if (run_ms == 0 && now_ms - feed_end_ms >= settle_ms) break;
+        }
+
+        if (task_delay_ms > LVGL_PORT_TASK_MAX_DELAY_MS) {
+            task_delay_ms = LVGL_PORT_TASK_MAX_DELAY_MS;
+        } else if (task_delay_ms < LVGL_PORT_TASK_MIN_DELAY_MS) {
+            task_delay_ms = LVGL_PORT_TASK_MIN_DELAY_MS;
+        }
+        sim_lvgl_port_sleep(task_delay_ms);
+    }
+
+    // A planned restart: keep what arrived since the last checkpoint
+    lvgl_port_lock(-1);
+    state_store_checkpoint();
+    lvgl_port_unlock();
+    state_store_wait(-1);
+
+    if (dump) sim_dump_ppm(dump);
+    sim_print_stats();
+    return 0;
+}
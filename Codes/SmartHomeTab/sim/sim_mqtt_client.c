@@ -0,0 +1,254 @@
+// ------------------------------------------------------------
+// ESP-MQTT CLIENT ON THE HOST
+// Broker URIs (mqtt://host[:port]) go through libmosquitto when the
+// simulator is built with it. file://<path> (file://- for stdin) replays
+// a message feed instead, one message per line:
+//
+//     <topic> <payload>     deliver a message
+//     .wait <ms>            pause the feed
+//     .dump <file.ppm>      write a screenshot
+//     .screen <1|2|3>       show another screen
+//     .nav <1|2|3>          change screen with the UI's fade animation
+//     .time <date> <time>   set the clock, e.g. .time 2025-11-29 23:59:58
+//     .stats                print the counters
+//     .bench <frames>       redraw the whole screen and print the time per frame
+//     # comment
+//
+// In both cases the events are raised from a separate thread, like the
+// esp-mqtt task on the device. Publishes of a feed run go to stdout.
+// A feed file holds the simulated clock while it reads, so `.wait`
+// pauses it in simulated time (see sim_clock_start()).
+// ------------------------------------------------------------
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mqtt_client.h"
+#include "esp_log.h"
+#include "freertos/task.h"
+#include "sim.h"
+
+#ifdef SIM_HAVE_MOSQUITTO
+#include <mosquitto.h>
+#endif
+
+static const char *TAG = "SIM_MQTT";
+
+struct esp_mqtt_client {
+    char *uri;
+    char *username;
+    char *password;
+    esp_event_handler_t handler;
+    void *handler_arg;
+    pthread_t feed_thread;
+    FILE *feed;
+#ifdef SIM_HAVE_MOSQUITTO
+    struct mosquitto *mosq;
+#endif
+    atomic_int next_msg_id;
+};
+
+static atomic_bool feed_done;
+
+static char *dup_or_null(const char *s)
+{
+    return s ? strdup(s) : NULL;
+}
+
+static void dispatch(esp_mqtt_client_handle_t client, esp_mqtt_event_id_t id,
+                     const char *topic, int topic_len, const char *data, int data_len)
+{
+    if (!client->handler) return;
+
+    esp_mqtt_event_t event = {
+        .event_id = id,
+        .client = client,
+        .topic = (char *) topic,
+        .topic_len = topic_len,
+        .data = (char *) data,
+        .data_len = data_len,
+        .total_data_len = data_len,
+        .current_data_offset = 0,
+    };
+    client->handler(client->handler_arg, "MQTT_EVENTS", id, &event);
+}
+
+// ------------------------------------------------------------
+// MESSAGE FEED
+// ------------------------------------------------------------
+static void *feed_task(void *arg)
+{
+    esp_mqtt_client_handle_t client = arg;
+    char line[1024];
+
+    dispatch(client, MQTT_EVENT_CONNECTED, NULL, 0, NULL, 0);
+
+    while (fgets(line, sizeof(line), client->feed)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        char *p = line + strspn(line, " \t");
+        if (*p == '\0' || *p == '#') continue;
+
+        if (strncmp(p, ".wait ", 6) == 0) {
+            vTaskDelay(pdMS_TO_TICKS(atoi(p + 6)));
+        } else if (strncmp(p, ".dump ", 6) == 0) {
+            sim_dump_ppm(p + 6);
+        } else if (strncmp(p, ".screen ", 8) == 0) {
+            sim_load_screen(atoi(p + 8));
+        } else if (strncmp(p, ".nav ", 5) == 0) {
+            sim_navigate(atoi(p + 5));
+        } else if (strncmp(p, ".time ", 6) == 0) {
+            sim_set_time(p + 6);
+        } else if (strcmp(p, ".stats") == 0) {
+            sim_print_stats();
+        } else if (strncmp(p, ".bench ", 7) == 0) {
+            sim_bench(atoi(p + 7));
+        } else {
+            char *payload = strchr(p, ' ');
+            int topic_len = payload ? (int)(payload - p) : (int) strlen(p);
+            payload = payload ? payload + 1 : "";
+            dispatch(client, MQTT_EVENT_DATA, p, topic_len, payload, (int) strlen(payload));
+        }
+    }
+
+    if (client->feed != stdin) fclose(client->feed);
+    atomic_store(&feed_done, true);
+    sim_clock_release();
+    return NULL;
+}
+
+bool sim_mqtt_feed_done(void)
+{
+    return atomic_load(&feed_done);
+}
+
+// ------------------------------------------------------------
+// BROKER (libmosquitto)
+// ------------------------------------------------------------
+#ifdef SIM_HAVE_MOSQUITTO
+static void on_connect(struct mosquitto *mosq, void *obj, int rc)
+{
+    if (rc == 0) {
+        dispatch(obj, MQTT_EVENT_CONNECTED, NULL, 0, NULL, 0);
+    } else {
+        ESP_LOGW(TAG, "Connect failed: %s", mosquitto_connack_string(rc));
+    }
+}
+
+static void on_disconnect(struct mosquitto *mosq, void *obj, int rc)
+{
+    dispatch(obj, MQTT_EVENT_DISCONNECTED, NULL, 0, NULL, 0);
+}
+
+static void on_message(struct mosquitto *mosq, void *obj, const struct mosquitto_message *msg)
+{
+    dispatch(obj, MQTT_EVENT_DATA, msg->topic, (int) strlen(msg->topic), msg->payload, msg->payloadlen);
+}
+
+static esp_err_t broker_start(esp_mqtt_client_handle_t client)
+{
+    char host[128];
+    int port = 1883;
+    const char *h = client->uri + strlen("mqtt://");
+    size_t n = strcspn(h, ":/");
+
+    if (n >= sizeof(host)) return ESP_ERR_INVALID_ARG;
+    memcpy(host, h, n);
+    host[n] = '\0';
+    if (h[n] == ':') port = atoi(h + n + 1);
+
+    mosquitto_lib_init();
+    client->mosq = mosquitto_new(NULL, true, client);
+    if (!client->mosq) return ESP_ERR_NO_MEM;
+
+    mosquitto_connect_callback_set(client->mosq, on_connect);
+    mosquitto_disconnect_callback_set(client->mosq, on_disconnect);
+    mosquitto_message_callback_set(client->mosq, on_message);
+    if (client->username) {
+        mosquitto_username_pw_set(client->mosq, client->username, client->password);
+    }
+
+    if (mosquitto_connect_async(client->mosq, host, port, 60) != MOSQ_ERR_SUCCESS ||
+            mosquitto_loop_start(client->mosq) != MOSQ_ERR_SUCCESS) {
+        ESP_LOGE(TAG, "Cannot reach broker %s:%d", host, port);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+#endif
+
+// ------------------------------------------------------------
+// ESP-MQTT API
+// ------------------------------------------------------------
+esp_mqtt_client_handle_t esp_mqtt_client_init(const esp_mqtt_client_config_t *config)
+{
+    esp_mqtt_client_handle_t client = calloc(1, sizeof(*client));
+    if (!client) return NULL;
+
+    client->uri = dup_or_null(config->broker.address.uri);
+    client->username = dup_or_null(config->credentials.username);
+    client->password = dup_or_null(config->credentials.authentication.password);
+    return client;
+}
+
+esp_err_t esp_mqtt_client_register_event(esp_mqtt_client_handle_t client, esp_mqtt_event_id_t event,
+                                         esp_event_handler_t event_handler, void *event_handler_arg)
+{
+    (void) event;
+    client->handler = event_handler;
+    client->handler_arg = event_handler_arg;
+    return ESP_OK;
+}
+
+esp_err_t esp_mqtt_client_start(esp_mqtt_client_handle_t client)
+{
+    if (client->uri && strncmp(client->uri, "file://", 7) == 0) {
+        const char *path = client->uri + 7;
+        client->feed = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+        if (!client->feed) {
+            ESP_LOGE(TAG, "Cannot open feed %s", path);
+            return ESP_ERR_NOT_FOUND;
+        }
+        sim_clock_hold();
+        if (pthread_create(&client->feed_thread, NULL, feed_task, client) != 0) {
+            sim_clock_release();
+            return ESP_FAIL;
+        }
+        return ESP_OK;
+    }
+
+#ifdef SIM_HAVE_MOSQUITTO
+    if (client->uri && strncmp(client->uri, "mqtt://", 7) == 0) {
+        return broker_start(client);
+    }
+#endif
+
+    ESP_LOGE(TAG, "Unsupported URI %s", client->uri ? client->uri : "(null)");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+int esp_mqtt_client_subscribe(esp_mqtt_client_handle_t client, const char *topic, int qos)
+{
+    int msg_id = atomic_fetch_add(&client->next_msg_id, 1) + 1;
+#ifdef SIM_HAVE_MOSQUITTO
+    if (client->mosq) {
+        return mosquitto_subscribe(client->mosq, &msg_id, topic, qos) == MOSQ_ERR_SUCCESS ? msg_id : -1;
+    }
+#endif
+    return msg_id;
+}
+
+int esp_mqtt_client_publish(esp_mqtt_client_handle_t client, const char *topic, const char *data,
+                            int len, int qos, int retain)
+{
+    int msg_id = atomic_fetch_add(&client->next_msg_id, 1) + 1;
+    if (len == 0 && data) len = (int) strlen(data);
+#ifdef SIM_HAVE_MOSQUITTO
+    if (client->mosq) {
+        return mosquitto_publish(client->mosq, &msg_id, topic, len, data, qos, retain) == MOSQ_ERR_SUCCESS ? msg_id : -1;
+    }
+#endif
+    printf("> %s %.*s\n", topic, len, data ? data : "");
+    fflush(stdout);
+    return msg_id;
+}
@@ -0,0 +1,115 @@
+// ------------------------------------------------------------
+// PARALLEL RENDERING
+// Host version of main/lvgl_port_parallel.c: the bands of a
+// refresh are drawn by pthreads, as many as --render-threads
+// asks for (the device has one per core), so the scaling of
+// LV_USE_REFR_PARALLEL can be measured with the .bench command.
+// ------------------------------------------------------------
+#include <pthread.h>
+#include <stdint.h>
+#include "esp_log.h"
+#include "lvgl_port_parallel.h"
+
+static const char *TAG = "SIM_PARALLEL";
+
+static pthread_mutex_t mux = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t start_cond = PTHREAD_COND_INITIALIZER;   // A job was posted
+static pthread_cond_t done_cond = PTHREAD_COND_INITIALIZER;    // A helper returned from the job
+static pthread_mutex_t shared_mux;                            // Recursive, see lv_refr_lock_shared()
+static pthread_t helpers[LV_REFR_PARALLEL_MAX];              // helpers[0] is unused: worker 0 is the caller
+static uint32_t worker_cnt;
+static uint32_t job_seq;                                     // Incremented for every job
+static uint32_t running;                                     // Helpers still in the job
+static lv_refr_job_cb_t job_cb;
+static void *job_ctx;
+
+static void *helper_main(void *arg)
+{
+    uint32_t worker = (uint32_t)(uintptr_t) arg;
+    uint32_t seen = 0;
+
+    pthread_mutex_lock(&mux);
+    for (;;) {
+        while (job_seq == seen) {
+            pthread_cond_wait(&start_cond, &mux);
+        }
+        seen = job_seq;
+        pthread_mutex_unlock(&mux);
+
+        job_cb(job_ctx, worker);
+
+        pthread_mutex_lock(&mux);
+        if (--running == 0) pthread_cond_signal(&done_cond);
+    }
+    return NULL;
+}
+
+static void run(lv_refr_job_cb_t job, void *ctx)
+{
+    pthread_mutex_lock(&mux);
+    job_cb = job;
+    job_ctx = ctx;
+    running = worker_cnt - 1;
+    job_seq++;
+    pthread_cond_broadcast(&start_cond);
+    pthread_mutex_unlock(&mux);
+
+    job(ctx, 0);
+
+    pthread_mutex_lock(&mux);
+    while (running > 0) {
+        pthread_cond_wait(&done_cond, &mux);
+    }
+    pthread_mutex_unlock(&mux);
+}
+
+static uint32_t worker_id(void)
+{
+    for (uint32_t i = 1; i < worker_cnt; i++) {
+        if (pthread_equal(helpers[i], pthread_self())) return i;
+    }
+    return 0;
+}
+
+static void lock(void)
+{
+    pthread_mutex_lock(&shared_mux);
+}
+
+static void unlock(void)
+{
+    pthread_mutex_unlock(&shared_mux);
+}
+
+bool lvgl_port_parallel_start(uint32_t workers)
+{
+    if (worker_cnt) return true;
+    workers = LV_MIN(workers, LV_REFR_PARALLEL_MAX);
+    if (workers < 2) return false;
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&shared_mux, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    // A helper that fails to start would never answer a job: fall back to one thread
+    for (uint32_t i = 1; i < workers; i++) {
+        if (pthread_create(&helpers[i], NULL, helper_main, (void *)(uintptr_t) i) != 0) {
+            ESP_LOGE(TAG, "Failed to start render thread %u", i);
+            return false;
+        }
+    }
+
+    worker_cnt = workers;
+    lv_refr_parallel_t par = {
+        .run = run,
+        .worker_id = worker_id,
+        .lock = lock,
+        .unlock = unlock,
+        .worker_cnt = workers,
+    };
+    lv_refr_set_parallel(&par);
+    ESP_LOGI(TAG, "Rendering in %u bands", workers);
+    return true;
+}
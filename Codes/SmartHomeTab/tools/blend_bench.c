@@ -0,0 +1,208 @@
+/*
+ * Host test and benchmark of the RGB565 blend kernels (main/lvgl_port_blend.c).
+ *
+ * Checks every kernel against the per-pixel loops of LVGL's lv_draw_sw_blend.c on random
+ * areas, strides, colors and opacities, then reports megapixels per second.
+ *
+ *   cc -O2 -I../main blend_bench.c ../main/lvgl_port_blend.c -o blend_bench && ./blend_bench
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl_port_blend.h"
+
+#define W   800     // One full frame buffer of the panel
+#define H   480
+
+#define UDIV255(x)  (((x) * 0x8081U) >> 0x17)   // LV_UDIV255()
+
+// lv_color_mix() with LV_COLOR_DEPTH 16 and LV_COLOR_MIX_ROUND_OFS 128
+static uint16_t mix_ref(uint16_t c1, uint16_t c2, uint32_t mix)
+{
+    uint32_t r = UDIV255((c1 >> 11) * mix + (c2 >> 11) * (255 - mix) + 128);
+    uint32_t g = UDIV255(((c1 >> 5) & 0x3F) * mix + ((c2 >> 5) & 0x3F) * (255 - mix) + 128);
+    uint32_t b = UDIV255((c1 & 0x1F) * mix + (c2 & 0x1F) * (255 - mix) + 128);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+// The loops of fill_normal() and map_normal() the kernels replace
+static void fill_ref(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h, uint16_t color)
+{
+    for (int32_t y = 0; y < h; y++, dest += dest_stride) {
+        for (int32_t x = 0; x < w; x++) {
+            dest[x] = color;
+        }
+    }
+}
+
+static void fill_opa_ref(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h, uint16_t color, uint8_t opa)
+{
+    for (int32_t y = 0; y < h; y++, dest += dest_stride) {
+        for (int32_t x = 0; x < w; x++) {
+            dest[x] = mix_ref(color, dest[x], opa);
+        }
+    }
+}
+
+static void fill_mask_ref(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h, uint16_t color,
+                          const uint8_t *mask, int32_t mask_stride)
+{
+    for (int32_t y = 0; y < h; y++, dest += dest_stride, mask += mask_stride) {
+        for (int32_t x = 0; x < w; x++) {
+            dest[x] = mask[x] == 255 ? color : mix_ref(color, dest[x], mask[x]);
+        }
+    }
+}
+
+static void copy_ref(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h, const uint16_t *src, int32_t src_stride)
+{
+    for (int32_t y = 0; y < h; y++, dest += dest_stride, src += src_stride) {
+        for (int32_t x = 0; x < w; x++) {
+            dest[x] = src[x];
+        }
+    }
+}
+
+static void map_mask_ref(uint16_t *dest, int32_t dest_stride, int32_t w, int32_t h, const uint16_t *src, int32_t src_stride,
+                         const uint8_t *mask, int32_t mask_stride)
+{
+    for (int32_t y = 0; y < h; y++, dest += dest_stride, src += src_stride, mask += mask_stride) {
+        for (int32_t x = 0; x < w; x++) {
+            if (mask[x]) {
+                dest[x] = mask[x] == 255 ? src[x] : mix_ref(src[x], dest[x], mask[x]);
+            }
+        }
+    }
+}
+
+enum { K_FILL, K_FILL_OPA, K_FILL_MASK, K_COPY, K_MAP_MASK, K_NUM };
+static const char *const kernel_names[K_NUM] = { "fill", "fill opa", "fill mask", "copy", "map mask" };
+
+typedef struct {
+    int32_t x, y, w, h;         // Area in the W x H destination
+    int32_t src_ofs;            // Start of the source area in `src`
+    int32_t mask_ofs;           // Start of the mask area in `mask`
+    uint16_t color;
+    uint8_t opa;
+} job_t;
+
+static uint16_t *src;
+static uint8_t *mask;           // W x H opacities: opaque and transparent runs with antialiased edges
+
+static void run(int kernel, int ref, uint16_t *dest, const job_t *j)
+{
+    uint16_t *d = dest + j->y * W + j->x;
+    const uint16_t *s = src + j->src_ofs;
+    const uint8_t *m = mask + j->mask_ofs;
+
+    switch (kernel) {
+    case K_FILL:
+        (ref ? fill_ref : lvgl_port_blend_fill)(d, W, j->w, j->h, j->color);
+        break;
+    case K_FILL_OPA:
+        (ref ? fill_opa_ref : lvgl_port_blend_fill_opa)(d, W, j->w, j->h, j->color, j->opa);
+        break;
+    case K_FILL_MASK:
+        (ref ? fill_mask_ref : lvgl_port_blend_fill_mask)(d, W, j->w, j->h, j->color, m, W);
+        break;
+    case K_COPY:
+        (ref ? copy_ref : lvgl_port_blend_copy)(d, W, j->w, j->h, s, W);
+        break;
+    default:
+        (ref ? map_mask_ref : lvgl_port_blend_map_mask)(d, W, j->w, j->h, s, W, m, W);
+        break;
+    }
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// Megapixels per second of `kernel` over `area` x `iterations`
+static double bench(int kernel, int ref, uint16_t *dest, const job_t *j, int iterations)
+{
+    double t0 = now_us();
+    for (int i = 0; i < iterations; i++) {
+        run(kernel, ref, dest, j);
+    }
+    return (double)j->w * j->h * iterations / (now_us() - t0);
+}
+
+int main(void)
+{
+    size_t bytes = W * H * sizeof(uint16_t);
+    uint16_t *base = malloc(bytes);
+    uint16_t *ref = malloc(bytes);
+    uint16_t *out = malloc(bytes);
+    src = malloc(bytes);
+    mask = malloc(W * H);
+
+    srand(1);
+    for (int i = 0; i < W * H; i++) {
+        base[i] = (uint16_t)rand();
+        src[i] = (uint16_t)rand();
+    }
+    for (int i = 0; i < W * H;) {
+        int run = 1 + rand() % 24;
+        int kind = rand() % 3;
+        for (; run > 0 && i < W * H; run--, i++) {
+            mask[i] = kind == 0 ? 0 : kind == 1 ? 255 : (uint8_t)rand();
+        }
+    }
+
+    for (int k = 0; k < K_NUM; k++) {
+        for (int n = 0; n < 3000; n++) {
+            job_t j;
+            j.w = 1 + rand() % (n % 4 == 0 ? W : 64);
+            j.h = 1 + rand() % (n % 4 == 0 ? 32 : 16);
+            j.x = rand() % (W - j.w + 1);
+            j.y = rand() % (H - j.h + 1);
+            j.src_ofs = (rand() % (H - j.h + 1)) * W + rand() % (W - j.w + 1);
+            j.mask_ofs = (rand() % (H - j.h + 1)) * W + rand() % (W - j.w + 1);
+            j.color = (uint16_t)rand();
+            j.opa = (uint8_t)rand();
+            if (n % 3 == 0) {
+                fill_ref(base + j.y * W + j.x, W, j.w, j.h, (uint16_t)rand());   // Uniform background
+            }
+            memcpy(ref, base, bytes);
+            memcpy(out, base, bytes);
+            run(k, 1, ref, &j);
+            run(k, 0, out, &j);
+            if (memcmp(ref, out, bytes) != 0) {
+                printf("MISMATCH %s area %dx%d at (%d,%d) opa %d\n", kernel_names[k], j.w, j.h, j.x, j.y, j.opa);
+                return 1;
+            }
+        }
+    }
+    printf("kernels match the reference\n\n");
+
+    static const job_t areas[] = {
+        { 0, 0, W, H, 0, 0, 0x39E7, 128 },                       // Full screen (screen background, transitions)
+        { 101, 203, 120, 40, 3 * W + 5, 7 * W + 3, 0x39E7, 128 },  // Label sized, unaligned
+    };
+    static const char *const area_names[] = { "full screen", "120x40 label" };
+
+    printf("%-10s %-14s %12s %12s\n", "kernel", "area", "ref (MP/s)", "port (MP/s)");
+    for (int k = 0; k < K_NUM; k++) {
+        for (int a = 0; a < 2; a++) {
+            int iterations = a == 0 ? 50 : 20000;
+            memcpy(out, base, bytes);
+            double r = bench(k, 1, out, &areas[a], iterations);
+            memcpy(out, base, bytes);
+            double p = bench(k, 0, out, &areas[a], iterations);
+            printf("%-10s %-14s %12.1f %12.1f\n", kernel_names[k], area_names[a], r, p);
+        }
+    }
+
+    free(base);
+    free(ref);
+    free(out);
+    free(src);
+    free(mask);
+    return 0;
+}
@@ -0,0 +1,24 @@
+# Build-time RLE compression of the SquareLine images, see img_rle.py.
+#
+#   img_rle_sources(<out_var> <python> <ui_img_x.c>...)
+#
+# Sets <out_var> to the compressed sources, generated in ${CMAKE_CURRENT_BINARY_DIR}/img_rle
+# and regenerated when an image or the tool changes.
+set(IMG_RLE_TOOL ${CMAKE_CURRENT_LIST_DIR}/img_rle.py)
+
+function(img_rle_sources out_var python)
+    set(outputs)
+    foreach(src ${ARGN})
+        get_filename_component(name ${src} NAME)
+        set(out ${CMAKE_CURRENT_BINARY_DIR}/img_rle/${name})
+        add_custom_command(
+            OUTPUT ${out}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${CMAKE_CURRENT_BINARY_DIR}/img_rle
+            COMMAND ${python} ${IMG_RLE_TOOL} ${src} ${out}
+            DEPENDS ${src} ${IMG_RLE_TOOL}
+            COMMENT "Compressing ${name}"
+            VERBATIM)
+        list(APPEND outputs ${out})
+    endforeach()
+    set(${out_var} ${outputs} PARENT_SCOPE)
+endfunction()
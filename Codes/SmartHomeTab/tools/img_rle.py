@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""
+Build-time RLE compression of the SquareLine image assets (main/ui/ui_img_*.c).
+
+Rewrites one SquareLine image source into an equivalent source whose pixel array is
+run-length encoded, for the decoder of main/ui_img_rle.c. The descriptor keeps its name, so
+the UI code is unchanged; only its color format becomes UI_IMG_RLE_CF. Sources that do not
+shrink are copied as they are.
+
+    python3 img_rle.py ui/ui_img_fan_png.c build/img_rle/ui_img_fan_png.c
+
+Stream format, multi-byte values little endian:
+    0   color format of the pixels, bytes per pixel
+    2   trimmed box x1, y1, x2, y2 (u16 each): pixels outside are transparent, x1 > x2 if all are
+    10  run count (u16), 0 for formats without alpha
+    12  spans of the box rows, only with runs:
+            row index: first run of each row, one u16 per row plus the end
+            runs: u16 each, kind << 14 | length, covering x1..x2 of the row;
+                  kinds: 0 transparent, 1 opaque, 2 semi-transparent
+    ..  pixel packets. A packet starts with a control byte c:
+            c & 0x80    (c & 0x7F) + 1 copies of the pixel that follows
+            otherwise   c + 1 literal pixels follow
+"""
+import re
+import sys
+
+# lv_img_cf_t
+CF_BYTES = {
+    'LV_IMG_CF_TRUE_COLOR': 2,              # LV_COLOR_DEPTH 16
+    'LV_IMG_CF_TRUE_COLOR_ALPHA': 3,
+    'LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED': 2,
+}
+CF_VALUE = {
+    'LV_IMG_CF_TRUE_COLOR': 4,
+    'LV_IMG_CF_TRUE_COLOR_ALPHA': 5,
+    'LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED': 6,
+}
+MAX_RUN = 128
+SPAN_TRANSP, SPAN_OPAQUE, SPAN_SEMI = 0, 1, 2
+SPAN_MAX_LEN = 0x3FFF
+
+
+def encode(data, px_size):
+    px = [bytes(data[i:i + px_size]) for i in range(0, len(data), px_size)]
+    out = bytearray()
+    literal = []
+
+    def flush():
+        while literal:
+            chunk = literal[:MAX_RUN]
+            del literal[:MAX_RUN]
+            out.append(len(chunk) - 1)
+            for p in chunk:
+                out.extend(p)
+
+    i = 0
+    while i < len(px):
+        run = 1
+        while i + run < len(px) and run < MAX_RUN and px[i + run] == px[i]:
+            run += 1
+        # A run of two only pays off between two other runs; keep it literal
+        if run >= 3:
+            flush()
+            out.append(0x80 | (run - 1))
+            out += px[i]
+        else:
+            literal.extend(px[i:i + run])
+        i += run
+    flush()
+    return out
+
+
+def u16(*values):
+    return b''.join(v.to_bytes(2, 'little') for v in values)
+
+
+def spans(data, px_size, w, h):
+    """Trimmed box and the opaque / transparent spans of its rows"""
+    if px_size != 3:
+        return (0, 0, w - 1, h - 1), None
+    alpha = data[2::3]
+    rows = [y for y in range(h) if any(alpha[y * w:(y + 1) * w])]
+    cols = [x for x in range(w) if any(alpha[y * w + x] for y in range(h))]
+    if not rows:
+        return (1, 0, 0, 0), None
+    x1, y1, x2, y2 = cols[0], rows[0], cols[-1], rows[-1]
+
+    index, runs = [], []
+    for y in range(y1, y2 + 1):
+        index.append(len(runs))
+        kind, length = None, 0
+        for a in alpha[y * w + x1:y * w + x2 + 1]:
+            k = SPAN_TRANSP if a == 0 else SPAN_OPAQUE if a == 255 else SPAN_SEMI
+            if k != kind or length == SPAN_MAX_LEN:
+                if length:
+                    runs.append(kind << 14 | length)
+                kind, length = k, 0
+            length += 1
+        runs.append(kind << 14 | length)
+    index.append(len(runs))
+    return (x1, y1, x2, y2), (index, runs)
+
+
+def decode(stream, px_size, px_cnt):
+    out = bytearray()
+    i = 0
+    while len(out) < px_cnt * px_size:
+        c = stream[i]
+        i += 1
+        n = (c & 0x7F) + 1
+        if c & 0x80:
+            out += stream[i:i + px_size] * n
+            i += px_size
+        else:
+            out += stream[i:i + n * px_size]
+            i += n * px_size
+    return out
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(f'usage: {sys.argv[0]} <ui_img_x.c> <out.c>')
+    src_path, out_path = sys.argv[1], sys.argv[2]
+    with open(src_path) as f:
+        src = f.read()
+
+    arr = re.search(r'uint8_t\s+(\w+)\[\]\s*=\s*\{(.*?)\};', src, re.S)
+    name = re.search(r'const\s+lv_img_dsc_t\s+(\w+)\s*=', src)
+    w = re.search(r'\.header\.w\s*=\s*(\d+)', src)
+    h = re.search(r'\.header\.h\s*=\s*(\d+)', src)
+    cf = re.search(r'\.header\.cf\s*=\s*(\w+)', src)
+    if not (arr and name and w and h and cf) or cf.group(1) not in CF_BYTES:
+        # Not a plain SquareLine image: leave it alone
+        with open(out_path, 'w') as f:
+            f.write(src)
+        return
+
+    data = bytes(int(b, 16) for b in re.findall(r'0x([0-9A-Fa-f]{2})', arr.group(2)))
+    px_size = CF_BYTES[cf.group(1)]
+    px_cnt = int(w.group(1)) * int(h.group(1))
+    if len(data) != px_cnt * px_size:
+        sys.exit(f'{src_path}: {len(data)} bytes for {px_cnt} px of {cf.group(1)}')
+
+    box, span_table = spans(data, px_size, int(w.group(1)), int(h.group(1)))
+    header = bytes([CF_VALUE[cf.group(1)], px_size]) + u16(*box)
+    if span_table:
+        index, runs = span_table
+        header += u16(len(runs), *index, *runs)
+    else:
+        header += u16(0)
+    pixels = encode(data, px_size)
+    assert decode(pixels, px_size, px_cnt) == data
+    stream = header + pixels
+    if len(stream) >= len(data):
+        with open(out_path, 'w') as f:
+            f.write(src)
+        return
+
+    lines = []
+    for i in range(0, len(stream), 24):
+        lines.append('    ' + ','.join(f'0x{b:02X}' for b in stream[i:i + 24]) + ',')
+
+    with open(out_path, 'w') as f:
+        f.write(f'// Generated by tools/img_rle.py from {src_path.replace(chr(92), "/").split("/")[-1]}, do not edit\n'
+                f'// {len(data)} -> {len(stream)} bytes, {len(header)} of them box and spans\n\n'
+                '#include "ui.h"\n'
+                '#include "ui_img_rle.h"\n\n'
+                f'static const uint8_t {arr.group(1)}[] = {{\n' + '\n'.join(lines) + '\n};\n'
+                f'const lv_img_dsc_t {name.group(1)} = {{\n'
+                '    .header.always_zero = 0,\n'
+                f'    .header.w = {w.group(1)},\n'
+                f'    .header.h = {h.group(1)},\n'
+                f'    .data_size = sizeof({arr.group(1)}),\n'
+                '    .header.cf = UI_IMG_RLE_CF,\n'
+                f'    .data = {arr.group(1)}\n'
+                '};\n')
+
+
+if __name__ == '__main__':
+    main()